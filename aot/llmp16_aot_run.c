@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "llmp16.h"
+#include "llmp16_aot.h"
+
+/*
+ * Exécutable spécialisé d'une ROM traduite par build/llmp16_aot
+ * -------------------------------------------------------------
+ * Lié avec le fichier généré, qui fournit l'image (llmp16_aot_image) et ses blocs. La ROM
+ * s'exécute sur une VM headless jusqu'au HALT, le résultat est écrit en JSON comme pour
+ * llmp16_bench.
+ *
+ * Usage : <runner> [-i] [-c] [-n <instructions max>] [-s <tranche>]
+ *   -i  interpréteur seul, sans le code traduit (comparaison des temps)
+ *   -c  exécute en parallèle une VM interprétée, alterne tranches et frames et compare
+ *       registres, flags et compteurs après chaque pas, la mémoire et la VRAM à la fin
+ */
+
+#define AOT_SLICE       100000
+#define AOT_CHECK_SLICE 1009            /* premier : les tranches coupent les blocs partout */
+#define AOT_MAX_INSTR   2000000000ULL
+
+extern const llmp16_aot_image_t llmp16_aot_image;
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static llmp16_t *new_vm(bool translated)
+{
+    llmp16_t *vm = (llmp16_t *)malloc(sizeof(llmp16_t));
+    if (vm == NULL) return NULL;
+    llmp16_init(vm);
+    llmp16_mem_map_devices(vm);
+    memcpy(vm->memory, llmp16_aot_image.rom, llmp16_aot_image.size);
+    if (translated && llmp16_aot_attach(vm, &llmp16_aot_image) != 0) {
+        llmp16_off(vm);
+        return NULL;
+    }
+    return vm;
+}
+
+static bool same_state(const llmp16_t *a, const llmp16_t *b, bool memory)
+{
+    if (memcmp(a->R, b->R, sizeof(a->R)) != 0 || a->FLAGS != b->FLAGS || a->cpu_halted != b->cpu_halted
+        || memcmp(&a->stats, &b->stats, sizeof(a->stats)) != 0 || memcmp(a->IO, b->IO, sizeof(a->IO)) != 0)
+        return false;
+    return !memory || (memcmp(a->memory, b->memory, LLMP_MEM_SIZE) == 0
+                       && memcmp(a->VRAM, b->VRAM, LLMP_VRAM_SIZE) == 0);
+}
+
+static int check(uint64_t max_instr)
+{
+    llmp16_t *vm = new_vm(true), *ref = new_vm(false);
+    if (vm == NULL || ref == NULL) return EXIT_FAILURE;
+
+    uint64_t steps = 0;
+    bool ok = true;
+    while (ok && !ref->cpu_halted && ref->stats.instructions < max_instr) {
+        // frames (budget de cycles) et tranches (quota d'instructions) en alternance
+        if (steps++ & 1) {
+            llmp16_run_frame(vm);
+            llmp16_run_frame(ref);
+        } else {
+            llmp16_run_slice(vm, AOT_CHECK_SLICE);
+            llmp16_run_slice(ref, AOT_CHECK_SLICE);
+        }
+        ok = same_state(vm, ref, false);
+    }
+    ok = ok && same_state(vm, ref, true);
+
+    if (!ok)
+        fprintf(stderr, "%s : écart avec l'interpréteur au pas %llu (PC 0x%05X / 0x%05X, instruction %llu / %llu)\n",
+                llmp16_aot_image.name, (unsigned long long)steps, vm->R[PC], ref->R[PC],
+                (unsigned long long)vm->stats.instructions, (unsigned long long)ref->stats.instructions);
+    printf("{\"aot_check\":\"%s\",\"ok\":%s,\"steps\":%llu,\"instructions\":%llu,\"translated\":%llu}\n",
+           llmp16_aot_image.name, ok ? "true" : "false", (unsigned long long)steps,
+           (unsigned long long)ref->stats.instructions, (unsigned long long)vm->aot->instructions);
+    llmp16_off(vm);
+    llmp16_off(ref);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char *argv[])
+{
+    bool translated = true, check_mode = false;
+    uint64_t max_instr = AOT_MAX_INSTR;
+    uint32_t slice = AOT_SLICE;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-i") == 0) translated = false;
+        else if (strcmp(argv[i], "-c") == 0) check_mode = true;
+        else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) max_instr = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) slice = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else {
+            fprintf(stderr, "Usage : %s [-i] [-c] [-n <instructions max>] [-s <tranche>]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (check_mode) return check(max_instr);
+    if (slice == 0) slice = AOT_SLICE;
+
+    llmp16_t *vm = new_vm(translated);
+    if (vm == NULL) return EXIT_FAILURE;
+
+    uint64_t count = 0;
+    double start = now_seconds();
+    while (!vm->cpu_halted && count < max_instr)
+        count += llmp16_run_slice(vm, slice);
+    double elapsed = now_seconds() - start;
+
+    printf("{\"aot\":\"%s\",\"translated\":%s,\"instructions\":%llu,\"halted\":%s,\"seconds\":%.6f,"
+           "\"mips\":%.3f,\"cycles\":%llu,\"translated_share\":%.3f,\"blocks\":%llu}\n",
+           llmp16_aot_image.name, translated ? "true" : "false", (unsigned long long)count,
+           vm->cpu_halted ? "true" : "false", elapsed, elapsed > 0.0 ? count / elapsed / 1e6 : 0.0,
+           (unsigned long long)vm->stats.cycles,
+           translated && count ? (double)vm->aot->instructions / count : 0.0,
+           translated ? (unsigned long long)vm->aot->blocks : 0ull);
+    llmp16_off(vm);
+    return EXIT_SUCCESS;
+}
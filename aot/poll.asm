@@ -0,0 +1,10 @@
+/* Non-régression AOT : attente active sur le compteur de cycles (port $F)
+ * le bloc commence par IN et saute sur lui-même ; IN doit lire des compteurs à jour,
+ * l'interpréteur s'arrête après 196 instructions et 520 cycles
+ */
+
+poll:
+	in r0 r15 0
+	cmp r0 0x200
+	jlt [poll]
+hlt
@@ -0,0 +1,27 @@
+/* Benchmark ALU
+ * boucle d'arithmétique registre-registre et immédiate
+ * 2000 x 250 itérations (r1 avance de 3 + 1 par tour)
+ */
+
+mov r0 0
+mov r2 3
+mov r3 0x5555
+
+outer:
+	mov r1 0
+inner:
+	add r1 r2
+	mov r1 r15
+	mul r1 r2
+	xor r15 r3
+	mov r4 r15
+	lsr r4 r2
+	sub r4 r1
+	and r15 r3
+	inc r1
+	cmp r1 1000
+	jne [inner]
+	inc r0
+	cmp r0 2000
+	jne [outer]
+hlt
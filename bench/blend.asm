@@ -0,0 +1,44 @@
+/* Benchmark pixels par paires (VLDW, opérations sur deux octets, VSTRW)
+ * remplit l'écran d'un dégradé, l'assombrit 30 fois de 8 par pixel (PSUBS), puis mélange
+ * sa moitié haute avec sa moitié basse (PAVG) : deux pixels par instruction
+ */
+
+mov r6 0x0808
+mov r0 0
+grad:
+	pshuf r0 0
+	vstrw r0 r15
+	inc r0
+	inc r0
+	cmp r0 64000
+	jne [grad]
+
+	mov r7 0
+frame:
+	mov r0 0
+fade:
+	vldw r1 r0
+	psubs r1 r6
+	vstrw r0 r15
+	inc r0
+	inc r0
+	cmp r0 64000
+	jne [fade]
+	inc r7
+	cmp r7 30
+	jne [frame]
+
+	mov r0 0
+	mov r2 32000
+blend:
+	vldw r1 r0
+	vldw r3 r2
+	pavg r1 r3
+	vstrw r0 r15
+	inc r0
+	inc r0
+	inc r2
+	inc r2
+	cmp r0 32000
+	jne [blend]
+hlt
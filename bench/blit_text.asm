@@ -0,0 +1,37 @@
+/* Benchmark blitter texte
+ * remplit l'écran de 40x25 caractères 8x8 en mode bit-à-bit, 200 fois
+ * le glyphe est placé juste après le premier saut, à l'adresse 4
+ */
+
+jmp [start]
+glyph:
+.bytes 0x18 0x3c 0x66 0x66 0x7e 0x66 0x66 0x00 (end)
+
+start:
+	mov r4 8
+	mov r6 3
+	mov r7 0
+frame:
+	mov r3 0
+row:
+	mov r2 0
+col:
+	mov r1 4
+	out r1 r8 0
+	out r2 r8 1
+	out r3 r8 2
+	out r4 r8 3
+	out r4 r8 4
+	out r6 r8 5
+	add r2 r4
+	mov r2 r15
+	cmp r2 320
+	jne [col]
+	add r3 r4
+	mov r3 r15
+	cmp r3 200
+	jne [row]
+	inc r7
+	cmp r7 200
+	jne [frame]
+hlt
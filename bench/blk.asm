@@ -0,0 +1,34 @@
+/* Benchmark instructions de bloc
+ * la copie de memcpy.asm (MCPY) et le remplissage de vfill.asm (VFIL), puis compare
+ * les deux zones copiées (MCMP) : r3 = 1 si elles sont identiques
+ */
+
+mov r0 0
+
+copy:
+	mov r1 0xC000
+	mov r2 0x8000
+	mov r14 8192
+	mcpy r1 r2
+	inc r0
+	cmp r0 256
+	jne [copy]
+
+	mov r7 0
+frame:
+	mov r1 0
+	mov r14 64000
+	vfil r1 r7
+	inc r7
+	cmp r7 30
+	jne [frame]
+
+	mov r3 0
+	mov r1 0x8000
+	mov r2 0xC000
+	mov r14 8192
+	mcmp r1 r2
+	jne [done]
+	mov r3 1
+done:
+hlt
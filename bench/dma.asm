@@ -0,0 +1,19 @@
+/* Benchmark DMA
+ * 2000 transferts de 16 Ko de la ROM vers la VRAM
+ */
+
+mov r1 0
+mov r2 0
+mov r3 0x4000
+mov r4 1
+mov r0 0
+
+loop:
+	out r1 r7 0
+	out r2 r7 1
+	out r3 r7 2
+	out r4 r7 3
+	inc r0
+	cmp r0 2000
+	jne [loop]
+hlt
@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "llmp16.h"
+
+/*
+ * Harnais de benchmark LLMP16
+ * ---------------------------
+ * Exécute chaque ROM passée en argument sur une VM headless jusqu'au HALT puis mesure
+ * des périphériques isolés (blitter, DMA, compositeur) programmés directement depuis l'hôte.
+ * Chaque résultat est écrit sur stdout en JSON, une ligne par mesure, pour pouvoir être
+ * comparé d'une version du coeur à l'autre.
+ *
+ * Usage : llmp16_bench [-r <répétitions>] [-c <instructions max>] rom1.bin rom2.bin ...
+ */
+
+#define BENCH_SLICE       100000
+#define BENCH_MAX_INSTR   2000000000ULL
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* nom de la ROM sans répertoire ni extension */
+static void bench_name(const char *path, char *name, size_t size)
+{
+    const char *base = strrchr(path, '/');
+    base = base ? base + 1 : path;
+    snprintf(name, size, "%s", base);
+    char *dot = strrchr(name, '.');
+    if (dot) *dot = '\0';
+}
+
+static void bench_rom(const char *path, int repeat, uint64_t max_instr)
+{
+    char name[64];
+    bench_name(path, name, sizeof(name));
+
+    double best = 0.0;
+    uint64_t instructions = 0;
+    bool halted = false;
+    llmp16_stats_t stats;
+
+    // on garde la meilleure des <repeat> exécutions pour limiter le bruit
+    for (int r = 0; r < repeat; r++) {
+        llmp16_t *vm = (llmp16_t *)malloc(sizeof(llmp16_t));
+        if (vm == NULL) {
+            perror("VM alloc error");
+            exit(EXIT_FAILURE);
+        }
+        llmp16_init(vm);
+        llmp16_mem_map_devices(vm);
+        llmp16_rom_load(vm, (char *)path);
+
+        uint64_t count = 0;
+        double start = now_seconds();
+        while (!vm->cpu_halted && count < max_instr)
+            count += llmp16_run_slice(vm, BENCH_SLICE);
+        double elapsed = now_seconds() - start;
+
+        if (r == 0 || elapsed < best) best = elapsed;
+        instructions = count;
+        halted = vm->cpu_halted;
+        llmp16_stats_get(vm, &stats);
+        llmp16_off(vm);
+    }
+
+    printf("{\"bench\":\"%s\",\"instructions\":%llu,\"halted\":%s,\"seconds\":%.6f,"
+           "\"mips\":%.3f,\"ns_per_instr\":%.3f,\"cycles\":%llu,\"cpi\":%.3f,\"blit_pixels\":%llu,\"dma_bytes\":%llu,"
+           "\"vram_writes\":%llu,\"io_writes\":%llu}\n",
+           name, (unsigned long long)instructions, halted ? "true" : "false", best,
+           best > 0.0 ? instructions / best / 1e6 : 0.0,
+           instructions ? best * 1e9 / instructions : 0.0,
+           (unsigned long long)stats.cycles, instructions ? (double)stats.cycles / instructions : 0.0,
+           (unsigned long long)stats.blit_pixels, (unsigned long long)stats.dma_bytes,
+           (unsigned long long)stats.vram_writes, (unsigned long long)stats.io_writes);
+}
+
+/* Compositeur : tilemap 64x32 et 64 sprites 16x16 dans le banc 1, un pixel sur 7 transparent */
+static void compose_setup(llmp16_t *vm)
+{
+    uint8_t *bank = vm->VRAM + LLMP_VRAM_BANK_SIZE;
+    uint16_t *io = vm->IO[LLMP_VID_PORT];
+    for (uint32_t i = 0; i < LLMP_VRAM_BANK_SIZE; i++) bank[i] = (uint8_t)(i % 7 ? i * 13 : 0);
+    io[LLMP_VID_REG_CTRL] = VID_CTRL_TILES | VID_CTRL_SPRITES | VID_CTRL_BANK1;
+    io[LLMP_VID_REG_MAP] = 0x0000;
+    io[LLMP_VID_REG_MAP_SIZE] = 32 << 8 | 64;
+    io[LLMP_VID_REG_TILES] = 0x1000;
+    io[LLMP_VID_REG_SPRITES] = 0xF000;
+    io[LLMP_VID_REG_COUNT] = LLMP_VID_SPRITES;
+    for (int i = 0; i < LLMP_VID_SPRITES; i++) {
+        uint8_t *e = bank + 0xF000 + i * LLMP_VID_SPRITE_SIZE;
+        int x = (i * 37) % LLMP_SCREEN_WIDTH - 8, y = (i * 23) % LLMP_SCREEN_HEIGHT - 8;
+        e[0] = (uint8_t)x; e[1] = (uint8_t)(x >> 8);
+        e[2] = (uint8_t)y; e[3] = (uint8_t)(y >> 8);
+        e[4] = 0x00; e[5] = 0x50;
+        e[6] = 0x11;                                       // 16x16
+        e[7] = (uint8_t)(LLMP_SPR_VISIBLE | (i % 4 == 0 ? LLMP_SPR_BEHIND : 0) | (i % 3 == 0 ? LLMP_SPR_HFLIP : 0));
+    }
+}
+
+/* Débit d'un périphérique programmé directement dans vm->IO, en octets de VRAM écrits */
+static void bench_peripheral(const char *name, int mode, int iterations)
+{
+    llmp16_t *vm = (llmp16_t *)malloc(sizeof(llmp16_t));
+    if (vm == NULL) {
+        perror("VM alloc error");
+        exit(EXIT_FAILURE);
+    }
+    llmp16_init(vm);
+    uint64_t bytes = 0;
+    uint32_t *scaled = NULL;
+    if (mode == 3) compose_setup(vm);
+    if (mode >= 5) {
+        // présentation seule, sans fenêtre : 2x, 4x puis 3x avec l'effet CRT
+        vm->screen.scale = mode == 5 ? 2 : mode == 6 ? 4 : 3;
+        vm->screen.filter = mode == 7 ? LLMP_FILTER_CRT : LLMP_FILTER_NONE;
+        llmp16_screen_setup(&vm->screen);
+        scaled = (uint32_t *)malloc((size_t)LLMP_SCREEN_WIDTH * LLMP_SCREEN_HEIGHT * 16 * sizeof(uint32_t));
+        if (scaled == NULL) {
+            perror("Scale alloc error");
+            llmp16_off(vm);
+            exit(EXIT_FAILURE);
+        }
+        for (uint32_t p = 0; p < LLMP_VRAM_BANK_SIZE; p++) vm->VRAM[p] = (uint8_t)(p * 7);
+    }
+
+    double start = now_seconds();
+    for (int i = 0; i < iterations; i++) {
+        switch (mode) {
+        case 0: // blitter, copie simple d'un bloc 320x200
+        case 1: // blitter, expansion bit-à-bit d'un bloc 320x200
+            vm->IO[LLMP_BLT_PORT][LLMP_BLT_REG_SRC] = 0;
+            vm->IO[LLMP_BLT_PORT][LLMP_BLT_REG_X] = 0;
+            vm->IO[LLMP_BLT_PORT][LLMP_BLT_REG_Y] = 0;
+            vm->IO[LLMP_BLT_PORT][LLMP_BLT_REG_W] = LLMP_SCREEN_WIDTH;
+            vm->IO[LLMP_BLT_PORT][LLMP_BLT_REG_H] = LLMP_SCREEN_HEIGHT;
+            vm->IO[LLMP_BLT_PORT][LLMP_BLT_REG_CTRL] = BLT_CTRL_START | (mode ? BLT_CTRL_BITMODE : 0);
+            llmp16_blitter_step(vm);
+            bytes += LLMP_SCREEN_WIDTH * LLMP_SCREEN_HEIGHT;
+            break;
+        case 3: // compositeur, une image 320x200 défilée d'un pixel en diagonale
+            vm->IO[LLMP_VID_PORT][LLMP_VID_REG_SCROLL_X] = (uint16_t)i;
+            vm->IO[LLMP_VID_PORT][LLMP_VID_REG_SCROLL_Y] = (uint16_t)i;
+            llmp16_video_frame(vm);
+            bytes += LLMP_SCREEN_WIDTH * LLMP_SCREEN_HEIGHT;
+            break;
+        case 4: // mode texte, une ligne de 40 cellules réécrite par image
+            vm->IO[LLMP_SCREEN_PORT][LLMP_SCREEN_REG_MODE] = SCREEN_MODE_TEXT;
+            for (int c = 0; c < 2 * LLMP_TEXT_COLS; c++)
+                vm->VRAM[(i % LLMP_TEXT_ROWS) * 2 * LLMP_TEXT_COLS + c] = (uint8_t)(i + c * 7);
+            llmp16_video_frame(vm);
+            // seules les cellules changées sont redessinées : la première image en entier, puis
+            // une rangée de cellules (8 lignes de pixels)
+            bytes += i == 0 ? LLMP_SCREEN_WIDTH * LLMP_SCREEN_HEIGHT : LLMP_SCREEN_WIDTH * 8;
+            break;
+        case 5: case 6: case 7: { // agrandissement d'une image en XRGB8888, en octets écrits
+            int scale = vm->screen.scale;
+            llmp16_screen_scale(&vm->screen, vm->VRAM, scaled, LLMP_SCREEN_WIDTH * scale * sizeof(uint32_t));
+            bytes += (uint64_t)LLMP_SCREEN_WIDTH * LLMP_SCREEN_HEIGHT * scale * scale * sizeof(uint32_t);
+            break;
+        }
+        default: // DMA, transfert maximal de 32 Ko
+            vm->IO[LLMP_DMA_PORT][LLMP_DMA_REG_SRC] = 0;
+            vm->IO[LLMP_DMA_PORT][LLMP_DMA_REG_DST] = 0;
+            vm->IO[LLMP_DMA_PORT][LLMP_DMA_REG_CNT] = 0x8000;
+            vm->IO[LLMP_DMA_PORT][LLMP_DMA_REG_CTRL] = DMA_CTRL_ENABLE;
+            llmp16_dma_step(vm, &vm->dma);
+            bytes += 0x8000;
+            break;
+        }
+    }
+    double elapsed = now_seconds() - start;
+    free(scaled);
+    llmp16_off(vm);
+
+    printf("{\"bench\":\"%s\",\"bytes\":%llu,\"seconds\":%.6f,\"mb_per_s\":%.3f}\n",
+           name, (unsigned long long)bytes, elapsed,
+           elapsed > 0.0 ? bytes / elapsed / 1e6 : 0.0);
+}
+
+int main(int argc, char *argv[])
+{
+    int repeat = 3;
+    uint64_t max_instr = BENCH_MAX_INSTR;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            repeat = atoi(argv[++i]);
+            if (repeat < 1) repeat = 1;
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            max_instr = strtoull(argv[++i], NULL, 0);
+        } else {
+            bench_rom(argv[i], repeat, max_instr);
+        }
+        fflush(stdout);
+    }
+
+    bench_peripheral("periph_blit_copy", 0, 2000);
+    bench_peripheral("periph_blit_bitmode", 1, 2000);
+    bench_peripheral("periph_dma", 2, 2000);
+    bench_peripheral("periph_compose", 3, 2000);
+    bench_peripheral("periph_text", 4, 2000);
+    bench_peripheral("periph_scale_2x", 5, 2000);
+    bench_peripheral("periph_scale_4x", 6, 2000);
+    bench_peripheral("periph_scale_3x_crt", 7, 2000);
+
+    return 0;
+}
@@ -0,0 +1,22 @@
+/* Benchmark copie mémoire
+ * copie 8 Ko de 0x8000 vers 0xC000 mot par mot, 256 fois
+ */
+
+mov r0 0
+
+outer:
+	mov r1 0x8000
+	mov r2 0xC000
+copy:
+	ld r3 r1
+	str r2 r3
+	inc r1
+	inc r1
+	inc r2
+	inc r2
+	cmp r1 0xA000
+	jne [copy]
+	inc r0
+	cmp r0 256
+	jne [outer]
+hlt
@@ -0,0 +1,33 @@
+/* Benchmark CALL/RET
+ * fib(18) récursif, 64 fois
+ * convention : r1 = n, résultat dans r2, r3 écrasé
+ */
+
+mov r0 0
+
+again:
+	mov r1 18
+	call [fib]
+	inc r0
+	cmp r0 64
+	jne [again]
+hlt
+
+fib:
+	cmp r1 2
+	jcc [base]
+	push r1
+	dec r1
+	call [fib]
+	pop r1
+	push r2
+	dec r1
+	dec r1
+	call [fib]
+	pop r3
+	add r2 r3
+	mov r2 r15
+	ret
+base:
+	mov r2 r1
+	ret
@@ -0,0 +1,23 @@
+/* Benchmark copie vers la VRAM par la fenêtre mémoire
+ * copie 64000 octets de la RAM vers le banc 0 (0xA0000) avec LD/STR, 30 fois
+ */
+
+mov r1 0
+
+frame:
+	mov r8 [0x8000]
+	mov r9 [0xA0000]
+	mov r0 32000
+copy:
+	ld r3 r8
+	str r9 r3
+	inc r8
+	inc r8
+	inc r9
+	inc r9
+	dec r0
+	jne [copy]
+	inc r1
+	cmp r1 30
+	jne [frame]
+hlt
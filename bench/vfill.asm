@@ -0,0 +1,17 @@
+/* Benchmark VSTR
+ * remplit les 64000 pixels de l'écran, 30 fois avec une couleur différente
+ */
+
+mov r7 0
+
+frame:
+	mov r0 0
+fill:
+	vstr r0 r7
+	inc r0
+	cmp r0 64000
+	jne [fill]
+	inc r7
+	cmp r7 30
+	jne [frame]
+hlt
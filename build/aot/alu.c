@@ -0,0 +1,290 @@
+/* Généré par llmp16_aot à partir de alu.bin : ne pas modifier */
+#include "llmp16.h"
+#include "llmp16_aot.h"
+
+static uint32_t b_00000(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00000  MOVI R0, 0x0000 */
+        vm->R[0] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00004  MOVI R2, 0x0003 */
+        vm->R[2] = (uint16_t)(0x00003u);
+    }
+    {   /* 0x00008  MOVI R3, 0x5555 */
+        vm->R[3] = (uint16_t)(0x05555u);
+    }
+    {   /* 0x0000C  MOVI R1, 0x0000 */
+        vm->R[1] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00010  ADD R1, R2 */
+        uint16_t a = (uint16_t)vm->R[1], b = (uint16_t)vm->R[2];
+        uint32_t r = (uint32_t)a + b;
+        vm->R[15] = (uint16_t)r;
+        flag_nz(vm, (uint16_t)r);
+        flag_add_cv(vm, a, b, r);
+    }
+    {   /* 0x00012  MOV R1, ACC */
+        vm->R[1] = (uint16_t)(vm->R[15]);
+    }
+    {   /* 0x00014  MUL R1, R2 */
+        uint16_t r = (uint16_t)((uint32_t)vm->R[1] * (uint16_t)vm->R[2]);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+        flag_set(vm, FLAG_C | FLAG_V, false);
+    }
+    {   /* 0x00016  XOR ACC, R3 */
+        uint16_t r = (uint16_t)(vm->R[15] ^ (uint16_t)vm->R[3]);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+    }
+    {   /* 0x00018  MOV R4, ACC */
+        vm->R[4] = (uint16_t)(vm->R[15]);
+    }
+    {   /* 0x0001A  LSR R4, R2 */
+        uint8_t s = vm->R[2] & 0xF;
+        uint16_t v = (uint16_t)vm->R[4];
+        uint16_t r = v >> s;
+        flag_set(vm, FLAG_C, s && ((v >> (s - 1)) & 0x1));
+        vm->R[4] = (uint16_t)(r);
+        flag_nz(vm, r);
+    }
+    {   /* 0x0001C  SUB R4, R1 */
+        uint16_t a = (uint16_t)vm->R[4], b = (uint16_t)vm->R[1];
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        vm->R[15] = (uint16_t)r;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x0001E  AND ACC, R3 */
+        uint16_t r = (uint16_t)(vm->R[15] & (uint16_t)vm->R[3]);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+    }
+    {   /* 0x00020  INC R1 */
+        uint32_t r = vm->R[1] + 1;
+        vm->R[1] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00022  CMPI R1, 0x03E8 */
+        uint16_t a = (uint16_t)vm->R[1], b = 0x03E8;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00026  JNEI [0x00010] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00010;
+            *count = 15;
+            return 25;
+        }
+        vm->R[PC] = 0x0002A;
+        *count = 15;
+        return 24;
+    }
+}
+
+static uint32_t b_0000C(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0000C  MOVI R1, 0x0000 */
+        vm->R[1] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00010  ADD R1, R2 */
+        uint16_t a = (uint16_t)vm->R[1], b = (uint16_t)vm->R[2];
+        uint32_t r = (uint32_t)a + b;
+        vm->R[15] = (uint16_t)r;
+        flag_nz(vm, (uint16_t)r);
+        flag_add_cv(vm, a, b, r);
+    }
+    {   /* 0x00012  MOV R1, ACC */
+        vm->R[1] = (uint16_t)(vm->R[15]);
+    }
+    {   /* 0x00014  MUL R1, R2 */
+        uint16_t r = (uint16_t)((uint32_t)vm->R[1] * (uint16_t)vm->R[2]);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+        flag_set(vm, FLAG_C | FLAG_V, false);
+    }
+    {   /* 0x00016  XOR ACC, R3 */
+        uint16_t r = (uint16_t)(vm->R[15] ^ (uint16_t)vm->R[3]);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+    }
+    {   /* 0x00018  MOV R4, ACC */
+        vm->R[4] = (uint16_t)(vm->R[15]);
+    }
+    {   /* 0x0001A  LSR R4, R2 */
+        uint8_t s = vm->R[2] & 0xF;
+        uint16_t v = (uint16_t)vm->R[4];
+        uint16_t r = v >> s;
+        flag_set(vm, FLAG_C, s && ((v >> (s - 1)) & 0x1));
+        vm->R[4] = (uint16_t)(r);
+        flag_nz(vm, r);
+    }
+    {   /* 0x0001C  SUB R4, R1 */
+        uint16_t a = (uint16_t)vm->R[4], b = (uint16_t)vm->R[1];
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        vm->R[15] = (uint16_t)r;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x0001E  AND ACC, R3 */
+        uint16_t r = (uint16_t)(vm->R[15] & (uint16_t)vm->R[3]);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+    }
+    {   /* 0x00020  INC R1 */
+        uint32_t r = vm->R[1] + 1;
+        vm->R[1] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00022  CMPI R1, 0x03E8 */
+        uint16_t a = (uint16_t)vm->R[1], b = 0x03E8;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00026  JNEI [0x00010] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00010;
+            *count = 12;
+            return 19;
+        }
+        vm->R[PC] = 0x0002A;
+        *count = 12;
+        return 18;
+    }
+}
+
+static uint32_t b_00010(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    uint32_t n = 0, cycles = 0;
+top:
+    {   /* 0x00010  ADD R1, R2 */
+        uint16_t a = (uint16_t)vm->R[1], b = (uint16_t)vm->R[2];
+        uint32_t r = (uint32_t)a + b;
+        vm->R[15] = (uint16_t)r;
+        flag_nz(vm, (uint16_t)r);
+        flag_add_cv(vm, a, b, r);
+    }
+    {   /* 0x00012  MOV R1, ACC */
+        vm->R[1] = (uint16_t)(vm->R[15]);
+    }
+    {   /* 0x00014  MUL R1, R2 */
+        uint16_t r = (uint16_t)((uint32_t)vm->R[1] * (uint16_t)vm->R[2]);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+        flag_set(vm, FLAG_C | FLAG_V, false);
+    }
+    {   /* 0x00016  XOR ACC, R3 */
+        uint16_t r = (uint16_t)(vm->R[15] ^ (uint16_t)vm->R[3]);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+    }
+    {   /* 0x00018  MOV R4, ACC */
+        vm->R[4] = (uint16_t)(vm->R[15]);
+    }
+    {   /* 0x0001A  LSR R4, R2 */
+        uint8_t s = vm->R[2] & 0xF;
+        uint16_t v = (uint16_t)vm->R[4];
+        uint16_t r = v >> s;
+        flag_set(vm, FLAG_C, s && ((v >> (s - 1)) & 0x1));
+        vm->R[4] = (uint16_t)(r);
+        flag_nz(vm, r);
+    }
+    {   /* 0x0001C  SUB R4, R1 */
+        uint16_t a = (uint16_t)vm->R[4], b = (uint16_t)vm->R[1];
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        vm->R[15] = (uint16_t)r;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x0001E  AND ACC, R3 */
+        uint16_t r = (uint16_t)(vm->R[15] & (uint16_t)vm->R[3]);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+    }
+    {   /* 0x00020  INC R1 */
+        uint32_t r = vm->R[1] + 1;
+        vm->R[1] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00022  CMPI R1, 0x03E8 */
+        uint16_t a = (uint16_t)vm->R[1], b = 0x03E8;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00026  JNEI [0x00010] */
+        if (llmp16_cond(vm, 0x2)) {
+            n += 11;
+            cycles += 17;
+            if (n + 11 <= max_instr && (uint64_t)cycles + 14 <= slack) goto top;
+            vm->R[PC] = 0x00010;
+            *count = n;
+            return cycles;
+        }
+        vm->R[PC] = 0x0002A;
+        *count = n + 11;
+        return cycles + 16;
+    }
+}
+
+static uint32_t b_0002A(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0002A  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0002C  CMPI R0, 0x07D0 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0x07D0;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00030  JNEI [0x0000C] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x0000C;
+            *count = 3;
+            return 6;
+        }
+        vm->R[PC] = 0x00034;
+        *count = 3;
+        return 5;
+    }
+}
+
+static uint32_t b_00034(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00034  HALT */
+        vm->R[PC] = 0x00034;
+        vm->cpu_halted = true;
+        *count = 1;
+        return 1;
+    }
+}
+
+static const llmp16_aot_block_t blocks[] = {
+    { 0x00000, 15, 22, b_00000 },
+    { 0x0000C, 12, 16, b_0000C },
+    { 0x00010, 11, 14, b_00010 },
+    { 0x0002A, 3, 3, b_0002A },
+    { 0x00034, 1, 0, b_00034 },
+};
+
+static const uint8_t rom[54] = {
+    0x00, 0x60, 0x00, 0x00, 0x00, 0x62, 0x03, 0x00, 0x00, 0x63, 0x55, 0x55, 0x00, 0x61, 0x00, 0x00,
+    0x20, 0x11, 0xF0, 0x51, 0x22, 0x11, 0x32, 0x3F, 0xF0, 0x54, 0x28, 0x14, 0x11, 0x14, 0x30, 0x3F,
+    0x05, 0x11, 0x07, 0x21, 0xE8, 0x03, 0x02, 0x80, 0x10, 0x00, 0x05, 0x10, 0x07, 0x20, 0xD0, 0x07,
+    0x02, 0x80, 0x0C, 0x00, 0x01, 0x00,
+};
+
+const llmp16_aot_image_t llmp16_aot_image = { "alu.bin", rom, 54, 5, blocks };
@@ -0,0 +1,444 @@
+/* Généré par llmp16_aot à partir de blend.bin : ne pas modifier */
+#include "llmp16.h"
+#include "llmp16_aot.h"
+
+static uint32_t b_00000(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00000  MOVI R6, 0x0808 */
+        vm->R[6] = (uint16_t)(0x00808u);
+    }
+    {   /* 0x00004  MOVI R0, 0x0000 */
+        vm->R[0] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00008  PSHUF R0, 0 */
+        uint16_t r = llmp16_shuffle((uint16_t)vm->R[0], (uint16_t)vm->R[15], 0);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+    }
+    {   /* 0x0000A  VSTRW R0, ACC */
+        uint16_t a = (uint16_t)vm->R[0], v = (uint16_t)vm->R[15];
+        vram_write(vm, a, (uint8_t)v);
+        vram_write(vm, (uint16_t)(a + 1), (uint8_t)(v >> 8));
+    }
+    {   /* 0x0000C  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0000E  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00010  CMPI R0, 0xFA00 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0xFA00;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00014  JNEI [0x00008] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00008;
+            *count = 8;
+            return 15;
+        }
+        vm->R[PC] = 0x00018;
+        *count = 8;
+        return 14;
+    }
+}
+
+static uint32_t b_00008(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    uint32_t n = 0, cycles = 0;
+top:
+    {   /* 0x00008  PSHUF R0, 0 */
+        uint16_t r = llmp16_shuffle((uint16_t)vm->R[0], (uint16_t)vm->R[15], 0);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+    }
+    {   /* 0x0000A  VSTRW R0, ACC */
+        uint16_t a = (uint16_t)vm->R[0], v = (uint16_t)vm->R[15];
+        vram_write(vm, a, (uint8_t)v);
+        vram_write(vm, (uint16_t)(a + 1), (uint8_t)(v >> 8));
+    }
+    {   /* 0x0000C  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0000E  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00010  CMPI R0, 0xFA00 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0xFA00;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00014  JNEI [0x00008] */
+        if (llmp16_cond(vm, 0x2)) {
+            n += 6;
+            cycles += 11;
+            if (n + 6 <= max_instr && (uint64_t)cycles + 8 <= slack) goto top;
+            vm->R[PC] = 0x00008;
+            *count = n;
+            return cycles;
+        }
+        vm->R[PC] = 0x00018;
+        *count = n + 6;
+        return cycles + 10;
+    }
+}
+
+static uint32_t b_00018(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00018  MOVI R7, 0x0000 */
+        vm->R[7] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x0001C  MOVI R0, 0x0000 */
+        vm->R[0] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00020  VLDW R1, R0 */
+        uint16_t a = (uint16_t)vm->R[0];
+        uint8_t lo = vram_read(vm, a);
+        vm->R[1] = (uint16_t)(lo | vram_read(vm, (uint16_t)(a + 1)) << 8);
+    }
+    {   /* 0x00022  PSUBS R1, R6 */
+        uint16_t r = llmp16_packed(1, (uint16_t)vm->R[1], (uint16_t)vm->R[6]);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+    }
+    {   /* 0x00024  VSTRW R0, ACC */
+        uint16_t a = (uint16_t)vm->R[0], v = (uint16_t)vm->R[15];
+        vram_write(vm, a, (uint8_t)v);
+        vram_write(vm, (uint16_t)(a + 1), (uint8_t)(v >> 8));
+    }
+    {   /* 0x00026  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00028  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0002A  CMPI R0, 0xFA00 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0xFA00;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x0002E  JNEI [0x00020] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00020;
+            *count = 9;
+            return 18;
+        }
+        vm->R[PC] = 0x00032;
+        *count = 9;
+        return 17;
+    }
+}
+
+static uint32_t b_0001C(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0001C  MOVI R0, 0x0000 */
+        vm->R[0] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00020  VLDW R1, R0 */
+        uint16_t a = (uint16_t)vm->R[0];
+        uint8_t lo = vram_read(vm, a);
+        vm->R[1] = (uint16_t)(lo | vram_read(vm, (uint16_t)(a + 1)) << 8);
+    }
+    {   /* 0x00022  PSUBS R1, R6 */
+        uint16_t r = llmp16_packed(1, (uint16_t)vm->R[1], (uint16_t)vm->R[6]);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+    }
+    {   /* 0x00024  VSTRW R0, ACC */
+        uint16_t a = (uint16_t)vm->R[0], v = (uint16_t)vm->R[15];
+        vram_write(vm, a, (uint8_t)v);
+        vram_write(vm, (uint16_t)(a + 1), (uint8_t)(v >> 8));
+    }
+    {   /* 0x00026  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00028  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0002A  CMPI R0, 0xFA00 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0xFA00;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x0002E  JNEI [0x00020] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00020;
+            *count = 8;
+            return 16;
+        }
+        vm->R[PC] = 0x00032;
+        *count = 8;
+        return 15;
+    }
+}
+
+static uint32_t b_00020(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    uint32_t n = 0, cycles = 0;
+top:
+    {   /* 0x00020  VLDW R1, R0 */
+        uint16_t a = (uint16_t)vm->R[0];
+        uint8_t lo = vram_read(vm, a);
+        vm->R[1] = (uint16_t)(lo | vram_read(vm, (uint16_t)(a + 1)) << 8);
+    }
+    {   /* 0x00022  PSUBS R1, R6 */
+        uint16_t r = llmp16_packed(1, (uint16_t)vm->R[1], (uint16_t)vm->R[6]);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+    }
+    {   /* 0x00024  VSTRW R0, ACC */
+        uint16_t a = (uint16_t)vm->R[0], v = (uint16_t)vm->R[15];
+        vram_write(vm, a, (uint8_t)v);
+        vram_write(vm, (uint16_t)(a + 1), (uint8_t)(v >> 8));
+    }
+    {   /* 0x00026  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00028  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0002A  CMPI R0, 0xFA00 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0xFA00;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x0002E  JNEI [0x00020] */
+        if (llmp16_cond(vm, 0x2)) {
+            n += 7;
+            cycles += 14;
+            if (n + 7 <= max_instr && (uint64_t)cycles + 11 <= slack) goto top;
+            vm->R[PC] = 0x00020;
+            *count = n;
+            return cycles;
+        }
+        vm->R[PC] = 0x00032;
+        *count = n + 7;
+        return cycles + 13;
+    }
+}
+
+static uint32_t b_00032(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00032  INC R7 */
+        uint32_t r = vm->R[7] + 1;
+        vm->R[7] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00034  CMPI R7, 0x001E */
+        uint16_t a = (uint16_t)vm->R[7], b = 0x001E;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00038  JNEI [0x0001C] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x0001C;
+            *count = 3;
+            return 6;
+        }
+        vm->R[PC] = 0x0003C;
+        *count = 3;
+        return 5;
+    }
+}
+
+static uint32_t b_0003C(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0003C  MOVI R0, 0x0000 */
+        vm->R[0] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00040  MOVI R2, 0x7D00 */
+        vm->R[2] = (uint16_t)(0x07D00u);
+    }
+    {   /* 0x00044  VLDW R1, R0 */
+        uint16_t a = (uint16_t)vm->R[0];
+        uint8_t lo = vram_read(vm, a);
+        vm->R[1] = (uint16_t)(lo | vram_read(vm, (uint16_t)(a + 1)) << 8);
+    }
+    {   /* 0x00046  VLDW R3, R2 */
+        uint16_t a = (uint16_t)vm->R[2];
+        uint8_t lo = vram_read(vm, a);
+        vm->R[3] = (uint16_t)(lo | vram_read(vm, (uint16_t)(a + 1)) << 8);
+    }
+    {   /* 0x00048  PAVG R1, R3 */
+        uint16_t r = llmp16_packed(2, (uint16_t)vm->R[1], (uint16_t)vm->R[3]);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+    }
+    {   /* 0x0004A  VSTRW R0, ACC */
+        uint16_t a = (uint16_t)vm->R[0], v = (uint16_t)vm->R[15];
+        vram_write(vm, a, (uint8_t)v);
+        vram_write(vm, (uint16_t)(a + 1), (uint8_t)(v >> 8));
+    }
+    {   /* 0x0004C  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0004E  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00050  INC R2 */
+        uint32_t r = vm->R[2] + 1;
+        vm->R[2] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00052  INC R2 */
+        uint32_t r = vm->R[2] + 1;
+        vm->R[2] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00054  CMPI R0, 0x7D00 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0x7D00;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00058  JNEI [0x00044] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00044;
+            *count = 12;
+            return 23;
+        }
+        vm->R[PC] = 0x0005C;
+        *count = 12;
+        return 22;
+    }
+}
+
+static uint32_t b_00044(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    uint32_t n = 0, cycles = 0;
+top:
+    {   /* 0x00044  VLDW R1, R0 */
+        uint16_t a = (uint16_t)vm->R[0];
+        uint8_t lo = vram_read(vm, a);
+        vm->R[1] = (uint16_t)(lo | vram_read(vm, (uint16_t)(a + 1)) << 8);
+    }
+    {   /* 0x00046  VLDW R3, R2 */
+        uint16_t a = (uint16_t)vm->R[2];
+        uint8_t lo = vram_read(vm, a);
+        vm->R[3] = (uint16_t)(lo | vram_read(vm, (uint16_t)(a + 1)) << 8);
+    }
+    {   /* 0x00048  PAVG R1, R3 */
+        uint16_t r = llmp16_packed(2, (uint16_t)vm->R[1], (uint16_t)vm->R[3]);
+        vm->R[15] = r;
+        flag_nz(vm, r);
+    }
+    {   /* 0x0004A  VSTRW R0, ACC */
+        uint16_t a = (uint16_t)vm->R[0], v = (uint16_t)vm->R[15];
+        vram_write(vm, a, (uint8_t)v);
+        vram_write(vm, (uint16_t)(a + 1), (uint8_t)(v >> 8));
+    }
+    {   /* 0x0004C  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0004E  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00050  INC R2 */
+        uint32_t r = vm->R[2] + 1;
+        vm->R[2] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00052  INC R2 */
+        uint32_t r = vm->R[2] + 1;
+        vm->R[2] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00054  CMPI R0, 0x7D00 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0x7D00;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00058  JNEI [0x00044] */
+        if (llmp16_cond(vm, 0x2)) {
+            n += 10;
+            cycles += 19;
+            if (n + 10 <= max_instr && (uint64_t)cycles + 16 <= slack) goto top;
+            vm->R[PC] = 0x00044;
+            *count = n;
+            return cycles;
+        }
+        vm->R[PC] = 0x0005C;
+        *count = n + 10;
+        return cycles + 18;
+    }
+}
+
+static uint32_t b_0005C(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0005C  HALT */
+        vm->R[PC] = 0x0005C;
+        vm->cpu_halted = true;
+        *count = 1;
+        return 1;
+    }
+}
+
+static const llmp16_aot_block_t blocks[] = {
+    { 0x00000, 8, 12, b_00000 },
+    { 0x00008, 6, 8, b_00008 },
+    { 0x00018, 9, 15, b_00018 },
+    { 0x0001C, 8, 13, b_0001C },
+    { 0x00020, 7, 11, b_00020 },
+    { 0x00032, 3, 3, b_00032 },
+    { 0x0003C, 12, 20, b_0003C },
+    { 0x00044, 10, 16, b_00044 },
+    { 0x0005C, 1, 0, b_0005C },
+};
+
+static const uint8_t rom[94] = {
+    0x00, 0x66, 0x08, 0x08, 0x00, 0x60, 0x00, 0x00, 0x05, 0xE0, 0xF8, 0x50, 0x05, 0x10, 0x05, 0x10,
+    0x07, 0x20, 0x00, 0xFA, 0x02, 0x80, 0x08, 0x00, 0x00, 0x67, 0x00, 0x00, 0x00, 0x60, 0x00, 0x00,
+    0x07, 0x51, 0x61, 0xE1, 0xF8, 0x50, 0x05, 0x10, 0x05, 0x10, 0x07, 0x20, 0x00, 0xFA, 0x02, 0x80,
+    0x20, 0x00, 0x05, 0x17, 0x07, 0x27, 0x1E, 0x00, 0x02, 0x80, 0x1C, 0x00, 0x00, 0x60, 0x00, 0x00,
+    0x00, 0x62, 0x00, 0x7D, 0x07, 0x51, 0x27, 0x53, 0x32, 0xE1, 0xF8, 0x50, 0x05, 0x10, 0x05, 0x10,
+    0x05, 0x12, 0x05, 0x12, 0x07, 0x20, 0x00, 0x7D, 0x02, 0x80, 0x44, 0x00, 0x01, 0x00,
+};
+
+const llmp16_aot_image_t llmp16_aot_image = { "blend.bin", rom, 94, 9, blocks };
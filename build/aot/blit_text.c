@@ -0,0 +1,289 @@
+/* Généré par llmp16_aot à partir de blit_text.bin : ne pas modifier */
+#include "llmp16.h"
+#include "llmp16_aot.h"
+
+static uint32_t b_00000(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00000  JUMPI [0x0000C] */
+        vm->R[PC] = 0x0000C;
+        *count = 1;
+        return 3;
+    }
+}
+
+static uint32_t b_0000C(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0000C  MOVI R4, 0x0008 */
+        vm->R[4] = (uint16_t)(0x00008u);
+    }
+    {   /* 0x00010  MOVI R6, 0x0003 */
+        vm->R[6] = (uint16_t)(0x00003u);
+    }
+    {   /* 0x00014  MOVI R7, 0x0000 */
+        vm->R[7] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00018  MOVI R3, 0x0000 */
+        vm->R[3] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x0001C  MOVI R2, 0x0000 */
+        vm->R[2] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00020  MOVI R1, 0x0004 */
+        vm->R[1] = (uint16_t)(0x00004u);
+    }
+    {   /* 0x00024  OUT R1, $8, 0 */
+        vm->R[PC] = 0x00026;
+        llmp16_io_write(vm, 8, 0, (uint16_t)vm->R[1]);
+        *count = 7;
+        return 15;
+    }
+}
+
+static uint32_t b_00018(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00018  MOVI R3, 0x0000 */
+        vm->R[3] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x0001C  MOVI R2, 0x0000 */
+        vm->R[2] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00020  MOVI R1, 0x0004 */
+        vm->R[1] = (uint16_t)(0x00004u);
+    }
+    {   /* 0x00024  OUT R1, $8, 0 */
+        vm->R[PC] = 0x00026;
+        llmp16_io_write(vm, 8, 0, (uint16_t)vm->R[1]);
+        *count = 4;
+        return 9;
+    }
+}
+
+static uint32_t b_0001C(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0001C  MOVI R2, 0x0000 */
+        vm->R[2] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00020  MOVI R1, 0x0004 */
+        vm->R[1] = (uint16_t)(0x00004u);
+    }
+    {   /* 0x00024  OUT R1, $8, 0 */
+        vm->R[PC] = 0x00026;
+        llmp16_io_write(vm, 8, 0, (uint16_t)vm->R[1]);
+        *count = 3;
+        return 7;
+    }
+}
+
+static uint32_t b_00020(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00020  MOVI R1, 0x0004 */
+        vm->R[1] = (uint16_t)(0x00004u);
+    }
+    {   /* 0x00024  OUT R1, $8, 0 */
+        vm->R[PC] = 0x00026;
+        llmp16_io_write(vm, 8, 0, (uint16_t)vm->R[1]);
+        *count = 2;
+        return 5;
+    }
+}
+
+static uint32_t b_00026(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00026  OUT R2, $8, 1 */
+        vm->R[PC] = 0x00028;
+        llmp16_io_write(vm, 8, 1, (uint16_t)vm->R[2]);
+        *count = 1;
+        return 3;
+    }
+}
+
+static uint32_t b_00028(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00028  OUT R3, $8, 2 */
+        vm->R[PC] = 0x0002A;
+        llmp16_io_write(vm, 8, 2, (uint16_t)vm->R[3]);
+        *count = 1;
+        return 3;
+    }
+}
+
+static uint32_t b_0002A(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0002A  OUT R4, $8, 3 */
+        vm->R[PC] = 0x0002C;
+        llmp16_io_write(vm, 8, 3, (uint16_t)vm->R[4]);
+        *count = 1;
+        return 3;
+    }
+}
+
+static uint32_t b_0002C(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0002C  OUT R4, $8, 4 */
+        vm->R[PC] = 0x0002E;
+        llmp16_io_write(vm, 8, 4, (uint16_t)vm->R[4]);
+        *count = 1;
+        return 3;
+    }
+}
+
+static uint32_t b_0002E(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0002E  OUT R6, $8, 5 */
+        vm->R[PC] = 0x00030;
+        llmp16_io_write(vm, 8, 5, (uint16_t)vm->R[6]);
+        *count = 1;
+        return 3;
+    }
+}
+
+static uint32_t b_00030(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00030  ADD R2, R4 */
+        uint16_t a = (uint16_t)vm->R[2], b = (uint16_t)vm->R[4];
+        uint32_t r = (uint32_t)a + b;
+        vm->R[15] = (uint16_t)r;
+        flag_nz(vm, (uint16_t)r);
+        flag_add_cv(vm, a, b, r);
+    }
+    {   /* 0x00032  MOV R2, ACC */
+        vm->R[2] = (uint16_t)(vm->R[15]);
+    }
+    {   /* 0x00034  CMPI R2, 0x0140 */
+        uint16_t a = (uint16_t)vm->R[2], b = 0x0140;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00038  JNEI [0x00020] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00020;
+            *count = 4;
+            return 7;
+        }
+        vm->R[PC] = 0x0003C;
+        *count = 4;
+        return 6;
+    }
+}
+
+static uint32_t b_0003C(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0003C  ADD R3, R4 */
+        uint16_t a = (uint16_t)vm->R[3], b = (uint16_t)vm->R[4];
+        uint32_t r = (uint32_t)a + b;
+        vm->R[15] = (uint16_t)r;
+        flag_nz(vm, (uint16_t)r);
+        flag_add_cv(vm, a, b, r);
+    }
+    {   /* 0x0003E  MOV R3, ACC */
+        vm->R[3] = (uint16_t)(vm->R[15]);
+    }
+    {   /* 0x00040  CMPI R3, 0x00C8 */
+        uint16_t a = (uint16_t)vm->R[3], b = 0x00C8;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00044  JNEI [0x0001C] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x0001C;
+            *count = 4;
+            return 7;
+        }
+        vm->R[PC] = 0x00048;
+        *count = 4;
+        return 6;
+    }
+}
+
+static uint32_t b_00048(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00048  INC R7 */
+        uint32_t r = vm->R[7] + 1;
+        vm->R[7] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0004A  CMPI R7, 0x00C8 */
+        uint16_t a = (uint16_t)vm->R[7], b = 0x00C8;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x0004E  JNEI [0x00018] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00018;
+            *count = 3;
+            return 6;
+        }
+        vm->R[PC] = 0x00052;
+        *count = 3;
+        return 5;
+    }
+}
+
+static uint32_t b_00052(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00052  HALT */
+        vm->R[PC] = 0x00052;
+        vm->cpu_halted = true;
+        *count = 1;
+        return 1;
+    }
+}
+
+static const llmp16_aot_block_t blocks[] = {
+    { 0x00000, 1, 0, b_00000 },
+    { 0x0000C, 7, 12, b_0000C },
+    { 0x00018, 4, 6, b_00018 },
+    { 0x0001C, 3, 4, b_0001C },
+    { 0x00020, 2, 2, b_00020 },
+    { 0x00026, 1, 0, b_00026 },
+    { 0x00028, 1, 0, b_00028 },
+    { 0x0002A, 1, 0, b_0002A },
+    { 0x0002C, 1, 0, b_0002C },
+    { 0x0002E, 1, 0, b_0002E },
+    { 0x00030, 4, 4, b_00030 },
+    { 0x0003C, 4, 4, b_0003C },
+    { 0x00048, 3, 3, b_00048 },
+    { 0x00052, 1, 0, b_00052 },
+};
+
+static const uint8_t rom[84] = {
+    0x00, 0x80, 0x0C, 0x00, 0x18, 0x3C, 0x66, 0x66, 0x7E, 0x66, 0x66, 0x00, 0x00, 0x64, 0x08, 0x00,
+    0x00, 0x66, 0x03, 0x00, 0x00, 0x67, 0x00, 0x00, 0x00, 0x63, 0x00, 0x00, 0x00, 0x62, 0x00, 0x00,
+    0x00, 0x61, 0x04, 0x00, 0x80, 0xA1, 0x81, 0xA2, 0x82, 0xA3, 0x83, 0xA4, 0x84, 0xA4, 0x85, 0xA6,
+    0x40, 0x12, 0xF0, 0x52, 0x07, 0x22, 0x40, 0x01, 0x02, 0x80, 0x20, 0x00, 0x40, 0x13, 0xF0, 0x53,
+    0x07, 0x23, 0xC8, 0x00, 0x02, 0x80, 0x1C, 0x00, 0x05, 0x17, 0x07, 0x27, 0xC8, 0x00, 0x02, 0x80,
+    0x18, 0x00, 0x01, 0x00,
+};
+
+const llmp16_aot_image_t llmp16_aot_image = { "blit_text.bin", rom, 84, 14, blocks };
@@ -0,0 +1,255 @@
+/* Généré par llmp16_aot à partir de blk.bin : ne pas modifier */
+#include "llmp16.h"
+#include "llmp16_aot.h"
+
+static uint32_t b_00000(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00000  MOVI R0, 0x0000 */
+        vm->R[0] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00004  MOVI R1, 0xC000 */
+        vm->R[1] = (uint16_t)(0x0C000u);
+    }
+    {   /* 0x00008  MOVI R2, 0x8000 */
+        vm->R[2] = (uint16_t)(0x08000u);
+    }
+    {   /* 0x0000C  MOVI IDX, 0x2000 */
+        vm->R[PC] = 0x00010;
+        vm->R[14] = 0x02000u;
+        *count = 4;
+        return 8;
+    }
+}
+
+static uint32_t b_00004(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00004  MOVI R1, 0xC000 */
+        vm->R[1] = (uint16_t)(0x0C000u);
+    }
+    {   /* 0x00008  MOVI R2, 0x8000 */
+        vm->R[2] = (uint16_t)(0x08000u);
+    }
+    {   /* 0x0000C  MOVI IDX, 0x2000 */
+        vm->R[PC] = 0x00010;
+        vm->R[14] = 0x02000u;
+        *count = 3;
+        return 6;
+    }
+}
+
+static uint32_t b_00010(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00010  MCPY R1, R2 */
+        vm->R[PC] = 0x00012;
+        uint32_t extra = execute(vm, llmp16_decode_raw(0xB120, 0));
+        *count = 1;
+        return 2 + extra;
+    }
+}
+
+static uint32_t b_00012(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00012  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00014  CMPI R0, 0x0100 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0x0100;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00018  JNEI [0x00004] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00004;
+            *count = 3;
+            return 6;
+        }
+        vm->R[PC] = 0x0001C;
+        *count = 3;
+        return 5;
+    }
+}
+
+static uint32_t b_0001C(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0001C  MOVI R7, 0x0000 */
+        vm->R[7] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00020  MOVI R1, 0x0000 */
+        vm->R[1] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00024  MOVI IDX, 0xFA00 */
+        vm->R[PC] = 0x00028;
+        vm->R[14] = 0x0FA00u;
+        *count = 3;
+        return 6;
+    }
+}
+
+static uint32_t b_00020(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00020  MOVI R1, 0x0000 */
+        vm->R[1] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00024  MOVI IDX, 0xFA00 */
+        vm->R[PC] = 0x00028;
+        vm->R[14] = 0x0FA00u;
+        *count = 2;
+        return 4;
+    }
+}
+
+static uint32_t b_00028(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00028  VFIL R1, R7 */
+        vm->R[PC] = 0x0002A;
+        uint32_t extra = execute(vm, llmp16_decode_raw(0xB172, 0));
+        *count = 1;
+        return 2 + extra;
+    }
+}
+
+static uint32_t b_0002A(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0002A  INC R7 */
+        uint32_t r = vm->R[7] + 1;
+        vm->R[7] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0002C  CMPI R7, 0x001E */
+        uint16_t a = (uint16_t)vm->R[7], b = 0x001E;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00030  JNEI [0x00020] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00020;
+            *count = 3;
+            return 6;
+        }
+        vm->R[PC] = 0x00034;
+        *count = 3;
+        return 5;
+    }
+}
+
+static uint32_t b_00034(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00034  MOVI R3, 0x0000 */
+        vm->R[3] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00038  MOVI R1, 0x8000 */
+        vm->R[1] = (uint16_t)(0x08000u);
+    }
+    {   /* 0x0003C  MOVI R2, 0xC000 */
+        vm->R[2] = (uint16_t)(0x0C000u);
+    }
+    {   /* 0x00040  MOVI IDX, 0x2000 */
+        vm->R[PC] = 0x00044;
+        vm->R[14] = 0x02000u;
+        *count = 4;
+        return 8;
+    }
+}
+
+static uint32_t b_00044(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00044  MCMP R1, R2 */
+        vm->R[PC] = 0x00046;
+        uint32_t extra = execute(vm, llmp16_decode_raw(0xB123, 0));
+        *count = 1;
+        return 2 + extra;
+    }
+}
+
+static uint32_t b_00046(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00046  JNEI [0x0004E] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x0004E;
+            *count = 1;
+            return 3;
+        }
+        vm->R[PC] = 0x0004A;
+        *count = 1;
+        return 2;
+    }
+}
+
+static uint32_t b_0004A(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0004A  MOVI R3, 0x0001 */
+        vm->R[3] = (uint16_t)(0x00001u);
+    }
+    {   /* 0x0004E  HALT */
+        vm->R[PC] = 0x0004E;
+        vm->cpu_halted = true;
+        *count = 2;
+        return 3;
+    }
+}
+
+static uint32_t b_0004E(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0004E  HALT */
+        vm->R[PC] = 0x0004E;
+        vm->cpu_halted = true;
+        *count = 1;
+        return 1;
+    }
+}
+
+static const llmp16_aot_block_t blocks[] = {
+    { 0x00000, 4, 6, b_00000 },
+    { 0x00004, 3, 4, b_00004 },
+    { 0x00010, 1, 0, b_00010 },
+    { 0x00012, 3, 3, b_00012 },
+    { 0x0001C, 3, 4, b_0001C },
+    { 0x00020, 2, 2, b_00020 },
+    { 0x00028, 1, 0, b_00028 },
+    { 0x0002A, 3, 3, b_0002A },
+    { 0x00034, 4, 6, b_00034 },
+    { 0x00044, 1, 0, b_00044 },
+    { 0x00046, 1, 0, b_00046 },
+    { 0x0004A, 2, 2, b_0004A },
+    { 0x0004E, 1, 0, b_0004E },
+};
+
+static const uint8_t rom[80] = {
+    0x00, 0x60, 0x00, 0x00, 0x00, 0x61, 0x00, 0xC0, 0x00, 0x62, 0x00, 0x80, 0x00, 0x6E, 0x00, 0x20,
+    0x20, 0xB1, 0x05, 0x10, 0x07, 0x20, 0x00, 0x01, 0x02, 0x80, 0x04, 0x00, 0x00, 0x67, 0x00, 0x00,
+    0x00, 0x61, 0x00, 0x00, 0x00, 0x6E, 0x00, 0xFA, 0x72, 0xB1, 0x05, 0x17, 0x07, 0x27, 0x1E, 0x00,
+    0x02, 0x80, 0x20, 0x00, 0x00, 0x63, 0x00, 0x00, 0x00, 0x61, 0x00, 0x80, 0x00, 0x62, 0x00, 0xC0,
+    0x00, 0x6E, 0x00, 0x20, 0x23, 0xB1, 0x02, 0x80, 0x4E, 0x00, 0x00, 0x63, 0x01, 0x00, 0x01, 0x00,
+};
+
+const llmp16_aot_image_t llmp16_aot_image = { "blk.bin", rom, 80, 13, blocks };
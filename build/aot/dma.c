@@ -0,0 +1,135 @@
+/* Généré par llmp16_aot à partir de dma.bin : ne pas modifier */
+#include "llmp16.h"
+#include "llmp16_aot.h"
+
+static uint32_t b_00000(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00000  MOVI R1, 0x0000 */
+        vm->R[1] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00004  MOVI R2, 0x0000 */
+        vm->R[2] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00008  MOVI R3, 0x4000 */
+        vm->R[3] = (uint16_t)(0x04000u);
+    }
+    {   /* 0x0000C  MOVI R4, 0x0001 */
+        vm->R[4] = (uint16_t)(0x00001u);
+    }
+    {   /* 0x00010  MOVI R0, 0x0000 */
+        vm->R[0] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00014  OUT R1, $7, 0 */
+        vm->R[PC] = 0x00016;
+        llmp16_io_write(vm, 7, 0, (uint16_t)vm->R[1]);
+        *count = 6;
+        return 13;
+    }
+}
+
+static uint32_t b_00014(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00014  OUT R1, $7, 0 */
+        vm->R[PC] = 0x00016;
+        llmp16_io_write(vm, 7, 0, (uint16_t)vm->R[1]);
+        *count = 1;
+        return 3;
+    }
+}
+
+static uint32_t b_00016(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00016  OUT R2, $7, 1 */
+        vm->R[PC] = 0x00018;
+        llmp16_io_write(vm, 7, 1, (uint16_t)vm->R[2]);
+        *count = 1;
+        return 3;
+    }
+}
+
+static uint32_t b_00018(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00018  OUT R3, $7, 2 */
+        vm->R[PC] = 0x0001A;
+        llmp16_io_write(vm, 7, 2, (uint16_t)vm->R[3]);
+        *count = 1;
+        return 3;
+    }
+}
+
+static uint32_t b_0001A(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0001A  OUT R4, $7, 3 */
+        vm->R[PC] = 0x0001C;
+        llmp16_io_write(vm, 7, 3, (uint16_t)vm->R[4]);
+        *count = 1;
+        return 3;
+    }
+}
+
+static uint32_t b_0001C(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0001C  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0001E  CMPI R0, 0x07D0 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0x07D0;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00022  JNEI [0x00014] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00014;
+            *count = 3;
+            return 6;
+        }
+        vm->R[PC] = 0x00026;
+        *count = 3;
+        return 5;
+    }
+}
+
+static uint32_t b_00026(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00026  HALT */
+        vm->R[PC] = 0x00026;
+        vm->cpu_halted = true;
+        *count = 1;
+        return 1;
+    }
+}
+
+static const llmp16_aot_block_t blocks[] = {
+    { 0x00000, 6, 10, b_00000 },
+    { 0x00014, 1, 0, b_00014 },
+    { 0x00016, 1, 0, b_00016 },
+    { 0x00018, 1, 0, b_00018 },
+    { 0x0001A, 1, 0, b_0001A },
+    { 0x0001C, 3, 3, b_0001C },
+    { 0x00026, 1, 0, b_00026 },
+};
+
+static const uint8_t rom[40] = {
+    0x00, 0x61, 0x00, 0x00, 0x00, 0x62, 0x00, 0x00, 0x00, 0x63, 0x00, 0x40, 0x00, 0x64, 0x01, 0x00,
+    0x00, 0x60, 0x00, 0x00, 0x70, 0xA1, 0x71, 0xA2, 0x72, 0xA3, 0x73, 0xA4, 0x05, 0x10, 0x07, 0x20,
+    0xD0, 0x07, 0x02, 0x80, 0x14, 0x00, 0x01, 0x00,
+};
+
+const llmp16_aot_image_t llmp16_aot_image = { "dma.bin", rom, 40, 7, blocks };
@@ -0,0 +1,232 @@
+/* Généré par llmp16_aot à partir de memcpy.bin : ne pas modifier */
+#include "llmp16.h"
+#include "llmp16_aot.h"
+
+static uint32_t b_00000(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00000  MOVI R0, 0x0000 */
+        vm->R[0] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00004  MOVI R1, 0x8000 */
+        vm->R[1] = (uint16_t)(0x08000u);
+    }
+    {   /* 0x00008  MOVI R2, 0xC000 */
+        vm->R[2] = (uint16_t)(0x0C000u);
+    }
+    {   /* 0x0000C  LD R3, R1 */
+        uint32_t a = vm->R[1];
+        if (llmp16_aot_slow(vm->rd_page, a)) { vm->R[PC] = 0x0000C; *count = 3; return 6; }
+        vm->R[3] = (uint16_t)(mem_read16(vm, a));
+    }
+    {   /* 0x0000E  STR R2, R3 */
+        uint32_t a = vm->R[2];
+        if (llmp16_aot_slow(vm->wr_page, a)) { vm->R[PC] = 0x0000E; *count = 4; return 9; }
+        mem_write16(vm, a, (uint16_t)vm->R[3]);
+    }
+    {   /* 0x00010  INC R1 */
+        uint32_t r = vm->R[1] + 1;
+        vm->R[1] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00012  INC R1 */
+        uint32_t r = vm->R[1] + 1;
+        vm->R[1] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00014  INC R2 */
+        uint32_t r = vm->R[2] + 1;
+        vm->R[2] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00016  INC R2 */
+        uint32_t r = vm->R[2] + 1;
+        vm->R[2] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00018  CMPI R1, 0xA000 */
+        uint16_t a = (uint16_t)vm->R[1], b = 0xA000;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x0001C  JNEI [0x0000C] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x0000C;
+            *count = 11;
+            return 21;
+        }
+        vm->R[PC] = 0x00020;
+        *count = 11;
+        return 20;
+    }
+}
+
+static uint32_t b_00004(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00004  MOVI R1, 0x8000 */
+        vm->R[1] = (uint16_t)(0x08000u);
+    }
+    {   /* 0x00008  MOVI R2, 0xC000 */
+        vm->R[2] = (uint16_t)(0x0C000u);
+    }
+    {   /* 0x0000C  LD R3, R1 */
+        uint32_t a = vm->R[1];
+        if (llmp16_aot_slow(vm->rd_page, a)) { vm->R[PC] = 0x0000C; *count = 2; return 4; }
+        vm->R[3] = (uint16_t)(mem_read16(vm, a));
+    }
+    {   /* 0x0000E  STR R2, R3 */
+        uint32_t a = vm->R[2];
+        if (llmp16_aot_slow(vm->wr_page, a)) { vm->R[PC] = 0x0000E; *count = 3; return 7; }
+        mem_write16(vm, a, (uint16_t)vm->R[3]);
+    }
+    {   /* 0x00010  INC R1 */
+        uint32_t r = vm->R[1] + 1;
+        vm->R[1] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00012  INC R1 */
+        uint32_t r = vm->R[1] + 1;
+        vm->R[1] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00014  INC R2 */
+        uint32_t r = vm->R[2] + 1;
+        vm->R[2] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00016  INC R2 */
+        uint32_t r = vm->R[2] + 1;
+        vm->R[2] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00018  CMPI R1, 0xA000 */
+        uint16_t a = (uint16_t)vm->R[1], b = 0xA000;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x0001C  JNEI [0x0000C] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x0000C;
+            *count = 10;
+            return 19;
+        }
+        vm->R[PC] = 0x00020;
+        *count = 10;
+        return 18;
+    }
+}
+
+static uint32_t b_0000C(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    uint32_t n = 0, cycles = 0;
+top:
+    {   /* 0x0000C  LD R3, R1 */
+        uint32_t a = vm->R[1];
+        if (llmp16_aot_slow(vm->rd_page, a)) { vm->R[PC] = 0x0000C; *count = n + 0; return cycles + 0; }
+        vm->R[3] = (uint16_t)(mem_read16(vm, a));
+    }
+    {   /* 0x0000E  STR R2, R3 */
+        uint32_t a = vm->R[2];
+        if (llmp16_aot_slow(vm->wr_page, a)) { vm->R[PC] = 0x0000E; *count = n + 1; return cycles + 3; }
+        mem_write16(vm, a, (uint16_t)vm->R[3]);
+    }
+    {   /* 0x00010  INC R1 */
+        uint32_t r = vm->R[1] + 1;
+        vm->R[1] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00012  INC R1 */
+        uint32_t r = vm->R[1] + 1;
+        vm->R[1] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00014  INC R2 */
+        uint32_t r = vm->R[2] + 1;
+        vm->R[2] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00016  INC R2 */
+        uint32_t r = vm->R[2] + 1;
+        vm->R[2] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00018  CMPI R1, 0xA000 */
+        uint16_t a = (uint16_t)vm->R[1], b = 0xA000;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x0001C  JNEI [0x0000C] */
+        if (llmp16_cond(vm, 0x2)) {
+            n += 8;
+            cycles += 15;
+            if (n + 8 <= max_instr && (uint64_t)cycles + 12 <= slack) goto top;
+            vm->R[PC] = 0x0000C;
+            *count = n;
+            return cycles;
+        }
+        vm->R[PC] = 0x00020;
+        *count = n + 8;
+        return cycles + 14;
+    }
+}
+
+static uint32_t b_00020(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00020  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00022  CMPI R0, 0x0100 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0x0100;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00026  JNEI [0x00004] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00004;
+            *count = 3;
+            return 6;
+        }
+        vm->R[PC] = 0x0002A;
+        *count = 3;
+        return 5;
+    }
+}
+
+static uint32_t b_0002A(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0002A  HALT */
+        vm->R[PC] = 0x0002A;
+        vm->cpu_halted = true;
+        *count = 1;
+        return 1;
+    }
+}
+
+static const llmp16_aot_block_t blocks[] = {
+    { 0x00000, 11, 18, b_00000 },
+    { 0x00004, 10, 16, b_00004 },
+    { 0x0000C, 8, 12, b_0000C },
+    { 0x00020, 3, 3, b_00020 },
+    { 0x0002A, 1, 0, b_0002A },
+};
+
+static const uint8_t rom[44] = {
+    0x00, 0x60, 0x00, 0x00, 0x00, 0x61, 0x00, 0x80, 0x00, 0x62, 0x00, 0xC0, 0x11, 0x53, 0x32, 0x52,
+    0x05, 0x11, 0x05, 0x11, 0x05, 0x12, 0x05, 0x12, 0x07, 0x21, 0x00, 0xA0, 0x02, 0x80, 0x0C, 0x00,
+    0x05, 0x10, 0x07, 0x20, 0x00, 0x01, 0x02, 0x80, 0x04, 0x00, 0x01, 0x00,
+};
+
+const llmp16_aot_image_t llmp16_aot_image = { "memcpy.bin", rom, 44, 5, blocks };
@@ -0,0 +1,234 @@
+/* Généré par llmp16_aot à partir de recurse.bin : ne pas modifier */
+#include "llmp16.h"
+#include "llmp16_aot.h"
+
+static uint32_t b_00000(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00000  MOVI R0, 0x0000 */
+        vm->R[0] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00004  MOVI R1, 0x0012 */
+        vm->R[1] = (uint16_t)(0x00012u);
+    }
+    {   /* 0x00008  CALL [0x00018] */
+        uint32_t sp = vm->R[SP] - 2;
+        if (llmp16_aot_slow(vm->wr_page, sp)) { vm->R[PC] = 0x00008; *count = 2; return 4; }
+        vm->R[SP] = sp;
+        mem_write16(vm, sp, 0x000C);
+        vm->R[PC] = 0x00018;
+        *count = 3;
+        return 9;
+    }
+}
+
+static uint32_t b_00004(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00004  MOVI R1, 0x0012 */
+        vm->R[1] = (uint16_t)(0x00012u);
+    }
+    {   /* 0x00008  CALL [0x00018] */
+        uint32_t sp = vm->R[SP] - 2;
+        if (llmp16_aot_slow(vm->wr_page, sp)) { vm->R[PC] = 0x00008; *count = 1; return 2; }
+        vm->R[SP] = sp;
+        mem_write16(vm, sp, 0x000C);
+        vm->R[PC] = 0x00018;
+        *count = 2;
+        return 7;
+    }
+}
+
+static uint32_t b_0000C(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0000C  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0000E  CMPI R0, 0x0040 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0x0040;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00012  JNEI [0x00004] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00004;
+            *count = 3;
+            return 6;
+        }
+        vm->R[PC] = 0x00016;
+        *count = 3;
+        return 5;
+    }
+}
+
+static uint32_t b_00016(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00016  HALT */
+        vm->R[PC] = 0x00016;
+        vm->cpu_halted = true;
+        *count = 1;
+        return 1;
+    }
+}
+
+static uint32_t b_00018(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00018  CMPI R1, 0x0002 */
+        uint16_t a = (uint16_t)vm->R[1], b = 0x0002;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x0001C  JCCI [0x0003C] */
+        if (llmp16_cond(vm, 0x4)) {
+            vm->R[PC] = 0x0003C;
+            *count = 2;
+            return 5;
+        }
+        vm->R[PC] = 0x00020;
+        *count = 2;
+        return 4;
+    }
+}
+
+static uint32_t b_00020(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00020  PUSH R1 */
+        uint32_t sp = vm->R[SP] - 2;
+        if (llmp16_aot_slow(vm->wr_page, sp)) { vm->R[PC] = 0x00020; *count = 0; return 0; }
+        vm->R[SP] = sp;
+        mem_write16(vm, sp, (uint16_t)vm->R[1]);
+    }
+    {   /* 0x00022  DEC R1 */
+        uint32_t r = vm->R[1] - 1;
+        vm->R[1] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00024  CALL [0x00018] */
+        uint32_t sp = vm->R[SP] - 2;
+        if (llmp16_aot_slow(vm->wr_page, sp)) { vm->R[PC] = 0x00024; *count = 2; return 4; }
+        vm->R[SP] = sp;
+        mem_write16(vm, sp, 0x0028);
+        vm->R[PC] = 0x00018;
+        *count = 3;
+        return 9;
+    }
+}
+
+static uint32_t b_00028(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00028  POP R1 */
+        if (llmp16_aot_slow(vm->rd_page, vm->R[SP])) { vm->R[PC] = 0x00028; *count = 0; return 0; }
+        vm->R[1] = (uint16_t)(mem_read16(vm, vm->R[SP]));
+        vm->R[SP] += 2;
+    }
+    {   /* 0x0002A  PUSH R2 */
+        uint32_t sp = vm->R[SP] - 2;
+        if (llmp16_aot_slow(vm->wr_page, sp)) { vm->R[PC] = 0x0002A; *count = 1; return 3; }
+        vm->R[SP] = sp;
+        mem_write16(vm, sp, (uint16_t)vm->R[2]);
+    }
+    {   /* 0x0002C  DEC R1 */
+        uint32_t r = vm->R[1] - 1;
+        vm->R[1] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0002E  DEC R1 */
+        uint32_t r = vm->R[1] - 1;
+        vm->R[1] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00030  CALL [0x00018] */
+        uint32_t sp = vm->R[SP] - 2;
+        if (llmp16_aot_slow(vm->wr_page, sp)) { vm->R[PC] = 0x00030; *count = 4; return 8; }
+        vm->R[SP] = sp;
+        mem_write16(vm, sp, 0x0034);
+        vm->R[PC] = 0x00018;
+        *count = 5;
+        return 13;
+    }
+}
+
+static uint32_t b_00034(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00034  POP R3 */
+        if (llmp16_aot_slow(vm->rd_page, vm->R[SP])) { vm->R[PC] = 0x00034; *count = 0; return 0; }
+        vm->R[3] = (uint16_t)(mem_read16(vm, vm->R[SP]));
+        vm->R[SP] += 2;
+    }
+    {   /* 0x00036  ADD R2, R3 */
+        uint16_t a = (uint16_t)vm->R[2], b = (uint16_t)vm->R[3];
+        uint32_t r = (uint32_t)a + b;
+        vm->R[15] = (uint16_t)r;
+        flag_nz(vm, (uint16_t)r);
+        flag_add_cv(vm, a, b, r);
+    }
+    {   /* 0x00038  MOV R2, ACC */
+        vm->R[2] = (uint16_t)(vm->R[15]);
+    }
+    {   /* 0x0003A  RET */
+        vm->R[PC] = 0x0003C;
+        if (llmp16_aot_slow(vm->rd_page, vm->R[SP])) { vm->R[PC] = 0x0003A; *count = 3; return 5; }
+        uint32_t sp = vm->R[SP];
+        vm->R[PC] = mem_read16(vm, sp);
+        vm->R[SP] = sp + 2;
+        *count = 4;
+        return 8 + (vm->R[PC] != 0x0003C ? LLMP_CYC_BRANCH_TAKEN : 0);
+    }
+}
+
+static uint32_t b_0003C(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0003C  MOV R2, R1 */
+        vm->R[2] = (uint16_t)(vm->R[1]);
+    }
+    {   /* 0x0003E  RET */
+        vm->R[PC] = 0x00040;
+        if (llmp16_aot_slow(vm->rd_page, vm->R[SP])) { vm->R[PC] = 0x0003E; *count = 1; return 1; }
+        uint32_t sp = vm->R[SP];
+        vm->R[PC] = mem_read16(vm, sp);
+        vm->R[SP] = sp + 2;
+        *count = 2;
+        return 4 + (vm->R[PC] != 0x00040 ? LLMP_CYC_BRANCH_TAKEN : 0);
+    }
+}
+
+static const llmp16_aot_block_t blocks[] = {
+    { 0x00000, 3, 4, b_00000 },
+    { 0x00004, 2, 2, b_00004 },
+    { 0x0000C, 3, 3, b_0000C },
+    { 0x00016, 1, 0, b_00016 },
+    { 0x00018, 2, 2, b_00018 },
+    { 0x00020, 3, 4, b_00020 },
+    { 0x00028, 5, 8, b_00028 },
+    { 0x00034, 4, 5, b_00034 },
+    { 0x0003C, 2, 1, b_0003C },
+};
+
+static const uint8_t rom[64] = {
+    0x00, 0x60, 0x00, 0x00, 0x00, 0x61, 0x12, 0x00, 0x0D, 0x80, 0x18, 0x00, 0x05, 0x10, 0x07, 0x20,
+    0x40, 0x00, 0x02, 0x80, 0x04, 0x00, 0x01, 0x00, 0x07, 0x21, 0x02, 0x00, 0x04, 0x80, 0x3C, 0x00,
+    0x03, 0x51, 0x06, 0x11, 0x0D, 0x80, 0x18, 0x00, 0x04, 0x51, 0x03, 0x52, 0x06, 0x11, 0x06, 0x11,
+    0x0D, 0x80, 0x18, 0x00, 0x04, 0x53, 0x30, 0x12, 0xF0, 0x52, 0x0D, 0x70, 0x10, 0x52, 0x0D, 0x70,
+};
+
+const llmp16_aot_image_t llmp16_aot_image = { "recurse.bin", rom, 64, 9, blocks };
@@ -0,0 +1,51 @@
+/* Généré par llmp16_aot à partir de poll.bin : ne pas modifier */
+#include "llmp16.h"
+#include "llmp16_aot.h"
+
+static uint32_t b_00000(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00000  IN R0, $F, 0 */
+        vm->R[0] = (uint16_t)(llmp16_io_read(vm, 15, 0));
+    }
+    {   /* 0x00002  CMPI R0, 0x0200 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0x0200;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00006  JLTI [0x00000] */
+        if (llmp16_cond(vm, 0x8)) {
+            vm->R[PC] = 0x00000;
+            *count = 3;
+            return 8;
+        }
+        vm->R[PC] = 0x0000A;
+        *count = 3;
+        return 7;
+    }
+}
+
+static uint32_t b_0000A(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0000A  HALT */
+        vm->R[PC] = 0x0000A;
+        vm->cpu_halted = true;
+        *count = 1;
+        return 1;
+    }
+}
+
+static const llmp16_aot_block_t blocks[] = {
+    { 0x00000, 3, 5, b_00000 },
+    { 0x0000A, 1, 0, b_0000A },
+};
+
+static const uint8_t rom[12] = {
+    0xF0, 0x90, 0x07, 0x20, 0x00, 0x02, 0x08, 0x80, 0x00, 0x00, 0x01, 0x00,
+};
+
+const llmp16_aot_image_t llmp16_aot_image = { "poll.bin", rom, 12, 2, blocks };
@@ -0,0 +1,235 @@
+/* Généré par llmp16_aot à partir de vcopy.bin : ne pas modifier */
+#include "llmp16.h"
+#include "llmp16_aot.h"
+
+static uint32_t b_00000(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00000  MOVI R1, 0x0000 */
+        vm->R[1] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00004  MOVI R8, 0x8000 */
+        vm->R[8] = 0x08000u;
+    }
+    {   /* 0x00008  MOVI R9, 0xA0000 */
+        vm->R[9] = 0xA0000u;
+    }
+    {   /* 0x0000C  MOVI R0, 0x7D00 */
+        vm->R[0] = (uint16_t)(0x07D00u);
+    }
+    {   /* 0x00010  LD R3, R8 */
+        uint32_t a = vm->R[8];
+        if (llmp16_aot_slow(vm->rd_page, a)) { vm->R[PC] = 0x00010; *count = 4; return 8; }
+        vm->R[3] = (uint16_t)(mem_read16(vm, a));
+    }
+    {   /* 0x00012  STR R9, R3 */
+        uint32_t a = vm->R[9];
+        if (llmp16_aot_slow(vm->wr_page, a)) { vm->R[PC] = 0x00012; *count = 5; return 11; }
+        mem_write16(vm, a, (uint16_t)vm->R[3]);
+    }
+    {   /* 0x00014  INC R8 */
+        uint32_t r = vm->R[8] + 1;
+        vm->R[8] = r;
+        flag_nz32(vm, r);
+    }
+    {   /* 0x00016  INC R8 */
+        uint32_t r = vm->R[8] + 1;
+        vm->R[8] = r;
+        flag_nz32(vm, r);
+    }
+    {   /* 0x00018  INC R9 */
+        uint32_t r = vm->R[9] + 1;
+        vm->R[9] = r;
+        flag_nz32(vm, r);
+    }
+    {   /* 0x0001A  INC R9 */
+        uint32_t r = vm->R[9] + 1;
+        vm->R[9] = r;
+        flag_nz32(vm, r);
+    }
+    {   /* 0x0001C  DEC R0 */
+        uint32_t r = vm->R[0] - 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0001E  JNEI [0x00010] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00010;
+            *count = 12;
+            return 22;
+        }
+        vm->R[PC] = 0x00022;
+        *count = 12;
+        return 21;
+    }
+}
+
+static uint32_t b_00004(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00004  MOVI R8, 0x8000 */
+        vm->R[8] = 0x08000u;
+    }
+    {   /* 0x00008  MOVI R9, 0xA0000 */
+        vm->R[9] = 0xA0000u;
+    }
+    {   /* 0x0000C  MOVI R0, 0x7D00 */
+        vm->R[0] = (uint16_t)(0x07D00u);
+    }
+    {   /* 0x00010  LD R3, R8 */
+        uint32_t a = vm->R[8];
+        if (llmp16_aot_slow(vm->rd_page, a)) { vm->R[PC] = 0x00010; *count = 3; return 6; }
+        vm->R[3] = (uint16_t)(mem_read16(vm, a));
+    }
+    {   /* 0x00012  STR R9, R3 */
+        uint32_t a = vm->R[9];
+        if (llmp16_aot_slow(vm->wr_page, a)) { vm->R[PC] = 0x00012; *count = 4; return 9; }
+        mem_write16(vm, a, (uint16_t)vm->R[3]);
+    }
+    {   /* 0x00014  INC R8 */
+        uint32_t r = vm->R[8] + 1;
+        vm->R[8] = r;
+        flag_nz32(vm, r);
+    }
+    {   /* 0x00016  INC R8 */
+        uint32_t r = vm->R[8] + 1;
+        vm->R[8] = r;
+        flag_nz32(vm, r);
+    }
+    {   /* 0x00018  INC R9 */
+        uint32_t r = vm->R[9] + 1;
+        vm->R[9] = r;
+        flag_nz32(vm, r);
+    }
+    {   /* 0x0001A  INC R9 */
+        uint32_t r = vm->R[9] + 1;
+        vm->R[9] = r;
+        flag_nz32(vm, r);
+    }
+    {   /* 0x0001C  DEC R0 */
+        uint32_t r = vm->R[0] - 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0001E  JNEI [0x00010] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00010;
+            *count = 11;
+            return 20;
+        }
+        vm->R[PC] = 0x00022;
+        *count = 11;
+        return 19;
+    }
+}
+
+static uint32_t b_00010(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    uint32_t n = 0, cycles = 0;
+top:
+    {   /* 0x00010  LD R3, R8 */
+        uint32_t a = vm->R[8];
+        if (llmp16_aot_slow(vm->rd_page, a)) { vm->R[PC] = 0x00010; *count = n + 0; return cycles + 0; }
+        vm->R[3] = (uint16_t)(mem_read16(vm, a));
+    }
+    {   /* 0x00012  STR R9, R3 */
+        uint32_t a = vm->R[9];
+        if (llmp16_aot_slow(vm->wr_page, a)) { vm->R[PC] = 0x00012; *count = n + 1; return cycles + 3; }
+        mem_write16(vm, a, (uint16_t)vm->R[3]);
+    }
+    {   /* 0x00014  INC R8 */
+        uint32_t r = vm->R[8] + 1;
+        vm->R[8] = r;
+        flag_nz32(vm, r);
+    }
+    {   /* 0x00016  INC R8 */
+        uint32_t r = vm->R[8] + 1;
+        vm->R[8] = r;
+        flag_nz32(vm, r);
+    }
+    {   /* 0x00018  INC R9 */
+        uint32_t r = vm->R[9] + 1;
+        vm->R[9] = r;
+        flag_nz32(vm, r);
+    }
+    {   /* 0x0001A  INC R9 */
+        uint32_t r = vm->R[9] + 1;
+        vm->R[9] = r;
+        flag_nz32(vm, r);
+    }
+    {   /* 0x0001C  DEC R0 */
+        uint32_t r = vm->R[0] - 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0001E  JNEI [0x00010] */
+        if (llmp16_cond(vm, 0x2)) {
+            n += 8;
+            cycles += 14;
+            if (n + 8 <= max_instr && (uint64_t)cycles + 11 <= slack) goto top;
+            vm->R[PC] = 0x00010;
+            *count = n;
+            return cycles;
+        }
+        vm->R[PC] = 0x00022;
+        *count = n + 8;
+        return cycles + 13;
+    }
+}
+
+static uint32_t b_00022(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00022  INC R1 */
+        uint32_t r = vm->R[1] + 1;
+        vm->R[1] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00024  CMPI R1, 0x001E */
+        uint16_t a = (uint16_t)vm->R[1], b = 0x001E;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00028  JNEI [0x00004] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00004;
+            *count = 3;
+            return 6;
+        }
+        vm->R[PC] = 0x0002C;
+        *count = 3;
+        return 5;
+    }
+}
+
+static uint32_t b_0002C(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0002C  HALT */
+        vm->R[PC] = 0x0002C;
+        vm->cpu_halted = true;
+        *count = 1;
+        return 1;
+    }
+}
+
+static const llmp16_aot_block_t blocks[] = {
+    { 0x00000, 12, 19, b_00000 },
+    { 0x00004, 11, 17, b_00004 },
+    { 0x00010, 8, 11, b_00010 },
+    { 0x00022, 3, 3, b_00022 },
+    { 0x0002C, 1, 0, b_0002C },
+};
+
+static const uint8_t rom[46] = {
+    0x00, 0x61, 0x00, 0x00, 0x00, 0x68, 0x00, 0x80, 0xA0, 0x69, 0x00, 0x00, 0x00, 0x60, 0x00, 0x7D,
+    0x81, 0x53, 0x32, 0x59, 0x05, 0x18, 0x05, 0x18, 0x05, 0x19, 0x05, 0x19, 0x06, 0x10, 0x02, 0x80,
+    0x10, 0x00, 0x05, 0x11, 0x07, 0x21, 0x1E, 0x00, 0x02, 0x80, 0x04, 0x00, 0x01, 0x00,
+};
+
+const llmp16_aot_image_t llmp16_aot_image = { "vcopy.bin", rom, 46, 5, blocks };
@@ -0,0 +1,159 @@
+/* Généré par llmp16_aot à partir de vfill.bin : ne pas modifier */
+#include "llmp16.h"
+#include "llmp16_aot.h"
+
+static uint32_t b_00000(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00000  MOVI R7, 0x0000 */
+        vm->R[7] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00004  MOVI R0, 0x0000 */
+        vm->R[0] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00008  VSTR R0, R7 */
+        vram_write(vm, (uint16_t)vm->R[0], (uint8_t)vm->R[7]);
+    }
+    {   /* 0x0000A  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0000C  CMPI R0, 0xFA00 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0xFA00;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00010  JNEI [0x00008] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00008;
+            *count = 6;
+            return 12;
+        }
+        vm->R[PC] = 0x00014;
+        *count = 6;
+        return 11;
+    }
+}
+
+static uint32_t b_00004(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00004  MOVI R0, 0x0000 */
+        vm->R[0] = (uint16_t)(0x00000u);
+    }
+    {   /* 0x00008  VSTR R0, R7 */
+        vram_write(vm, (uint16_t)vm->R[0], (uint8_t)vm->R[7]);
+    }
+    {   /* 0x0000A  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0000C  CMPI R0, 0xFA00 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0xFA00;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00010  JNEI [0x00008] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00008;
+            *count = 5;
+            return 10;
+        }
+        vm->R[PC] = 0x00014;
+        *count = 5;
+        return 9;
+    }
+}
+
+static uint32_t b_00008(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    uint32_t n = 0, cycles = 0;
+top:
+    {   /* 0x00008  VSTR R0, R7 */
+        vram_write(vm, (uint16_t)vm->R[0], (uint8_t)vm->R[7]);
+    }
+    {   /* 0x0000A  INC R0 */
+        uint32_t r = vm->R[0] + 1;
+        vm->R[0] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x0000C  CMPI R0, 0xFA00 */
+        uint16_t a = (uint16_t)vm->R[0], b = 0xFA00;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x00010  JNEI [0x00008] */
+        if (llmp16_cond(vm, 0x2)) {
+            n += 4;
+            cycles += 8;
+            if (n + 4 <= max_instr && (uint64_t)cycles + 5 <= slack) goto top;
+            vm->R[PC] = 0x00008;
+            *count = n;
+            return cycles;
+        }
+        vm->R[PC] = 0x00014;
+        *count = n + 4;
+        return cycles + 7;
+    }
+}
+
+static uint32_t b_00014(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x00014  INC R7 */
+        uint32_t r = vm->R[7] + 1;
+        vm->R[7] = (uint16_t)(r);
+        flag_nz(vm, (uint16_t)r);
+    }
+    {   /* 0x00016  CMPI R7, 0x001E */
+        uint16_t a = (uint16_t)vm->R[7], b = 0x001E;
+        uint32_t r = (uint32_t)a - b + 0x10000;
+        flag_nz(vm, (uint16_t)r);
+        flag_sub_cv(vm, a, b, r);
+    }
+    {   /* 0x0001A  JNEI [0x00004] */
+        if (llmp16_cond(vm, 0x2)) {
+            vm->R[PC] = 0x00004;
+            *count = 3;
+            return 6;
+        }
+        vm->R[PC] = 0x0001E;
+        *count = 3;
+        return 5;
+    }
+}
+
+static uint32_t b_0001E(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    (void)max_instr;
+    (void)slack;
+    {   /* 0x0001E  HALT */
+        vm->R[PC] = 0x0001E;
+        vm->cpu_halted = true;
+        *count = 1;
+        return 1;
+    }
+}
+
+static const llmp16_aot_block_t blocks[] = {
+    { 0x00000, 6, 9, b_00000 },
+    { 0x00004, 5, 7, b_00004 },
+    { 0x00008, 4, 5, b_00008 },
+    { 0x00014, 3, 3, b_00014 },
+    { 0x0001E, 1, 0, b_0001E },
+};
+
+static const uint8_t rom[32] = {
+    0x00, 0x67, 0x00, 0x00, 0x00, 0x60, 0x00, 0x00, 0x76, 0x50, 0x05, 0x10, 0x07, 0x20, 0x00, 0xFA,
+    0x02, 0x80, 0x08, 0x00, 0x05, 0x17, 0x07, 0x27, 0x1E, 0x00, 0x02, 0x80, 0x04, 0x00, 0x01, 0x00,
+};
+
+const llmp16_aot_image_t llmp16_aot_image = { "vfill.bin", rom, 32, 5, blocks };
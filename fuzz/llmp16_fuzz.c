@@ -0,0 +1,836 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "llmp16.h"
+
+/*
+ * Fuzzing différentiel du coeur LLMP16
+ * ------------------------------------
+ * Chaque entrée est exécutée à la fois par un interpréteur de référence, écrit ici directement
+ * d'après le jeu d'instructions du README sans rien partager avec llmp16_decoder.c, et par le
+ * coeur de l'émulateur, une entrée sur deux instruction par instruction (llmp16_cpu_cycle) et
+ * l'autre par superinstructions (llmp16_cpu_group). Après chaque pas les registres, les flags,
+ * le HALT et le compteur de cycles sont comparés ; en fin d'entrée, la mémoire, la VRAM, les
+ * registres IO, les défauts et les compteurs. Au premier écart, l'état des deux machines est
+ * affiché et le harnais s'arrête par abort() : libFuzzer et AFL enregistrent l'entrée.
+ *
+ * Entrée : R0-R7 (16 octets, little-endian), FLAGS (1 octet), puis le programme chargé en ROM
+ * à l'adresse 0. L'exécution s'arrête au HALT, après LLMP_FUZZ_STEPS instructions, ou quand PC
+ * arrive dans de la mémoire vierge (ROM après le programme, page de RAM jamais écrite) où il
+ * n'y a plus que des NOP.
+ *
+ * Débit : rien n'est réalloué ni effacé en entier entre deux entrées. La référence note les
+ * pages qu'elle écrit ; côté coeur, les pages de RAM portent le bit LLMP_PROT_COW, que la
+ * première écriture retire (chemin lent de llmp16_memory.c). Seules ces pages sont comparées
+ * puis remises à zéro. Une comparaison complète de la mémoire et de la VRAM est faite toutes
+ * les LLMP_FUZZ_FULL_CHECK entrées pour attraper une écriture perdue dans la VRAM.
+ * Les entrées aléatoires chargent IDX avec une petite longueur avant chaque instruction de
+ * bloc (LLMP_FUZZ_BLK_LEN) : sans cela MCPY, MFIL et VFIL écrivaient des milliers d'octets par
+ * entrée et le débit plafonnait vers 15 000 entrées/s. Mesuré avec make fuzz (200 000 entrées,
+ * 244,3 instructions par entrée en moyenne) : 57 000 à 81 000 entrées/s sur un seul coeur, soit
+ * environ 14 à 20 millions d'instructions comparées par seconde. Le temps est alors réparti sur
+ * le décodage et l'exécution des deux interpréteurs ; la comparaison des registres après chaque
+ * pas en prend quelques pour cent et est gardée pour situer un écart à l'instruction près.
+ *
+ * Le coeur est exécuté seul, sans llmp16_step() : le blitter, le DMA et les timers ne
+ * démarrent pas, et la fenêtre MMIO n'est pas installée (RAM et ROM seulement).
+ *
+ * Construction :
+ *   make fuzz                        aléatoire intégré (gcc), FUZZ_RUNS entrées
+ *   make libfuzzer                   build/llmp16_libfuzzer (clang -fsanitize=fuzzer)
+ *   make fuzz CC=afl-clang-fast      AFL, mode persistant sur stdin
+ *
+ * Usage : llmp16_fuzz [-n <entrées>] [-S <graine>] [-s <instructions max>] [entrée ...]
+ *   sans fichier ni -n, une entrée est lue sur stdin (AFL)
+ */
+
+#define LLMP_FUZZ_STEPS       1024
+#define LLMP_FUZZ_HEADER      17
+#define LLMP_FUZZ_FULL_CHECK  4096
+#define LLMP_FUZZ_MAX_LEN     512           /* entrées aléatoires (-n) */
+#define LLMP_FUZZ_BLK_LEN     64            /* octets par instruction de bloc, sauf 1 sur LLMP_FUZZ_BLK_LONG */
+#define LLMP_FUZZ_BLK_LONG    64
+
+/*============================== Interpréteur de référence ==============================*/
+
+typedef struct {
+    uint32_t r[16];                         /* R0-R7 tenus sur 16 bits, R8-R15 sur 32 */
+    uint8_t  flags;
+    bool     halted;
+    uint8_t *mem;
+    uint8_t *vram;
+    uint16_t io[LLMP_IO_PORTS][LLMP_IO_REGS];
+    llmp16_stats_t stats;
+    llmp16_fault_t fault;
+    uint8_t  dirty[LLMP_PAGES];             /* pages écrites depuis la dernière remise à zéro */
+    uint8_t  vdirty[LLMP_VRAM_PAGES];
+} ref_t;
+
+static uint32_t ref_get(const ref_t *m, unsigned x)
+{
+    return m->r[x & 0xF];
+}
+
+static void ref_set(ref_t *m, unsigned x, uint32_t v)
+{
+    x &= 0xF;
+    m->r[x] = x < 8 ? (v & 0xFFFF) : v;
+}
+
+static void ref_fault(ref_t *m, uint8_t kind, uint32_t addr)
+{
+    // l'octet haut d'un accès 16 bits en ROM est le même défaut
+    if (!(m->fault.kind == kind && m->fault.pc == m->r[PC] && addr == ((m->fault.addr + 1) & LLMP_ADDR_MASK)))
+        m->stats.mem_faults++;
+    m->fault.kind = kind;
+    m->fault.addr = addr;
+    m->fault.pc = m->r[PC];
+}
+
+static uint8_t ref_rd8(ref_t *m, uint32_t addr)
+{
+    return m->mem[addr & LLMP_ADDR_MASK];
+}
+
+static void ref_wr8(ref_t *m, uint32_t addr, uint8_t v)
+{
+    addr &= LLMP_ADDR_MASK;
+    if (addr < LLMP_ROM_SIZE) {
+        ref_fault(m, LLMP_FAULT_ROM_WRITE, addr);
+        return;
+    }
+    m->mem[addr] = v;
+    m->dirty[addr >> LLMP_PAGE_SHIFT] = 1;
+}
+
+static uint16_t ref_rd16(ref_t *m, uint32_t addr)
+{
+    return (uint16_t)(ref_rd8(m, addr) | ref_rd8(m, addr + 1) << 8);
+}
+
+static void ref_wr16(ref_t *m, uint32_t addr, uint16_t v)
+{
+    ref_wr8(m, addr, (uint8_t)v);
+    ref_wr8(m, addr + 1, (uint8_t)(v >> 8));
+}
+
+static void ref_vwr(ref_t *m, uint16_t addr, uint8_t v)
+{
+    m->vram[addr] = v;
+    m->vdirty[addr >> LLMP_PAGE_SHIFT] = 1;
+    m->stats.vram_writes++;
+}
+
+/* MEM[--SP] <- RX et RX <- MEM[SP++] : PUSH SP empile SP déjà décrémenté, POP SP incrémente
+   la valeur chargée */
+static void ref_push(ref_t *m, unsigned x)
+{
+    m->r[SP] -= 2;
+    ref_wr16(m, m->r[SP], (uint16_t)ref_get(m, x));
+}
+
+static void ref_pop(ref_t *m, unsigned x)
+{
+    ref_set(m, x, ref_rd16(m, m->r[SP]));
+    m->r[SP] += 2;
+}
+
+/* N Z d'un résultat 16 bits */
+static void ref_nz(ref_t *m, uint32_t res)
+{
+    m->flags &= ~(FLAG_N | FLAG_Z);
+    if ((res & 0xFFFF) == 0) m->flags |= FLAG_Z;
+    if (res & 0x8000) m->flags |= FLAG_N;
+}
+
+static void ref_cv(ref_t *m, bool c, bool v)
+{
+    m->flags &= ~(FLAG_C | FLAG_V);
+    if (c) m->flags |= FLAG_C;
+    if (v) m->flags |= FLAG_V;
+}
+
+/* a + b, ou a - b si sub : C = retenue (addition) ou absence d'emprunt (soustraction),
+   V = débordement signé calculé sur les valeurs signées */
+static uint16_t ref_addsub(ref_t *m, uint16_t a, uint16_t b, bool sub)
+{
+    int32_t s = sub ? (int16_t)a - (int16_t)b : (int16_t)a + (int16_t)b;
+    uint16_t res = (uint16_t)(sub ? a - b : a + b);
+    ref_nz(m, res);
+    ref_cv(m, sub ? a >= b : a + b > 0xFFFF, s < -32768 || s > 32767);
+    return res;
+}
+
+/* Condition de saut t (0x0 à 0xC), d'après la table du README */
+static bool ref_cond(const ref_t *m, unsigned t)
+{
+    bool n = m->flags & FLAG_N, z = m->flags & FLAG_Z, c = m->flags & FLAG_C, v = m->flags & FLAG_V;
+    switch (t) {
+    case 0x0: return true;
+    case 0x1: return z;
+    case 0x2: return !z;
+    case 0x3: return c;
+    case 0x4: return !c;
+    case 0x5: return v;
+    case 0x6: return !v;
+    case 0x7: return n == v && !z;
+    case 0x8: return n != v;
+    case 0x9: return n == v;
+    case 0xA: return n != v || z;
+    case 0xB: return !c && !z;
+    case 0xC: return c || z;
+    default:  return false;
+    }
+}
+
+static uint16_t ref_in(ref_t *m, unsigned port, unsigned reg)
+{
+    m->stats.io_reads++;
+    if (port == LLMP_STATS_PORT && reg == LLMP_STATS_REG_CYCLES) {
+        for (int i = 0; i < 4; i++) {
+            m->io[port][LLMP_STATS_REG_CYCLES + i] = (uint16_t)(m->stats.cycles >> (16 * i));
+            m->io[port][LLMP_STATS_REG_INSTR + i] = (uint16_t)(m->stats.instructions >> (16 * i));
+        }
+        m->io[port][LLMP_STATS_REG_FRAMES] = (uint16_t)m->stats.frames;
+        m->io[port][LLMP_STATS_REG_FRAMES + 1] = (uint16_t)(m->stats.frames >> 16);
+    }
+    uint16_t v = m->io[port][reg];
+    if (port == 1) m->io[1][0] = 0;         // donnée clavier consommée
+    return v;
+}
+
+/* Exécute une instruction et retourne son coût en cycles (modèle de timing de llmp16.h) */
+static uint32_t ref_step(ref_t *m)
+{
+    uint32_t pc = m->r[PC];
+    uint16_t w = ref_rd16(m, pc);
+    unsigned cls = w >> 12, x = (w >> 8) & 0xF, y = (w >> 4) & 0xF, t = w & 0xF;
+    bool two = cls == 0x2 || cls == 0x4 || cls == 0x8 || cls == 0xD || (cls == 0x6 && t <= 6 && t != 4);
+    uint16_t ext = two ? ref_rd16(m, pc + 2) : 0;
+    uint32_t addr = ((uint32_t)y << 16) | ext;
+    uint32_t cyc = two ? 2 : 1;             // un cycle par mot lu
+    m->r[PC] = pc + (two ? 4 : 2);
+
+    switch (cls) {
+    case 0x0:
+        if (w == 0x0001) {                  /* HALT : PC reste sur l'instruction */
+            m->r[PC] = pc;
+            m->halted = true;
+        } else if (w == 0x0003 || w == 0x0004) {
+            cyc = 4;                        /* INT, IRET */
+        }
+        break;
+
+    case 0x1:
+    case 0x2: {
+        uint16_t a = (uint16_t)ref_get(m, x);
+        uint16_t b = cls == 0x1 ? (uint16_t)ref_get(m, y) : ext;
+        switch (t) {
+        case 0x0: ref_set(m, ACC, ref_addsub(m, a, b, false)); break;
+        case 0x1: ref_set(m, ACC, ref_addsub(m, a, b, true)); break;
+        case 0x2:
+            ref_set(m, ACC, (uint16_t)((uint32_t)a * b));
+            ref_nz(m, (uint16_t)((uint32_t)a * b));
+            if (cls == 0x1) ref_cv(m, false, false);
+            cyc += 3;
+            break;
+        case 0x3:
+            if (b != 0) {
+                ref_set(m, ACC, a / b);
+                ref_nz(m, a / b);
+            }
+            cyc += 17;
+            break;
+        case 0x4:                           /* SDIV, tronquée vers zéro */
+            if (b != 0) {
+                uint16_t q = (uint16_t)((int32_t)(int16_t)a / (int16_t)b);
+                ref_set(m, ACC, q);
+                ref_nz(m, q);
+            }
+            cyc += 17;
+            break;
+        case 0x5:
+        case 0x6:
+            if (cls == 0x1) {               /* INC, DEC : valeur et N Z sur toute la largeur du registre */
+                ref_set(m, x, ref_get(m, x) + (t == 0x5 ? 1 : -1));
+                uint32_t res = ref_get(m, x);
+                m->flags &= ~(FLAG_N | FLAG_Z);
+                if (x < 8 ? (res & 0xFFFF) == 0 : res == 0) m->flags |= FLAG_Z;
+                if (x < 8 ? (res & 0x8000) != 0 : (res >> 31) != 0) m->flags |= FLAG_N;
+            }
+            break;
+        case 0x7: ref_addsub(m, a, b, true); break;
+        case 0x8:
+        case 0x9:
+        case 0xA: {
+            unsigned s = b & 0xF;
+            uint32_t res = t == 0x8 ? (uint32_t)a >> s
+                         : t == 0x9 ? (uint32_t)(((int32_t)(int16_t)a) >> s) & 0xFFFF
+                         : ((uint32_t)a << s) & 0xFFFF;
+            ref_set(m, x, res);
+            ref_nz(m, res);
+            if (cls == 0x1) {               // C = dernier bit sorti, 0 sans décalage
+                bool c = s != 0 && (t == 0xA ? (a >> (16 - s)) & 1 : (a >> (s - 1)) & 1);
+                m->flags = (uint8_t)((m->flags & ~FLAG_C) | (c ? FLAG_C : 0));
+            }
+            break;
+        }
+        case 0xB:                           /* MULH */
+            if (cls == 0x1) {
+                uint16_t h = (uint16_t)(((uint32_t)a * b) >> 16);
+                ref_set(m, ACC, h);
+                ref_nz(m, h);
+                ref_cv(m, false, false);
+                cyc += 3;
+            }
+            break;
+        default: break;
+        }
+        break;
+    }
+
+    case 0xC:
+    case 0xD: {                             /* ALU 32 bits, R0-R7 étendus par des zéros */
+        uint32_t a = ref_get(m, x);
+        uint32_t b = cls == 0xC ? ref_get(m, y) : addr;
+        uint32_t res = 0;
+        bool acc = true, cv = false;        /* résultat dans ACC ; C V effacés (MULL, MULHL) */
+        if (t == 0x5 || t == 0x6 || t == 0xF || (cls == 0xD && t == 0xB)) break;
+        cyc += 1;
+        switch (t) {
+        case 0x0:
+            res = a + b;
+            ref_cv(m, res < a, ((a ^ res) & (b ^ res)) >> 31);
+            break;
+        case 0x1:
+        case 0x7:
+            res = a - b;
+            ref_cv(m, a >= b, ((a ^ b) & (a ^ res)) >> 31);
+            acc = t == 0x1;
+            break;
+        case 0x2: res = a * b; cv = true; cyc += 8; break;
+        case 0xB: res = (uint32_t)(((uint64_t)a * b) >> 32); cv = true; cyc += 12; break;
+        case 0x3:
+        case 0x4:
+            cyc += 32;
+            if (b == 0) goto alu32_done;
+            if (t == 0x3) res = a / b;
+            else res = (uint32_t)((int64_t)(int32_t)a / (int32_t)b);
+            break;
+        case 0x8:
+        case 0x9:
+        case 0xA: {
+            unsigned s = b & 0x1F;
+            uint64_t wide = t == 0xA ? (uint64_t)a << s
+                          : t == 0x9 ? (uint64_t)((int64_t)(int32_t)a >> s)
+                          : (uint64_t)a >> s;
+            res = (uint32_t)wide;
+            if (cls == 0xC) {               // C = dernier bit sorti, 0 sans décalage
+                bool c = s != 0 && (t == 0xA ? (wide >> 32) & 1 : (a >> (s - 1)) & 1);
+                m->flags = (uint8_t)((m->flags & ~FLAG_C) | (c ? FLAG_C : 0));
+            }
+            ref_set(m, x, res);
+            acc = false;
+            break;
+        }
+        case 0xC: res = a & b; break;
+        case 0xD: res = a | b; break;
+        case 0xE: res = a ^ b; break;
+        default: goto alu32_done;
+        }
+        if (acc) ref_set(m, ACC, res);
+        if (cv) ref_cv(m, false, false);
+        m->flags &= ~(FLAG_N | FLAG_Z);
+        if (res == 0) m->flags |= FLAG_Z;
+        if (res >> 31) m->flags |= FLAG_N;
+    alu32_done:
+        break;
+    }
+
+    case 0x3:
+    case 0x4: {
+        uint16_t a = (uint16_t)ref_get(m, x);
+        uint16_t b = cls == 0x3 ? (uint16_t)ref_get(m, y) : ext;
+        switch (t) {
+        case 0x0: ref_set(m, ACC, a & b); ref_nz(m, a & b); break;
+        case 0x1: ref_set(m, ACC, a | b); ref_nz(m, a | b); break;
+        case 0x2: ref_set(m, ACC, a ^ b); ref_nz(m, a ^ b); break;
+        case 0x3:
+            if (cls == 0x3) { ref_set(m, ACC, (uint16_t)~a); ref_nz(m, (uint16_t)~a); }
+            else ref_nz(m, a & b);          /* TSTI */
+            break;
+        case 0x4: if (cls == 0x3) ref_nz(m, a & b); break;
+        default: break;
+        }
+        break;
+    }
+
+    case 0x5:
+        switch (t) {
+        case 0x0: ref_set(m, x, ref_get(m, y)); break;
+        case 0x1: ref_set(m, x, ref_rd16(m, ref_get(m, y))); cyc += 2; break;
+        case 0x2: ref_wr16(m, ref_get(m, x), (uint16_t)ref_get(m, y)); cyc += 2; break;
+        case 0x3: ref_push(m, x); cyc += 2; break;
+        case 0x4: ref_pop(m, x); cyc += 2; break;
+        case 0x5: ref_set(m, x, m->vram[(uint16_t)ref_get(m, y)]); cyc += 1; break;
+        case 0x6: ref_vwr(m, (uint16_t)ref_get(m, x), (uint8_t)ref_get(m, y)); cyc += 1; break;
+        case 0x7: {                         /* VLDW */
+            uint16_t a = (uint16_t)ref_get(m, y);
+            ref_set(m, x, m->vram[a] | m->vram[(uint16_t)(a + 1)] << 8);
+            cyc += 2;
+            break;
+        }
+        case 0x8: {                         /* VSTRW */
+            uint16_t a = (uint16_t)ref_get(m, x), v = (uint16_t)ref_get(m, y);
+            ref_vwr(m, a, (uint8_t)v);
+            ref_vwr(m, (uint16_t)(a + 1), (uint8_t)(v >> 8));
+            cyc += 2;
+            break;
+        }
+        default: break;
+        }
+        break;
+
+    case 0x6:
+        switch (t) {
+        case 0x0: ref_set(m, x, addr); break;
+        case 0x1: ref_set(m, x, ref_rd16(m, addr)); cyc += 2; break;
+        case 0x2: ref_wr16(m, addr, (uint16_t)ref_get(m, x)); cyc += 2; break;
+        case 0x3:
+            m->r[SP] -= 2;
+            ref_wr16(m, m->r[SP], ext);
+            cyc += 2;
+            break;
+        case 0x5: ref_set(m, x, m->vram[ext]); cyc += 1; break;
+        case 0x6: ref_vwr(m, ext, (uint8_t)ref_get(m, x)); cyc += 1; break;
+        default: break;
+        }
+        break;
+
+    case 0x7:
+        if (t == 0xD) {                     /* RET */
+            ref_pop(m, PC);
+            cyc += 2;
+        } else if (ref_cond(m, t)) {
+            m->r[PC] = ref_get(m, x);
+        }
+        break;
+
+    case 0x8:
+        if (t == 0xD) {                     /* CALL : l'adresse de retour est poussée sur 16 bits */
+            ref_push(m, PC);
+            m->r[PC] = addr;
+            cyc += 2;
+        } else if (ref_cond(m, t)) {
+            m->r[PC] = addr;
+        }
+        break;
+
+    case 0x9:
+        ref_set(m, x, ref_in(m, y, t));
+        cyc += 2;
+        break;
+
+    case 0xA:
+        m->stats.io_writes++;
+        if (y != LLMP_STATS_PORT) m->io[y][t] = (uint16_t)ref_get(m, x);
+        cyc += 2;
+        break;
+
+    case 0xB: {                             /* blocs : IDX octets (64 Ko au plus), octet par octet */
+        uint32_t idx = m->r[IDX], n = idx < LLMP_BLK_MAX ? idx : LLMP_BLK_MAX;
+        uint32_t a = ref_get(m, x), b = ref_get(m, y), done = n;
+        uint32_t delta = (a - b) & LLMP_ADDR_MASK;
+        switch (t) {
+        case 0x0:                           /* MCPY, par le haut si la destination recouvre la source */
+            if (delta != 0 && delta < n)
+                for (uint32_t i = n; i-- > 0;) ref_wr8(m, a + i, ref_rd8(m, b + i));
+            else
+                for (uint32_t i = 0; i < n; i++) ref_wr8(m, a + i, ref_rd8(m, b + i));
+            ref_set(m, x, a + n);
+            ref_set(m, y, b + n);
+            cyc += 1 + 2 * n;
+            break;
+        case 0x1:                           /* MFIL */
+            for (uint32_t i = 0; i < n; i++) ref_wr8(m, a + i, (uint8_t)b);
+            ref_set(m, x, a + n);
+            cyc += 1 + n;
+            break;
+        case 0x2:                           /* VFIL */
+            for (uint32_t i = 0; i < n; i++) ref_vwr(m, (uint16_t)(a + i), (uint8_t)b);
+            ref_set(m, x, a + n);
+            cyc += 1 + n;
+            break;
+        case 0x3: {                         /* MCMP : arrêt sur la première paire différente */
+            uint8_t va = 0, vb = 0;
+            for (done = 0; done < n; done++) {
+                va = ref_rd8(m, a + done);
+                vb = ref_rd8(m, b + done);
+                if (va != vb) break;
+            }
+            ref_addsub(m, va, vb, true);
+            ref_set(m, x, a + done);
+            ref_set(m, y, b + done);
+            cyc += 1 + 2 * (done < n ? done + 1 : done);
+            break;
+        }
+        default:
+            done = 0;
+            break;
+        }
+        ref_set(m, IDX, idx - done);
+        break;
+    }
+
+    case 0xE: {                             /* deux octets, chacun saturé ou arrondi à part */
+        uint16_t a = (uint16_t)ref_get(m, x), b = (uint16_t)ref_get(m, y), acc = (uint16_t)ref_get(m, ACC);
+        uint16_t res = 0;
+        if (t > 0x5) break;
+        for (int i = 0; i < 2; i++) {
+            int u = (a >> 8 * i) & 0xFF, v = (b >> 8 * i) & 0xFF, r;
+            switch (t) {
+            case 0x0: r = u + v < 255 ? u + v : 255; break;
+            case 0x1: r = u - v > 0 ? u - v : 0; break;
+            case 0x2: r = (u + v + 1) / 2; break;
+            case 0x3: r = u < v ? u : v; break;
+            case 0x4: r = u < v ? v : u; break;
+            default: {                      /* PSHUF : sélecteur de 2 bits par octet dans y */
+                unsigned sel = (y >> 2 * i) & 3;
+                uint16_t src = sel < 2 ? a : acc;
+                r = (src >> 8 * (sel & 1)) & 0xFF;
+                break;
+            }
+            }
+            res |= (uint16_t)(r << 8 * i);
+        }
+        ref_set(m, ACC, res);
+        ref_nz(m, res);
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    // un saut pris vide le prefetch
+    if ((cls == 0x7 || cls == 0x8) && m->r[PC] != pc + (two ? 4u : 2u))
+        cyc += LLMP_CYC_BRANCH_TAKEN;
+    m->stats.instructions++;
+    m->stats.cycles += cyc;
+    return cyc;
+}
+
+
+/*============================== Harnais ==============================*/
+
+typedef struct {
+    llmp16_t *vm;
+    ref_t ref;
+    size_t prog_len;                        /* octets de ROM chargés par l'entrée précédente */
+    uint64_t execs;
+    uint64_t steps;
+    uint32_t max_steps;
+} fuzz_t;
+
+static fuzz_t fz;
+
+static void fuzz_init(uint32_t max_steps)
+{
+    fz.vm = (llmp16_t *)malloc(sizeof(llmp16_t));
+    llmp16_init(fz.vm);
+    fz.ref.mem = (uint8_t *)calloc(LLMP_MEM_SIZE, 1);
+    fz.ref.vram = (uint8_t *)calloc(LLMP_VRAM_SIZE, 1);
+    if (fz.ref.mem == NULL || fz.ref.vram == NULL) abort();
+    fz.max_steps = max_steps;
+
+    // toutes les pages de RAM du coeur sont surveillées dès le départ
+    for (uint32_t p = 0; p < LLMP_PAGES; p++) {
+        if (fz.vm->pages[p].kind != LLMP_MEM_RAM) continue;
+        fz.vm->pages[p].prot |= LLMP_PROT_COW;
+        llmp16_mem_refresh_page(fz.vm, p);
+    }
+}
+
+static void print_state(const char *who, const uint32_t *r, uint8_t flags, bool halted)
+{
+    fprintf(stderr, "%-9s", who);
+    for (int i = 0; i < 8; i++) fprintf(stderr, " %s=%04X", llmp16_reg_name(i), r[i]);
+    fprintf(stderr, "\n         ");
+    for (int i = 8; i < 16; i++) fprintf(stderr, " %s=%08X", llmp16_reg_name(i), r[i]);
+    fprintf(stderr, " FLAGS=%X%s\n", flags, halted ? " HALT" : "");
+}
+
+static void diverge(const char *what, uint32_t pc)
+{
+    const llmp16_t *vm = fz.vm;
+    char text[64];
+
+    instr_t in = llmp16_decode_raw(llmp16_mem_peek16(vm, pc), llmp16_mem_peek16(vm, pc + 2));
+    llmp16_disasm(&in, text, sizeof(text));
+    fprintf(stderr, "llmp16_fuzz : écart (%s) après l'instruction %llu en 0x%05X : %04X  %s\n",
+            what, (unsigned long long)fz.ref.stats.instructions, pc & LLMP_ADDR_MASK, in.raw, text);
+    print_state("référence", fz.ref.r, fz.ref.flags, fz.ref.halted);
+    print_state("coeur", vm->R, vm->FLAGS, vm->cpu_halted);
+    fprintf(stderr, "cycles : référence %llu, coeur %llu\n",
+            (unsigned long long)fz.ref.stats.cycles, (unsigned long long)vm->stats.cycles);
+    abort();
+}
+
+static bool same_regs(void)
+{
+    const llmp16_t *vm = fz.vm;
+    if (memcmp(vm->R, fz.ref.r, sizeof(vm->R)) != 0) return false;
+    return vm->FLAGS == fz.ref.flags && vm->cpu_halted == fz.ref.halted
+        && vm->stats.cycles == fz.ref.stats.cycles;
+}
+
+/* Compare puis remet à zéro les pages écrites par l'une ou l'autre machine */
+static void check_and_clean(uint32_t pc)
+{
+    llmp16_t *vm = fz.vm;
+
+    for (uint32_t p = 0; p < LLMP_PAGES; p++) {
+        llmp16_mem_page_t *page = &vm->pages[p];
+        bool core_dirty = page->kind == LLMP_MEM_RAM && !(page->prot & LLMP_PROT_COW);
+        if (!core_dirty && !fz.ref.dirty[p]) continue;
+
+        uint8_t *ref_page = fz.ref.mem + ((size_t)p << LLMP_PAGE_SHIFT);
+        if (memcmp(page->backing, ref_page, LLMP_PAGE_SIZE) != 0) diverge("mémoire", pc);
+        memset(page->backing, 0, LLMP_PAGE_SIZE);
+        memset(ref_page, 0, LLMP_PAGE_SIZE);
+        fz.ref.dirty[p] = 0;
+        page->prot |= LLMP_PROT_COW;
+        llmp16_mem_refresh_page(vm, p);
+    }
+    for (uint32_t p = 0; p < LLMP_VRAM_PAGES; p++) {
+        if (!fz.ref.vdirty[p]) continue;
+        size_t off = (size_t)p << LLMP_PAGE_SHIFT;
+        if (memcmp(vm->VRAM + off, fz.ref.vram + off, LLMP_PAGE_SIZE) != 0) diverge("VRAM", pc);
+        memset(vm->VRAM + off, 0, LLMP_PAGE_SIZE);
+        memset(fz.ref.vram + off, 0, LLMP_PAGE_SIZE);
+        fz.ref.vdirty[p] = 0;
+    }
+
+    if (memcmp(vm->IO, fz.ref.io, sizeof(vm->IO)) != 0) diverge("registres IO", pc);
+    if (vm->stats.instructions != fz.ref.stats.instructions || vm->stats.io_reads != fz.ref.stats.io_reads
+        || vm->stats.io_writes != fz.ref.stats.io_writes || vm->stats.vram_writes != fz.ref.stats.vram_writes
+        || vm->stats.mem_faults != fz.ref.stats.mem_faults)
+        diverge("compteurs", pc);
+    if (vm->fault.kind != fz.ref.fault.kind || vm->fault.addr != fz.ref.fault.addr || vm->fault.pc != fz.ref.fault.pc)
+        diverge("défaut mémoire", pc);
+
+    // contrôle complet périodique : une écriture que la référence n'a pas faite (VRAM) passe
+    // inaperçue dans les pages suivies ; les deux images doivent être vierges hors programme
+    if (++fz.execs % LLMP_FUZZ_FULL_CHECK == 0) {
+        if (memcmp(vm->memory + LLMP_ROM_SIZE, fz.ref.mem + LLMP_ROM_SIZE, LLMP_MEM_SIZE - LLMP_ROM_SIZE) != 0)
+            diverge("mémoire (contrôle complet)", pc);
+        if (memcmp(vm->VRAM, fz.ref.vram, LLMP_VRAM_SIZE) != 0) diverge("VRAM (contrôle complet)", pc);
+    }
+}
+
+/* Prépare les deux machines pour une entrée : seul l'état touché par la précédente est refait */
+static void load_input(const uint8_t *data, size_t size)
+{
+    llmp16_t *vm = fz.vm;
+    size_t len = size - LLMP_FUZZ_HEADER;
+    if (len > LLMP_ROM_SIZE) len = LLMP_ROM_SIZE;
+
+    if (fz.prog_len > len) {
+        memset(vm->memory + len, 0, fz.prog_len - len);
+        memset(fz.ref.mem + len, 0, fz.prog_len - len);
+    }
+    memcpy(vm->memory, data + LLMP_FUZZ_HEADER, len);
+    memcpy(fz.ref.mem, data + LLMP_FUZZ_HEADER, len);
+    fz.prog_len = len;
+
+    memset(vm->R, 0, sizeof(vm->R));
+    memset(fz.ref.r, 0, sizeof(fz.ref.r));
+    for (int i = 0; i < 8; i++)
+        vm->R[i] = fz.ref.r[i] = (uint32_t)(data[2 * i] | data[2 * i + 1] << 8);
+    llmp16_reg_set(vm, SP, LLMP_STACK_TOP);
+    fz.ref.r[SP] = LLMP_STACK_TOP;
+    vm->FLAGS = fz.ref.flags = data[16] & 0x0F;
+    vm->cpu_halted = fz.ref.halted = false;
+
+    memset(vm->IO, 0, sizeof(vm->IO));
+    memset(fz.ref.io, 0, sizeof(fz.ref.io));
+    memset(&vm->stats, 0, sizeof(vm->stats));
+    memset(&fz.ref.stats, 0, sizeof(fz.ref.stats));
+    memset(&vm->fault, 0, sizeof(vm->fault));
+    memset(&fz.ref.fault, 0, sizeof(fz.ref.fault));
+}
+
+static void fuzz_one(const uint8_t *data, size_t size)
+{
+    if (size < LLMP_FUZZ_HEADER) return;
+    load_input(data, size);
+
+    uint32_t pc = 0;
+    size_t end = (fz.prog_len + 1) & ~(size_t)1;
+    // une entrée sur deux passe par les superinstructions, avec de temps en temps un budget de
+    // cycles trop court pour un groupe entier
+    bool group = fz.execs & 1;
+    for (uint32_t i = 0; i < fz.max_steps && !fz.ref.halted;) {
+        pc = fz.ref.r[PC];
+        // la mémoire vierge (ROM après le programme, RAM jamais écrite) n'exécute que des NOP
+        uint32_t a = pc & LLMP_ADDR_MASK;
+        if (a < LLMP_ROM_SIZE ? a >= end : !fz.ref.dirty[a >> LLMP_PAGE_SHIFT]) break;
+
+        uint32_t n = 1, cycles, expected = 0;
+        if (group) cycles = llmp16_cpu_group(fz.vm, fz.max_steps - i, i % 4 == 3 ? i % 3 : UINT64_MAX, &n);
+        else cycles = llmp16_cpu_cycle(fz.vm);
+        for (uint32_t k = 0; k < n; k++) expected += ref_step(&fz.ref);
+        if (cycles != expected || !same_regs()) diverge("registres", pc);
+        i += n;
+        fz.steps += n;
+    }
+    check_and_clean(pc);
+}
+
+
+/*============================== Points d'entrée ==============================*/
+
+#ifdef LLMP16_LIBFUZZER
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    if (fz.vm == NULL) fuzz_init(LLMP_FUZZ_STEPS);
+    fuzz_one(data, size);
+    return 0;
+}
+
+#else
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* xorshift64* : les entrées aléatoires ne dépendent que de la graine */
+static uint64_t rng_next(uint64_t *s)
+{
+    *s ^= *s >> 12;
+    *s ^= *s << 25;
+    *s ^= *s >> 27;
+    return *s * 0x2545F4914F6CDD1Dull;
+}
+
+/* Programme aléatoire : surtout des opcodes définis, et des sauts ou accès mémoire dont
+   l'adresse retombe souvent dans le programme ou dans la RAM qui le suit */
+static size_t random_input(uint8_t *buf, uint64_t *seed)
+{
+    // opcodes des superinstructions (llmp16_super.c), registres tirés au hasard
+    static const uint16_t idioms[][2] = {
+        { 0x1005, 0x0F00 }, { 0x1006, 0x0F00 }, { 0x1007, 0x0FF0 }, { 0x2007, 0x0F00 },
+        { 0x8000, 0x000F }, { 0x5001, 0x0FF0 }, { 0x5002, 0x0FF0 }, { 0x5006, 0x0FF0 },
+        { 0x50F0, 0x0F00 }, { 0x1000, 0x0FF3 }, { 0x3000, 0x0FF3 },
+        // instruction de bloc, IDX chargé juste avant (voir plus bas)
+        { 0xB000, 0x0FF3 },
+        // deux pixels : lecture, opération, écriture
+        { 0x5007, 0x0FF0 }, { 0xE000, 0x0FF7 }, { 0x5008, 0x0FF0 },
+    };
+    size_t words = 1 + rng_next(seed) % ((LLMP_FUZZ_MAX_LEN - LLMP_FUZZ_HEADER) / 2);
+    uint8_t *prog = buf + LLMP_FUZZ_HEADER;
+
+    for (size_t i = 0; i < LLMP_FUZZ_HEADER; i++) buf[i] = (uint8_t)rng_next(seed);
+    for (size_t i = 0; i < words; i++) {
+        uint64_t r = rng_next(seed);
+        uint16_t w = (uint16_t)r;
+        if ((r >> 16) % 8) w = (uint16_t)((((r >> 20) % 0xF) << 12) | (w & 0x0FFF));   /* classes 0x0 à 0xE */
+        if ((w >> 12) == 0x0 && (r >> 24) % 4) w &= 0x0007;                              /* NOP .. IRET */
+        if ((r >> 56) % 4 == 0) {
+            const uint16_t *idiom = idioms[(r >> 58) % (sizeof(idioms) / sizeof(idioms[0]))];
+            w = (uint16_t)(idiom[0] | (w & idiom[1]));
+        }
+        // MOVI IDX devant chaque instruction de bloc : avec IDX tiré au hasard, MCPY, MFIL et VFIL
+        // écrivent des milliers d'octets et occupent tout le temps des deux interpréteurs. Une
+        // fois sur LLMP_FUZZ_BLK_LONG, la longueur reste celle du registre (pages, LLMP_BLK_MAX).
+        if ((w >> 12) == 0xB && i + 2 < words && (r >> 40) % LLMP_FUZZ_BLK_LONG) {
+            prog[2 * i] = 0x00;
+            prog[2 * i + 1] = 0x6E;
+            prog[2 * i + 2] = (uint8_t)((r >> 46) % LLMP_FUZZ_BLK_LEN);
+            prog[2 * i + 3] = 0x00;
+            i += 2;
+        }
+        if (llmp16_instr_words(w) == 2 && i + 1 < words && (r >> 28) % 2) {
+            uint16_t target = (uint16_t)((r >> 32) % (2 * words)) & 0xFFFE;
+            if ((r >> 48) % 2) target |= 0x8000;
+            w &= 0xFF0F;                                                                   /* bits 19..16 nuls */
+            prog[2 * i] = (uint8_t)w;
+            prog[2 * i + 1] = (uint8_t)(w >> 8);
+            w = target;
+            i++;
+        }
+        prog[2 * i] = (uint8_t)w;
+        prog[2 * i + 1] = (uint8_t)(w >> 8);
+    }
+    return LLMP_FUZZ_HEADER + 2 * words;
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t runs = 0, seed = 1;
+    uint32_t max_steps = LLMP_FUZZ_STEPS;
+    size_t cap = LLMP_FUZZ_HEADER + LLMP_ROM_SIZE;
+    uint8_t *buf = (uint8_t *)malloc(cap);
+    int files = 0;
+
+    if (buf == NULL) return EXIT_FAILURE;
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '-' && argv[i][1] != '\0' && i + 1 < argc) {
+            switch (argv[i][1]) {
+            case 'n': runs = strtoull(argv[++i], NULL, 0); break;
+            case 'S': seed = strtoull(argv[++i], NULL, 0); break;
+            case 's': max_steps = (uint32_t)strtoul(argv[++i], NULL, 0); break;
+            default:
+                fprintf(stderr, "Usage : %s [-n <entrées>] [-S <graine>] [-s <instructions max>] [entrée ...]\n", argv[0]);
+                return EXIT_FAILURE;
+            }
+            continue;
+        }
+
+        // entrée enregistrée par libFuzzer ou AFL : reproduction d'un écart
+        FILE *f = fopen(argv[i], "rb");
+        if (f == NULL) {
+            perror("Fuzz input open error");
+            return EXIT_FAILURE;
+        }
+        if (fz.vm == NULL) fuzz_init(max_steps);
+        fuzz_one(buf, fread(buf, 1, cap, f));
+        fclose(f);
+        files++;
+    }
+    if (fz.vm == NULL) fuzz_init(max_steps);
+
+    if (runs > 0) {
+        if (seed == 0) seed = 1;
+        double start = now_seconds();
+        for (uint64_t n = 0; n < runs; n++) {
+            size_t size = random_input(buf, &seed);
+            fuzz_one(buf, size);
+        }
+        double elapsed = now_seconds() - start;
+        printf("{\"fuzz\":\"differential\",\"execs\":%llu,\"instructions\":%llu,\"seconds\":%.3f,"
+               "\"execs_per_s\":%.0f,\"instr_per_exec\":%.1f}\n",
+               (unsigned long long)runs, (unsigned long long)fz.steps, elapsed,
+               elapsed > 0.0 ? runs / elapsed : 0.0, (double)fz.steps / runs);
+    } else if (files == 0) {
+        // AFL : une entrée par passage sur stdin, plusieurs par processus en mode persistant
+#ifdef __AFL_LOOP
+        while (__AFL_LOOP(100000))
+            fuzz_one(buf, fread(buf, 1, cap, stdin));
+#else
+        fuzz_one(buf, fread(buf, 1, cap, stdin));
+#endif
+    }
+
+    free(buf);
+    return EXIT_SUCCESS;
+}
+
+#endif
@@ -21,10 +21,12 @@
 *| Endian                   | little‑endian (LSB à l’adresse la plus basse)     |
 */
 
-#define LLMP_MEM_SIZE 0xFFFFF  /* 1 Mo */
+#define LLMP_MEM_SIZE 0x100000  /* 1 Mo */
+#define LLMP_ADDR_MASK 0xFFFFF   /* bus d'adresses de 20 bits : les adresses bouclent */
 #define LLMP_ROM_SIZE 0x8000 /*64 Ko*/
 #define LLMP_VRAM_BANKS   2
 #define LLMP_VRAM_BANK_SIZE 0x10000  /* 64 Ko */
+#define LLMP_VRAM_SIZE (LLMP_VRAM_BANKS * LLMP_VRAM_BANK_SIZE)
 #define LLMP_IO_PORTS    16
 #define LLMP_IO_REGS     16
 
@@ -37,6 +39,16 @@ enum{
 };
 
 typedef struct llmp16_s llmp16_t;
+typedef struct llmp16_profiler_s llmp16_profiler_t;
+typedef struct llmp16_trace_s llmp16_trace_t;
+typedef struct llmp16_debug_s llmp16_debug_t;
+typedef struct llmp16_journal_s llmp16_journal_t;
+typedef struct llmp16_rewind_s llmp16_rewind_t;
+typedef struct llmp16_shm_s llmp16_shm_t;
+typedef struct llmp16_capture_s llmp16_capture_t;
+typedef struct llmp16_predecode_s llmp16_predecode_t;
+typedef struct llmp16_aot_s llmp16_aot_t;
+typedef struct llmp16_text_s llmp16_text_t;
 
 
 /*
@@ -50,6 +62,10 @@ typedef struct llmp16_s llmp16_t;
  *   Reg 2 (R2) : COUNT             (nombre d’octets à transférer, bits 15..0)
  *   Reg 3 (R3) : CTRL              (bit 0 = DMA_ENABLE, bit 1 = IRQ_ENABLE)
  *   Reg 4 (R4) : STAT              (bit 0 = BUSY, bit 1 = DONE, bit 2 = ERROR)
+ *   Reg 5 (R5) : HI                (bits 3..0 = SRC bits 19..16, bits 7..4 = DST bits 19..16)
+ *
+ * Sans DMA_CTRL_MEM la destination est la VRAM (adresse 16 bits dans le banc 0), avec
+ * DMA_CTRL_MEM c'est une adresse mémoire de 20 bits, y compris la fenêtre VRAM/MMIO.
  */
 
 #define LLMP_DMA_PORT       7
@@ -58,11 +74,13 @@ typedef struct llmp16_s llmp16_t;
 #define LLMP_DMA_REG_CNT    2
 #define LLMP_DMA_REG_CTRL   3
 #define LLMP_DMA_REG_STAT   4
-#define LLMP_DMA_REG_MAX    5
+#define LLMP_DMA_REG_HI     5
+#define LLMP_DMA_REG_MAX    6
 
 /* Contrôle */
 #define DMA_CTRL_ENABLE     0x01  /* Démarrer le transfert */
 #define DMA_CTRL_IRQ_EN     0x02  /* Générer une IRQ à la fin */
+#define DMA_CTRL_MEM        0x04  /* Destination en mémoire (20 bits) plutôt qu'en VRAM */
 
 /* Statut */
 #define DMA_STAT_BUSY       0x01
@@ -70,8 +88,8 @@ typedef struct llmp16_s llmp16_t;
 #define DMA_STAT_ERROR      0x04
 
 typedef struct {
-    uint16_t src_addr;   /* Adresse source 16-bits */
-    uint16_t dst_addr;   /* Adresse destination 1--bits */
+    uint32_t src_addr;   /* Adresse source 20-bits */
+    uint32_t dst_addr;   /* Adresse destination 20-bits */
     uint16_t count;      /* Nombre d’octets à copier */
     uint8_t  ctrl;       /* Registre de contrôle */
     uint8_t  stat;       /* Registre de statut */
@@ -82,7 +100,10 @@ typedef struct {
 void llmp16_dma_init(llmp16_dma_t *dma);
 void llmp16_dma_cpy(llmp16_t *vm, llmp16_dma_t *dma);
 void llmp16_dma_readIO(llmp16_t *vm, llmp16_dma_t *dma);
-void llmp16_dma_step(llmp16_t *vm, llmp16_dma_t *dma);
+uint32_t llmp16_dma_step(llmp16_t *vm, llmp16_dma_t *dma);
+
+// Débit du DMA : le CPU est bloqué pendant le transfert (cycles volés)
+#define LLMP_DMA_BYTES_PER_CYCLE  2
 
 // Numéro de port IO pour le blitter
 #define LLMP_BLT_PORT       8
@@ -99,8 +120,14 @@ void llmp16_dma_step(llmp16_t *vm, llmp16_dma_t *dma);
 #define BLT_CTRL_START      0x01
 #define BLT_CTRL_BITMODE    0x02
 
+// Débit du blitter en pixels par cycle, le CPU attend la fin du blit
+#define LLMP_BLT_PIXELS_PER_CYCLE 4
+
+// Octet 1 bpp -> 8 pixels 0x00/0xFF, bit 7 à gauche (blitter en mode bit, mode texte).
+// Table constante partagée par toutes les VMs.
+extern const uint8_t llmp16_bit_expand[256][8];
 
-void llmp16_blitter_step(llmp16_t *vm);
+uint32_t llmp16_blitter_step(llmp16_t *vm);
 
 
 
@@ -108,24 +135,129 @@ void llmp16_blitter_step(llmp16_t *vm);
 
 #define LLMP_SCREEN_HEIGHT 200
 #define LLMP_SCREEN_WIDTH  320
-#define LLMP_SCREEN_SCALE 2
-#define LLMP_WINDOW_WIDTH LLMP_SCREEN_WIDTH * LLMP_SCREEN_SCALE
-#define LLMP_WINDOW_HEIGHT LLMP_SCREEN_HEIGHT * LLMP_SCREEN_SCALE
+#define LLMP_SCREEN_SCALE 2         /* échelle par défaut, voir llmp16_screen_t.scale */
+#define LLMP_SCREEN_SCALE_MAX 4
 
 
 
 #define LLMP_SCREEN_ENABLE 0x1
 
+/*
+ * Port 0 (écran) :
+ *   Reg 1 : banc de VRAM affiché
+ *   Reg 2 : MODE   (bit 0 = mode texte)
+ *   Reg 3 : TEXT   (adresse du tampon texte dans le banc 0)
+ *
+ * En mode texte, le fond de l'image est une grille de 40x25 cellules de 8x8 pixels dessinées
+ * par l'hôte avec BIOS_FONT.h. Une cellule occupe deux octets : le caractère puis l'attribut
+ * (bits 3..0 = couleur du texte, bits 7..4 = couleur du fond, palette CGA de 16 couleurs) ;
+ * un VSTRW écrit donc une cellule. Seules les cellules modifiées depuis l'image précédente
+ * sont redessinées. Le compositeur (port 5) se superpose au texte comme au banc affiché.
+ */
+#define LLMP_SCREEN_PORT      0
+#define LLMP_SCREEN_REG_BANK  1
+#define LLMP_SCREEN_REG_MODE  2
+#define LLMP_SCREEN_REG_TEXT  3
+#define SCREEN_MODE_TEXT      0x01
+
+#define LLMP_TEXT_COLS        40
+#define LLMP_TEXT_ROWS        25
+#define LLMP_TEXT_CELLS       (LLMP_TEXT_COLS * LLMP_TEXT_ROWS)
+
+/*
+ * Présentation : l'image RGB332 est agrandie d'un facteur entier par le CPU, directement en
+ * XRGB8888 dans la texture, que le renderer copie ensuite pixel pour pixel. Aucun
+ * redimensionnement n'est demandé à SDL, ce qui garde le renderer logiciel rapide.
+ * SCANLINES assombrit la dernière ligne de chaque groupe de <scale> lignes, CRT y ajoute un
+ * masque RGB d'une colonne sur trois (sans effet à l'échelle 1).
+ */
+typedef enum {
+    LLMP_FILTER_NONE,
+    LLMP_FILTER_SCANLINES,
+    LLMP_FILTER_CRT
+} llmp16_filter_t;
+
 typedef struct
 {
     SDL_Window *window;
     SDL_Renderer* renderer;
     SDL_Texture *framebuffer;
+    int scale;                  /* 1 à LLMP_SCREEN_SCALE_MAX, 0 = LLMP_SCREEN_SCALE */
+    llmp16_filter_t filter;
+    uint32_t lut[2][3][256];    /* [ligne sombre][colonne % 3][pixel RGB332] -> XRGB8888 */
 }llmp16_screen_t;
 
+/* <scale> et <filter> sont lus à l'ouverture de la fenêtre */
 int llmp16_screen_init(llmp16_screen_t *screen);
 void llmp16_screen_off(llmp16_screen_t *screen);
-void llmp16_screen_render(llmp16_screen_t screen, uint8_t* VRAM);
+void llmp16_screen_render(llmp16_screen_t *screen, const uint8_t* VRAM);
+/* Tables de couleurs de <scale>/<filter>, puis agrandissement d'une image dans <dst>
+   (LLMP_SCREEN_WIDTH * scale pixels par ligne, <pitch> octets entre deux lignes) */
+void llmp16_screen_setup(llmp16_screen_t *screen);
+void llmp16_screen_scale(const llmp16_screen_t *screen, const uint8_t *frame, uint32_t *dst, int pitch);
+
+
+/*
+ * Compositeur (tilemap et sprites)
+ * --------------------------------
+ * Étage entre la VRAM et la présentation : le banc affiché sert de fond, un tilemap défilant
+ * et des sprites sont composés par-dessus, ligne par ligne, au moment du rendu. Le guest ne
+ * redessine plus rien pour faire défiler un décor ou déplacer un objet : il écrit les registres
+ * de défilement et la table des sprites. Tout l'état est dans les registres IO et la VRAM,
+ * l'image composée n'est qu'un cache de présentation (rien à sauver pour le rembobinage).
+ *
+ * IO Port 5 (compositeur) :
+ *   Reg 0 : CTRL       (bit 0 = TILES, bit 1 = SPRITES, bit 2 = tables dans le banc 1)
+ *   Reg 1 : SCROLL_X   (pixels, le tilemap boucle)
+ *   Reg 2 : SCROLL_Y
+ *   Reg 3 : MAP        (adresse VRAM du tilemap : un octet par tuile, ligne par ligne)
+ *   Reg 4 : MAP_SIZE   (bits 7..0 = largeur en tuiles, bits 15..8 = hauteur, 0 = 256)
+ *   Reg 5 : TILES      (adresse VRAM des tuiles : 8x8 pixels 8 bpp, 64 octets par tuile)
+ *   Reg 6 : SPRITES    (adresse VRAM de la table des sprites, 8 octets par sprite)
+ *   Reg 7 : COUNT      (nombre de sprites, au plus LLMP_VID_SPRITES)
+ *   Reg 8 : KEY        (couleur transparente des tuiles et des sprites, bits 7..0)
+ *
+ * Sprite (little-endian) : X (int16), Y (int16), adresse VRAM des pixels (w x h, 8 bpp),
+ * taille (bits 3..0 = w / 8 - 1, bits 7..4 = h / 8 - 1), flags (LLMP_SPR_*). Le sprite 0 est
+ * devant les autres ; un sprite BEHIND passe sous le tilemap.
+ */
+
+#define LLMP_VID_PORT         5
+#define LLMP_VID_REG_CTRL     0
+#define LLMP_VID_REG_SCROLL_X 1
+#define LLMP_VID_REG_SCROLL_Y 2
+#define LLMP_VID_REG_MAP      3
+#define LLMP_VID_REG_MAP_SIZE 4
+#define LLMP_VID_REG_TILES    5
+#define LLMP_VID_REG_SPRITES  6
+#define LLMP_VID_REG_COUNT    7
+#define LLMP_VID_REG_KEY      8
+
+#define VID_CTRL_TILES        0x01
+#define VID_CTRL_SPRITES      0x02
+#define VID_CTRL_BANK1        0x04
+
+#define LLMP_VID_SPRITES      64
+#define LLMP_VID_SPRITE_SIZE  8
+#define LLMP_VID_TILE         8
+
+#define LLMP_SPR_VISIBLE      0x01
+#define LLMP_SPR_BEHIND       0x02
+#define LLMP_SPR_HFLIP        0x04
+#define LLMP_SPR_VFLIP        0x08
+
+/* Image 320x200 RGB332 à présenter : le banc affiché (ou l'image du mode texte) tel quel si le
+   compositeur est éteint, sinon l'image composée dans vm->frame. Sans mémoire pour le cache,
+   on retombe sur le banc affiché. */
+const uint8_t *llmp16_video_frame(llmp16_t *vm);
+/* Libère les caches de présentation (image composée, mode texte) */
+void llmp16_video_free(llmp16_t *vm);
+/* Image terminée : publiée dans l'anneau partagé (vm->shm) et la capture (vm->capture) s'ils
+   sont attachés. Les boucles sans frames (ordonnanceur) appellent llmp16_video_tick() après
+   chaque tranche : l'image courante est présentée quand les cycles ont passé une frontière de
+   CYCLES_PER_FRAME. */
+void llmp16_video_present(llmp16_t *vm, const uint8_t *image);
+void llmp16_video_tick(llmp16_t *vm);
 
 
 /*=========================== KeyBoard =====================================*/
@@ -158,6 +290,7 @@ typedef struct
 {
    uint16_t count; // valeur courante du timer
    uint8_t PSC; // préscaler
+   uint32_t prescale; // cycles accumulés depuis le dernier tick
    uint16_t value; // valeur max/min
    uint16_t init_value;
    uint16_t status;
@@ -165,7 +298,148 @@ typedef struct
 
 
 void llmp16_timer_init(llmp16_timer_t *timer, uint8_t PSC, uint16_t value, uint16_t init_value);
-void llmp16_timer_count(llmp16_timer_t *timer, uint8_t clk_counter);
+void llmp16_timer_count(llmp16_timer_t *timer, uint32_t cycles);
+
+/*====================================== COMPTEURS ==========================================*/
+
+/*
+Compteurs de performance par VM, incrémentés par le coeur et les périphériques.
+L'hôte les lit avec llmp16_stats_get() ou les écrit en JSON (une ligne par relevé).
+
+Le port $F expose les compteurs à l'invité en lecture seule (les OUT sont ignorés).
+La lecture du registre 0 fige une copie de tous les compteurs, les registres suivants
+renvoient cette copie : on lit donc le registre 0 en premier.
+   Reg 0..3 : cycles        (bits 15..0, 31..16, 47..32, 63..48)
+   Reg 4..7 : instructions  (bits 15..0, 31..16, 47..32, 63..48)
+   Reg 8..9 : frames        (bits 15..0, 31..16)
+*/
+
+#define LLMP_STATS_PORT        0xF
+#define LLMP_STATS_REG_CYCLES  0
+#define LLMP_STATS_REG_INSTR   4
+#define LLMP_STATS_REG_FRAMES  8
+
+typedef struct
+{
+   uint64_t instructions;
+   uint64_t cycles;
+   uint64_t frames;
+   uint64_t blits;
+   uint64_t blit_pixels;
+   uint64_t dma_transfers;
+   uint64_t dma_bytes;
+   uint64_t vram_writes;
+   uint64_t io_reads;
+   uint64_t io_writes;
+   uint64_t interrupts;
+   uint64_t mem_faults;
+}llmp16_stats_t;
+
+void llmp16_stats_get(const llmp16_t *vm, llmp16_stats_t *out);
+void llmp16_stats_write_json(const llmp16_t *vm, FILE *out);
+void llmp16_stats_set_dump(llmp16_t *vm, FILE *out, uint64_t period);
+void llmp16_stats_latch(llmp16_t *vm);
+
+uint16_t llmp16_io_read(llmp16_t *vm, uint8_t port, uint8_t reg);
+void llmp16_io_write(llmp16_t *vm, uint8_t port, uint8_t reg, uint16_t value);
+
+/*====================================== MÉMOIRE ==========================================*/
+
+/*
+Contrôleur mémoire : l'espace de 20 bits est découpé en 256 pages de 4 Ko. Chaque page a
+une fonction de lecture et une d'écriture : mem_read8/mem_write8 indexent la table et
+appellent, sans test. Une page directe (RAM, ROM en lecture) a l'accès par pointeur vers son
+octet 0 (rd_page/wr_page) ; les autres ont le chemin lent (llmp16_memory.c) qui traite les
+régions MMIO, les écritures en ROM et les pages non mappées. rd_page/wr_page valent NULL pour
+ces pages : les copies de bloc, les superinstructions et le code AOT testent une fois par
+bloc s'ils peuvent accéder aux octets directement.
+
+Carte par défaut :
+   0x00000 - 0x07FFF : ROM (protégée en écriture)
+   0x08000 - 0xFFFFF : RAM
+
+Fenêtre optionnelle, installée par llmp16_mem_map_devices() par-dessus la RAM :
+   0xA0000 - 0xAFFFF : VRAM banc 0 (accès direct, même vitesse que la RAM)
+   0xB0000 - 0xBFFFF : VRAM banc 1
+   0xC0000 - 0xC01FF : registres IO, port p registre r en 0xC0000 + p*32 + r*2
+Les registres IO s'accèdent en mots de 16 bits : l'octet bas d'une lecture déclenche les
+effets de bord du port (comme IN), l'octet haut d'une écriture valide le mot (comme OUT).
+
+Bits de protection (debugger, voir llmp16_debug.h) : une page qui porte un breakpoint ou un
+watchpoint perd ses pointeurs rapides, ses accès passent par le chemin lent qui appelle le
+debugger. Les autres pages gardent l'accès direct : sans point d'arrêt, rien ne change.
+
+Un défaut (écriture en ROM, accès à une page non mappée) est compté dans stats.mem_faults et
+mémorisé dans vm->fault ; l'écriture est ignorée et la lecture renvoie 0xFF. Si fault_halt est
+vrai, le CPU s'arrête comme sur HALT.
+*/
+
+#define LLMP_PAGE_SHIFT  12
+#define LLMP_PAGE_SIZE   (1u << LLMP_PAGE_SHIFT)
+#define LLMP_PAGE_MASK   (LLMP_PAGE_SIZE - 1)
+#define LLMP_PAGES       (LLMP_MEM_SIZE >> LLMP_PAGE_SHIFT)
+#define LLMP_STACK_TOP   LLMP_MEM_SIZE  /* SP initial : le premier PUSH écrit en 0xFFFFE */
+
+#define LLMP_VRAM_PAGES  (LLMP_VRAM_BANK_SIZE >> LLMP_PAGE_SHIFT)
+
+#define LLMP_PROT_BREAK  0x01           /* la page contient un breakpoint */
+#define LLMP_PROT_READ   0x02           /* watchpoint en lecture */
+#define LLMP_PROT_WRITE  0x04           /* watchpoint en écriture */
+#define LLMP_PROT_COW    0x08           /* page à copier avant sa première écriture (rembobinage) */
+
+#define LLMP_MMIO_VRAM   0xA0000
+#define LLMP_MMIO_IO     0xC0000
+
+typedef enum {
+   LLMP_MEM_UNMAPPED = 0,
+   LLMP_MEM_RAM,
+   LLMP_MEM_ROM,
+   LLMP_MEM_MMIO
+} llmp16_mem_kind_t;
+
+typedef enum {
+   LLMP_FAULT_NONE = 0,
+   LLMP_FAULT_ROM_WRITE,
+   LLMP_FAULT_UNMAPPED_READ,
+   LLMP_FAULT_UNMAPPED_WRITE
+} llmp16_fault_kind_t;
+
+typedef uint8_t (*llmp16_mmio_read_t)(llmp16_t *vm, uint32_t addr);
+typedef void    (*llmp16_mmio_write_t)(llmp16_t *vm, uint32_t addr, uint8_t v);
+
+typedef struct {
+   uint8_t kind;                        /* llmp16_mem_kind_t */
+   uint8_t prot;                        /* LLMP_PROT_* posés par le debugger et le rembobinage */
+   uint8_t *backing;                    /* octet 0 de la page (RAM, ROM) */
+   llmp16_mmio_read_t  read;            /* MMIO uniquement */
+   llmp16_mmio_write_t write;
+} llmp16_mem_page_t;
+
+typedef struct {
+   uint8_t  kind;                       /* llmp16_fault_kind_t du dernier défaut */
+   uint32_t addr;
+   uint32_t pc;                         /* PC après le fetch de l'instruction fautive */
+} llmp16_fault_t;
+
+int  llmp16_mem_map(llmp16_t *vm, uint32_t base, uint32_t size, llmp16_mem_kind_t kind);
+int  llmp16_mem_map_backed(llmp16_t *vm, uint32_t base, uint32_t size, llmp16_mem_kind_t kind, uint8_t *backing);
+int  llmp16_mem_map_devices(llmp16_t *vm);
+int  llmp16_mem_map_mmio(llmp16_t *vm, uint32_t base, uint32_t size,
+                         llmp16_mmio_read_t read, llmp16_mmio_write_t write);
+void llmp16_mem_refresh_page(llmp16_t *vm, uint32_t page);
+uint8_t llmp16_mem_read_slow(llmp16_t *vm, uint32_t addr);
+void llmp16_mem_write_slow(llmp16_t *vm, uint32_t addr, uint8_t v);
+uint8_t llmp16_vram_read_slow(llmp16_t *vm, uint16_t addr);
+void llmp16_vram_write_slow(llmp16_t *vm, uint16_t addr, uint8_t v);
+void llmp16_vram_protect(llmp16_t *vm, uint32_t page, uint8_t prot);
+uint8_t llmp16_mem_peek8(const llmp16_t *vm, uint32_t addr);
+uint16_t llmp16_mem_peek16(const llmp16_t *vm, uint32_t addr);
+void llmp16_mem_move(llmp16_t *vm, uint32_t dst, uint32_t src, uint32_t n);
+void llmp16_mem_fill(llmp16_t *vm, uint32_t dst, uint8_t v, uint32_t n);
+void llmp16_vram_fill(llmp16_t *vm, uint16_t dst, uint8_t v, uint32_t n);
+uint32_t llmp16_mem_compare(llmp16_t *vm, uint32_t a, uint32_t b, uint32_t n, uint8_t *va, uint8_t *vb);
+int llmp16_mem_poke8(llmp16_t *vm, uint32_t addr, uint8_t v);
+const char *llmp16_fault_name(uint8_t kind);
 
 /*============================== Machine Virtuelle ==============================*/
 
@@ -189,17 +463,29 @@ typedef enum {
 } llmp16_register_t;
 
 
-typedef struct llmp16_s {                      /* R0‑R8 sont des registres généraux */
-   uint16_t R16[8];                      /*R9-R15 sont des registres spéciaux (Acc, Index_high, Index_low, Index, SP, PC)*/
-   uint32_t R32[8];
+typedef struct llmp16_s {
+   uint32_t R[16];                      /* R0-R7 : 16 bits (masqués à l'écriture), R8-R15 : 32 bits dont PC, SP, IDX, ACC */
 
    uint8_t  FLAGS;                      /* NZCV, bits 3..0    */
 
-   bool halted;
+   bool halted;                         /* VM éteinte (fenêtre fermée, arrêt demandé par l'hôte) */
+   bool cpu_halted;                     /* le CPU a exécuté HALT */
 
    uint8_t  *memory;
    uint8_t  *VRAM; 
 
+   uint8_t  *rd_page[LLMP_PAGES];       /* accès direct, NULL = chemin lent */
+   uint8_t  *wr_page[LLMP_PAGES];
+   llmp16_mmio_read_t  rd_fn[LLMP_PAGES];   /* accès d'un octet : direct ou chemin lent */
+   llmp16_mmio_write_t wr_fn[LLMP_PAGES];
+   llmp16_mem_page_t pages[LLMP_PAGES]; /* nature de chaque page */
+   llmp16_fault_t fault;                /* dernier défaut mémoire */
+   bool fault_halt;                     /* arrêter le CPU au premier défaut */
+   uint8_t  *vram_rd[LLMP_VRAM_PAGES];  /* VLD/VSTR et DMA vers le banc 0, NULL = chemin lent */
+   uint8_t  *vram_wr[LLMP_VRAM_PAGES];
+   uint16_t io_latch;                   /* fenêtre MMIO : mot IO en cours de lecture/écriture */
+   uint32_t io_latch_addr;
+
 
    llmp16_screen_t screen;
 
@@ -217,25 +503,75 @@ typedef struct llmp16_s {                      /* R0‑R8 sont des registres gé
    uint16_t int_vector_pending;
    bool int_pending;
 
+   llmp16_stats_t stats;                /* compteurs de performance */
+   FILE *stats_out;                     /* relevés JSON périodiques (NULL = désactivés) */
+   uint64_t stats_period;               /* cycles entre deux relevés */
+   uint64_t stats_next;                 /* cycle du prochain relevé */
+
+   llmp16_profiler_t *profiler;         /* profileur invité optionnel (NULL = désactivé) */
+   llmp16_trace_t *trace;               /* traceur d'exécution optionnel (NULL = désactivé) */
+   llmp16_debug_t *debug;               /* debugger optionnel (NULL = désactivé) */
+   llmp16_journal_t *journal;           /* journal d'entrées optionnel (NULL = désactivé) */
+   llmp16_rewind_t *rewind;             /* tampon de rembobinage optionnel (NULL = désactivé) */
+   int64_t frame_credit;                /* cycles dus à la frame suivante (llmp16_run_frame) */
+   llmp16_predecode_t *predecode;       /* cache de superinstructions, alloué au premier usage */
+   llmp16_aot_t *aot;                   /* ROM traduite en C (NULL = interprétée), llmp16_aot.h */
+   uint8_t *frame;                      /* image composée, allouée au premier usage (llmp16_video_frame) */
+   llmp16_text_t *text;                 /* cache du mode texte, alloué au premier usage */
+   llmp16_shm_t *shm;                   /* export des images en mémoire partagée (NULL = désactivé) */
+   llmp16_capture_t *capture;           /* capture des images sur disque (NULL = désactivée) */
+   uint64_t video_frames;               /* frontières de frame déjà présentées (llmp16_video_tick) */
+
 } llmp16_t;
 
-static inline uint32_t llmp16_reg_get(llmp16_t *vm, llmp16_register_t X)
+/* Largeur architecturale de RX : 0xFFFF pour R0-R7, 0xFFFFFFFF au-delà (un cmov, pas de saut) */
+static inline uint32_t llmp16_reg_mask(unsigned X)
+{
+   return X < 8 ? 0xFFFFu : 0xFFFFFFFFu;
+}
+
+/* X vient d'un champ de 4 bits du décodeur : le masque & 15 ne sert qu'à borner l'accès */
+static inline uint32_t llmp16_reg_get(const llmp16_t *vm, llmp16_register_t X)
 {
-   if(X > 15) return 0x00;
-   if(X < 8) return vm->R16[X];
-   else return vm->R32[X-8];
+   return vm->R[X & 15];
 }
 
 static inline void llmp16_reg_set(llmp16_t *vm, llmp16_register_t X, uint32_t v)
 {
-   if(X > 15) return;
-   if(X < 8) vm->R16[X] = (uint16_t)v;
-   else vm->R32[X-8] = v;
+   vm->R[X & 15] = v & llmp16_reg_mask(X);
 }
 
+#define CPU_FREQ     5000000   // 5 MHz
+#define FRAME_RATE   60
+#define CYCLES_PER_FRAME (CPU_FREQ / FRAME_RATE)
+
+/*
+Modèle de timing : chaque instruction coûte un nombre de cycles précalculé au décodage
+(1 cycle par mot lu, plus les accès mémoire, VRAM et IO et la latence de MUL/DIV), auquel
+s'ajoute LLMP_CYC_BRANCH_TAKEN pour un saut pris. Les instructions de bloc (classe 0xB) ajoutent
+un coût par octet traité, connu à l'exécution. Le blitter et le DMA bloquent le CPU le temps de
+leur transfert. Les frames et les timers avancent au rythme de ces cycles.
+*/
+#define LLMP_CYC_BRANCH_TAKEN 1
+
+/* Instructions de bloc : IDX octets, au plus LLMP_BLK_MAX par instruction (IDX garde le reste).
+   Bus de 16 bits à 2 cycles par mot : une lecture ou une écriture coûte 1 cycle par octet. */
+#define LLMP_BLK_MAX          0x10000
+#define LLMP_CYC_BLK_COPY     2        /* MCPY : lecture + écriture */
+#define LLMP_CYC_BLK_FILL     1        /* MFIL, VFIL : écriture */
+#define LLMP_CYC_BLK_CMP      2        /* MCMP : deux lectures par octet comparé */
+
+/* llmp16_init() ne touche pas à SDL : une VM initialisée est "headless" tant que
+   llmp16_display_init() ne lui a pas ouvert de fenêtre. */
+void llmp16_init(llmp16_t *vm);
+int llmp16_display_init(llmp16_t *vm);
+uint32_t llmp16_step(llmp16_t *vm);
+uint32_t llmp16_run_slice(llmp16_t *vm, uint32_t quota);
+uint64_t llmp16_run_cycles(llmp16_t *vm, uint64_t budget);
+void llmp16_run_frame(llmp16_t *vm);
 void llmp16_run(llmp16_t *vm);
 void llmp16_off(llmp16_t *vm);
-void llmp16_init(llmp16_t *vm);
+void llmp16_debug_dump(llmp16_t *vm);
  
 /*============== Routines de mises à jour des flags ===============*/
  
@@ -257,6 +593,28 @@ static inline void flag_nz(llmp16_t *vm, uint16_t res)
    flag_set(vm, FLAG_N, (res & 0x8000) != 0); // Si le bit de poids fort est à 1 alors on met le flag N à 1 sinon on le met à 0
 }
  
+/* Condition de saut t (JUMP .. JLS, 0x0 à 0xC), commune aux sauts registre et immédiats */
+static inline bool llmp16_cond(const llmp16_t *vm, uint8_t t)
+{
+   bool n = flag_get(vm, FLAG_N), z = flag_get(vm, FLAG_Z), c = flag_get(vm, FLAG_C), v = flag_get(vm, FLAG_V);
+   switch (t) {
+   case 0x0: return true;          /* JUMP */
+   case 0x1: return z;             /* JEQ  */
+   case 0x2: return !z;            /* JNE  */
+   case 0x3: return c;             /* JCS  */
+   case 0x4: return !c;            /* JCC  */
+   case 0x5: return v;             /* JVS  */
+   case 0x6: return !v;            /* JVC  */
+   case 0x7: return n == v && !z;  /* JGT  */
+   case 0x8: return n != v;        /* JLT  */
+   case 0x9: return n == v;        /* JGE  */
+   case 0xA: return n != v || z;   /* JLE  */
+   case 0xB: return !c && !z;      /* JHI  */
+   case 0xC: return c || z;        /* JLS  */
+   default:  return false;
+   }
+}
+
 static inline void flag_add_cv(llmp16_t *vm, uint16_t a, uint16_t b, uint32_t result32)
 {
    flag_set(vm, FLAG_C, result32 > 0xFFFF);
@@ -273,20 +631,76 @@ static inline void flag_sub_cv(llmp16_t *vm, uint16_t a, uint16_t b, uint32_t re
    bool ov = ((a ^ b) & (a ^ res) & 0x8000) != 0;
    flag_set(vm, FLAG_V, ov);
 }
+
+/* Variantes 32 bits de l'ALU large (classes 0xC et 0xD) : résultat sur 33 bits */
+static inline void flag_nz32(llmp16_t *vm, uint32_t res)
+{
+   flag_set(vm, FLAG_Z, res == 0);
+   flag_set(vm, FLAG_N, (res & 0x80000000u) != 0);
+}
+
+/* N Z sur la largeur du registre <x> (INC, DEC) : 16 bits pour R0-R7, 32 bits pour R8-R15 */
+static inline void flag_nz_reg(llmp16_t *vm, uint8_t x, uint32_t res)
+{
+   if (x >= 8) flag_nz32(vm, res);
+   else flag_nz(vm, (uint16_t)res);
+}
+
+static inline void flag_add_cv32(llmp16_t *vm, uint32_t a, uint32_t b, uint64_t result64)
+{
+   flag_set(vm, FLAG_C, result64 > 0xFFFFFFFFu);
+   uint32_t res = (uint32_t)result64;
+   flag_set(vm, FLAG_V, (~(a ^ b) & (a ^ res) & 0x80000000u) != 0);
+}
+
+static inline void flag_sub_cv32(llmp16_t *vm, uint32_t a, uint32_t b, uint64_t result64)
+{
+   flag_set(vm, FLAG_C, result64 & 0x100000000ull);
+   uint32_t res = (uint32_t)result64;
+   flag_set(vm, FLAG_V, ((a ^ b) & (a ^ res) & 0x80000000u) != 0);
+}
+
+/* Opérations sur deux octets (classe 0xE) : chaque octet est un pixel, sans retenue de l'un à
+   l'autre. Partagées par execute() et le code traduit. */
+static inline uint8_t llmp16_lane8(uint8_t t, uint8_t a, uint8_t b)
+{
+   switch (t) {
+   case 0x0: return a + b > 0xFF ? 0xFF : (uint8_t)(a + b);   /* PADDS : saturée à 0xFF */
+   case 0x1: return a > b ? (uint8_t)(a - b) : 0;             /* PSUBS : saturée à 0 */
+   case 0x2: return (uint8_t)((a + b + 1) >> 1);              /* PAVG : arrondie au-dessus */
+   case 0x3: return a < b ? a : b;                            /* PMIN */
+   case 0x4: return a > b ? a : b;                            /* PMAX */
+   default:  return 0;
+   }
+}
+
+static inline uint16_t llmp16_packed(uint8_t t, uint16_t a, uint16_t b)
+{
+   return (uint16_t)(llmp16_lane8(t, a & 0xFF, b & 0xFF) | llmp16_lane8(t, a >> 8, b >> 8) << 8);
+}
+
+/* PSHUF : octet bas <- source n & 3, octet haut <- source n >> 2, parmi RX bas, RX haut,
+   ACC bas, ACC haut */
+static inline uint16_t llmp16_shuffle(uint16_t x, uint16_t acc, uint8_t n)
+{
+   uint32_t src = x | (uint32_t)acc << 16;
+   return (uint16_t)(((src >> 8 * (n & 3)) & 0xFF) | ((src >> 8 * (n >> 2)) & 0xFF) << 8);
+}
  
 /*============== Routines de manipulation de la mémoire ==============*/
 
 void dump_memory(const uint8_t *mem, size_t size);
 
 
-// segment 0: 0x0000-0x3FFF, segment 1: 0x4000-0x7FFF, segment 2: 0x8000-0xBFFF, segment 3: 0xC000-0xFFFF
+// pages de 4 Ko, voir la carte mémoire plus haut ; l'adresse est ramenée sur 20 bits
 static inline uint8_t mem_read8(llmp16_t *vm, uint32_t addr) {
-  return vm->memory[addr];
+   addr &= LLMP_ADDR_MASK;
+   return vm->rd_fn[addr >> LLMP_PAGE_SHIFT](vm, addr);
 }
 
 static inline void mem_write8(llmp16_t *vm, uint32_t addr, uint8_t v) {
- 
-   vm->memory[addr] = v;
+   addr &= LLMP_ADDR_MASK;
+   vm->wr_fn[addr >> LLMP_PAGE_SHIFT](vm, addr, v);
 }
  
 static inline uint16_t mem_read16(llmp16_t *vm, uint32_t addr)
@@ -306,12 +720,17 @@ static inline void mem_write16(llmp16_t *vm, uint32_t addr, uint16_t v)
 
 static inline uint8_t  vram_read(llmp16_t *vm, uint16_t addr)
 {
-   return vm->VRAM[addr];
+   uint8_t *page = vm->vram_rd[addr >> LLMP_PAGE_SHIFT];
+   if (page == NULL) return llmp16_vram_read_slow(vm, addr);
+   return page[addr & LLMP_PAGE_MASK];
 }
  
 static inline void vram_write(llmp16_t *vm, uint16_t addr, uint8_t v)
 {
-   vm->VRAM[addr] = v;
+   uint8_t *page = vm->vram_wr[addr >> LLMP_PAGE_SHIFT];
+   vm->stats.vram_writes++;
+   if (page == NULL) { llmp16_vram_write_slow(vm, addr, v); return; }
+   page[addr & LLMP_PAGE_MASK] = v;
 }
  
 static inline void llmp16_reset(llmp16_t *vm)
@@ -319,13 +738,13 @@ static inline void llmp16_reset(llmp16_t *vm)
 
    vm->FLAGS = 0;
    vm->halted = false;
-   memset(vm->R16, 0, sizeof(vm->R16));
-   memset(vm->R32, 0, sizeof(vm->R32));
+   vm->cpu_halted = false;
+   memset(vm->R, 0, sizeof(vm->R));
    llmp16_reg_set(vm, PC, 0);
-   llmp16_reg_set(vm, SP, 0xFFFFF);
+   llmp16_reg_set(vm, SP, LLMP_STACK_TOP);
    memset(vm->IO, 0, sizeof(vm->IO));
    memset(vm->memory, 0, LLMP_MEM_SIZE);
-   memset(vm->VRAM, 0, LLMP_VRAM_BANK_SIZE);
+   memset(vm->VRAM, 0, LLMP_VRAM_SIZE);
 }
 
  /*============== Routines de fetch/decode/execute ==============*/
@@ -340,6 +759,7 @@ typedef struct {
    uint16_t imm; 
    uint32_t addr;       
    uint16_t raw;        
+   uint8_t  cycles;     /* coût hors saut pris, précalculé au décodage */
 } instr_t;
  
 static inline uint16_t fetch(llmp16_t *vm)
@@ -350,8 +770,28 @@ static inline uint16_t fetch(llmp16_t *vm)
 }
 
 instr_t decode(llmp16_t *vm, uint16_t instr);
-void execute(llmp16_t *vm, instr_t in);
-void llmp16_cpu_cycle(llmp16_t *vm);
+instr_t llmp16_decode_raw(uint16_t instr, uint16_t ext);
+int llmp16_instr_words(uint16_t instr);
+bool llmp16_instr_valid(const instr_t *in);
+const char *llmp16_class_name(uint8_t op_class);
+uint32_t execute(llmp16_t *vm, instr_t in);
+uint32_t llmp16_cpu_cycle(llmp16_t *vm);
+
+/*
+Superinstructions (llmp16_super.c) : un cache de prédécodage indexé par PC garde, pour chaque
+adresse déjà exécutée, l'instruction décodée ou un groupe de 2-3 instructions fusionnées en un
+seul traitement (comparaison et saut, opération puis MOV depuis ACC, copie LD/STR, VSTR puis
+INC...). Chaque entrée garde les mots d'origine et est revalidée à chaque passage : du code
+modifié est simplement redécodé. Un groupe n'est exécuté d'un bloc que si les boucles
+d'exécution se seraient de toute façon enchaîné ses instructions (<max_instr> instructions au
+plus, toutes sauf la dernière dans <slack> cycles) : le résultat est identique instruction par
+instruction. Sans profileur, trace ni debugger seulement, ces crochets étant par instruction.
+*/
+uint32_t llmp16_cpu_group(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count);
+void llmp16_predecode_free(llmp16_t *vm);
+
+int llmp16_disasm(const instr_t *in, char *buf, size_t size);
+const char *llmp16_reg_name(uint8_t reg);
 
 
 /*=========================== header fichier binaire ROM ===========================*/
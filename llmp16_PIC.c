@@ -60,6 +60,7 @@ void llmp16_pic_update(llmp16_t *cpu, llmp16_pic_t *pic)
 
         cpu->int_vector_pending = pic->INT_BASE + irq;
         cpu->int_pending = 1;
+        cpu->stats.interrupts++;
     }
 
     llmp16_pic_writeIO(cpu, pic);
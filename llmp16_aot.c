@@ -0,0 +1,62 @@
+#include "llmp16_aot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int llmp16_aot_attach(llmp16_t *vm, const llmp16_aot_image_t *image)
+{
+    if (image->size > LLMP_ROM_SIZE || memcmp(vm->memory, image->rom, image->size) != 0) {
+        fprintf(stderr, "AOT : la ROM chargée n'est pas celle de la traduction (%s)\n", image->name);
+        return -1;
+    }
+    // le code traduit suppose une ROM en lecture seule à sa place habituelle
+    for (uint32_t p = 0; p < LLMP_ROM_SIZE >> LLMP_PAGE_SHIFT; p++) {
+        const llmp16_mem_page_t *page = &vm->pages[p];
+        if (page->kind != LLMP_MEM_ROM || page->backing != vm->memory + (p << LLMP_PAGE_SHIFT)) {
+            fprintf(stderr, "AOT : la ROM n'est pas mappée en 0x%05X\n", p << LLMP_PAGE_SHIFT);
+            return -1;
+        }
+    }
+
+    llmp16_aot_t *aot = (llmp16_aot_t *)calloc(1, sizeof(llmp16_aot_t));
+    if (aot == NULL) {
+        perror("AOT alloc error");
+        return -1;
+    }
+    aot->image = image;
+    for (uint32_t i = 0; i < image->nb_blocks; i++) {
+        const llmp16_aot_block_t *b = &image->blocks[i];
+        if (b->pc < LLMP_ROM_SIZE && !(b->pc & 1)) aot->map[b->pc >> 1] = b;
+    }
+    vm->aot = aot;
+    return 0;
+}
+
+void llmp16_aot_detach(llmp16_t *vm)
+{
+    free(vm->aot);
+    vm->aot = NULL;
+}
+
+uint32_t llmp16_aot_group(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    llmp16_aot_t *aot = vm->aot;
+    uint32_t pc = vm->R[PC];
+
+    if (pc < LLMP_ROM_SIZE && !(pc & 1)) {
+        const llmp16_aot_block_t *b = aot->map[pc >> 1];
+        if (b != NULL && b->count <= max_instr && b->head_cycles <= slack) {
+            if (max_instr > LLMP_AOT_RUN_MAX) max_instr = LLMP_AOT_RUN_MAX;
+            uint32_t cycles = b->run(vm, max_instr, slack, count);
+            // première instruction sur le chemin lent : rien n'a été exécuté
+            if (*count == 0) return llmp16_cpu_group(vm, max_instr, slack, count);
+            vm->stats.instructions += *count;
+            vm->stats.cycles += cycles;
+            aot->instructions += *count;
+            aot->blocks++;
+            return cycles;
+        }
+    }
+    // code hors ROM, non découvert, ou bloc trop long pour la fin de tranche
+    return llmp16_cpu_group(vm, max_instr, slack, count);
+}
@@ -0,0 +1,72 @@
+#ifndef LLMP16_AOT_H
+#define LLMP16_AOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "llmp16.h"
+
+/*
+ * Traduction anticipée (AOT) des ROMs LLMP16
+ * ------------------------------------------
+ * build/llmp16_aot parcourt une image de ROM depuis son point d'entrée et les cibles des
+ * sauts et CALL immédiats, et écrit un fichier C avec une fonction par bloc de base. Ce
+ * fichier, compilé avec aot/llmp16_aot_run.c, donne un exécutable spécialisé pour cette ROM.
+ *
+ * À l'exécution, l'image est attachée par vm->aot. Les boucles d'exécution passent par
+ * llmp16_aot_group() dans les mêmes conditions que les superinstructions (ni profileur, ni
+ * trace, ni debugger, aucun timer) : si PC est le début d'un bloc traduit qui tient dans le
+ * quota et le budget de cycles, le bloc s'exécute d'un appel ; sinon (saut indirect vers du
+ * code non découvert, code en RAM, fin de tranche) on retombe sur l'interpréteur.
+ *
+ * Un bloc s'arrête sur un saut, un HALT, un OUT ou une instruction qui écrit PC, et rend la
+ * main juste après tout accès mémoire passé par le chemin lent : une écriture MMIO peut
+ * démarrer le blitter, le DMA ou un timer, un défaut peut arrêter le CPU. Les compteurs
+ * d'instructions et de cycles sont ceux de l'interpréteur, instruction par instruction.
+ * Un bloc qui boucle sur lui-même enchaîne ses itérations dans la même fonction tant que le
+ * quota et le budget le permettent.
+ */
+
+#define LLMP_AOT_BLOCK_MAX   64          /* instructions au plus par bloc */
+#define LLMP_AOT_RUN_MAX     (1u << 20)  /* instructions au plus par appel (borne les cycles) */
+
+/* Exécute le bloc à partir de son début ; retourne les cycles, *count les instructions */
+typedef uint32_t (*llmp16_aot_fn_t)(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count);
+
+typedef struct {
+    uint32_t pc;                           /* adresse de la première instruction */
+    uint16_t count;                        /* instructions d'un passage */
+    uint16_t head_cycles;                  /* cycles de toutes sauf la dernière */
+    llmp16_aot_fn_t run;
+} llmp16_aot_block_t;
+
+/* Produit par build/llmp16_aot dans le fichier généré (symbole llmp16_aot_image) */
+typedef struct {
+    const char *name;                      /* ROM d'origine */
+    const uint8_t *rom;                    /* image traduite, chargée en 0 */
+    uint32_t size;
+    uint32_t nb_blocks;
+    const llmp16_aot_block_t *blocks;
+} llmp16_aot_image_t;
+
+typedef struct llmp16_aot_s {
+    const llmp16_aot_image_t *image;
+    const llmp16_aot_block_t *map[LLMP_ROM_SIZE / 2];   /* bloc commençant à chaque mot de ROM */
+    uint64_t instructions;                 /* instructions exécutées par du code traduit */
+    uint64_t blocks;                       /* appels de blocs */
+} llmp16_aot_t;
+
+/* Vérifie que la ROM chargée est l'image traduite et l'attache à la VM */
+int  llmp16_aot_attach(llmp16_t *vm, const llmp16_aot_image_t *image);
+void llmp16_aot_detach(llmp16_t *vm);
+/* Même contrat que llmp16_cpu_group() */
+uint32_t llmp16_aot_group(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count);
+
+/* Vrai si l'accès 16 bits à <addr> quitte les pointeurs rapides (rd_page ou wr_page) */
+static inline bool llmp16_aot_slow(uint8_t *const *pages, uint32_t addr)
+{
+    return pages[(addr & LLMP_ADDR_MASK) >> LLMP_PAGE_SHIFT] == NULL
+        || pages[((addr + 1) & LLMP_ADDR_MASK) >> LLMP_PAGE_SHIFT] == NULL;
+}
+
+#endif // LLMP16_AOT_H
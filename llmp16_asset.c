@@ -0,0 +1,73 @@
+#include "llmp16_asset.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int llmp16_asset_load(llmp16_t *vm, const char *path, uint32_t addr)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        perror("Asset open error");
+        return -1;
+    }
+    addr &= LLMP_ADDR_MASK;
+    size_t n = fread(vm->memory + addr, 1, LLMP_MEM_SIZE - addr, f);
+    bool more = fgetc(f) != EOF;
+    fclose(f);
+    if (n < sizeof(llmp16_asset_header_t) || memcmp(vm->memory + addr, LLMP_ASSET_MAGIC, 8) != 0) {
+        fprintf(stderr, "Asset : %s n'est pas un paquet LLMP16\n", path);
+        return -1;
+    }
+    if (more) {
+        fprintf(stderr, "Asset : %s dépasse la mémoire à partir de 0x%05X\n", path, addr);
+        return -1;
+    }
+    return 0;
+}
+
+int llmp16_asset_find(const llmp16_t *vm, uint32_t base, const char *name, llmp16_asset_entry_t *entry)
+{
+    llmp16_asset_header_t header;
+    base &= LLMP_ADDR_MASK;
+    if (base + sizeof(header) > LLMP_MEM_SIZE) return -1;
+    memcpy(&header, vm->memory + base, sizeof(header));
+    if (memcmp(header.magic, LLMP_ASSET_MAGIC, sizeof(header.magic)) != 0 || base + header.size > LLMP_MEM_SIZE)
+        return -1;
+
+    for (uint32_t i = 0; i < header.count; i++) {
+        uint32_t at = sizeof(header) + i * sizeof(llmp16_asset_entry_t);
+        if (at + sizeof(llmp16_asset_entry_t) > header.size) return -1;
+        memcpy(entry, vm->memory + base + at, sizeof(*entry));
+        if (strncmp(entry->name, name, LLMP_ASSET_NAME) == 0)
+            return (uint64_t)entry->offset + entry->size <= header.size ? 0 : -1;
+    }
+    return -1;
+}
+
+int llmp16_asset_to_vram(llmp16_t *vm, uint32_t base, const char *name, uint16_t dst)
+{
+    llmp16_asset_entry_t entry;
+    if (llmp16_asset_find(vm, base, name, &entry) != 0) {
+        fprintf(stderr, "Asset : %s absent du paquet en 0x%05X\n", name, base & LLMP_ADDR_MASK);
+        return -1;
+    }
+    // la palette éventuelle reste en mémoire, seuls les pixels vont en VRAM
+    uint32_t size = entry.kind == LLMP_ASSET_IMAGE ? (uint32_t)entry.width * entry.height : entry.size;
+    uint32_t src = (base + entry.offset) & LLMP_ADDR_MASK;
+
+    // mêmes registres que le programme invité, un transfert par tranche de LLMP_ASSET_DMA_MAX
+    uint16_t *io = vm->IO[LLMP_DMA_PORT];
+    for (uint32_t done = 0; done < size; done += LLMP_ASSET_DMA_MAX) {
+        uint32_t count = size - done < LLMP_ASSET_DMA_MAX ? size - done : LLMP_ASSET_DMA_MAX;
+        uint32_t from = (src + done) & LLMP_ADDR_MASK;
+        io[LLMP_DMA_REG_SRC] = (uint16_t)from;
+        io[LLMP_DMA_REG_DST] = (uint16_t)(dst + done);
+        io[LLMP_DMA_REG_CNT] = (uint16_t)count;
+        io[LLMP_DMA_REG_HI] = (uint16_t)(from >> 16);
+        io[LLMP_DMA_REG_STAT] = 0;
+        io[LLMP_DMA_REG_CTRL] = DMA_CTRL_ENABLE;
+        llmp16_dma_step(vm, &vm->dma);
+        if (io[LLMP_DMA_REG_STAT] & DMA_STAT_ERROR) return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+#ifndef LLMP16_ASSET_H
+#define LLMP16_ASSET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "llmp16.h"
+
+/*
+ * Paquets d'assets
+ * ----------------
+ * Produits par build/llmp16_asset à partir d'images PPM, chargés dans la mémoire de la VM
+ * (embarqués dans la ROM, ou copiés en RAM par main -A) puis envoyés en VRAM par le DMA.
+ *
+ * Paquet : llmp16_asset_header_t, <count> entrées llmp16_asset_entry_t (le répertoire), puis
+ * les données. Les offsets partent du début du paquet. Types d'entrée :
+ *   IMAGE   : width x height pixels RGB332, ligne par ligne ; si <colors> != 0, l'image a été
+ *             réduite à une palette et ses <colors> couleurs (RGB332) suivent les pixels
+ *   GLYPHS  : cellules 8x8 en 1 bpp (8 octets, bit 7 = pixel de gauche) prises de gauche à
+ *             droite puis de haut en bas, au format du blitter en mode bit (BLT_CTRL_BITMODE)
+ *
+ * Le répertoire se lit aussi depuis le programme invité : pour copier une IMAGE en VRAM, il
+ * programme le port 7 avec SRC = base + offset (bits 19..16 dans HI), COUNT <= 0x8000 par
+ * transfert. Tous les champs sont little-endian.
+ */
+
+#define LLMP_ASSET_MAGIC   "LLMPPAK1"
+#define LLMP_ASSET_BASE    0x40000     /* adresse de chargement par défaut en RAM */
+#define LLMP_ASSET_NAME    16          /* nom terminé par un zéro */
+#define LLMP_ASSET_DMA_MAX 0x8000      /* octets par transfert DMA */
+
+enum {
+    LLMP_ASSET_IMAGE  = 1,
+    LLMP_ASSET_GLYPHS = 2
+};
+
+typedef struct {
+    char     magic[8];
+    uint16_t count;                    /* entrées du répertoire */
+    uint16_t pad;
+    uint32_t size;                     /* taille totale du paquet */
+} llmp16_asset_header_t;
+
+typedef struct {
+    char     name[LLMP_ASSET_NAME];
+    uint8_t  kind;
+    uint8_t  pad;
+    uint16_t colors;                   /* IMAGE : couleurs de la palette qui suit (0 = RGB332 direct) */
+    uint16_t width, height;
+    uint32_t offset;
+    uint32_t size;                     /* octets de données, palette comprise */
+} llmp16_asset_entry_t;
+
+/* Copie le fichier <path> dans la mémoire de la VM en <addr> (sans passer par la protection
+   de la ROM, comme llmp16_rom_load) */
+int llmp16_asset_load(llmp16_t *vm, const char *path, uint32_t addr);
+/* Cherche <name> dans le paquet chargé en <base> ; -1 si absent ou paquet invalide */
+int llmp16_asset_find(const llmp16_t *vm, uint32_t base, const char *name, llmp16_asset_entry_t *entry);
+/* Envoie les pixels de l'IMAGE <name> en VRAM (banc 0, adresse <dst>) par le DMA du port 7 */
+int llmp16_asset_to_vram(llmp16_t *vm, uint32_t base, const char *name, uint16_t dst);
+
+#endif // LLMP16_ASSET_H
@@ -3,7 +3,18 @@
 // largeur de l'écran en pixels
 #define LLMP_SCREEN_WIDTH   320
 
-void llmp16_blitter_step(llmp16_t *vm) {
+#define EXPAND_BIT(b, i) (((b) >> (7 - (i)) & 1) ? 0xFF : 0x00)
+#define EXPAND_1(b)  { EXPAND_BIT(b, 0), EXPAND_BIT(b, 1), EXPAND_BIT(b, 2), EXPAND_BIT(b, 3), \
+                       EXPAND_BIT(b, 4), EXPAND_BIT(b, 5), EXPAND_BIT(b, 6), EXPAND_BIT(b, 7) }
+#define EXPAND_4(b)  EXPAND_1(b), EXPAND_1((b) + 1), EXPAND_1((b) + 2), EXPAND_1((b) + 3)
+#define EXPAND_16(b) EXPAND_4(b), EXPAND_4((b) + 4), EXPAND_4((b) + 8), EXPAND_4((b) + 12)
+#define EXPAND_64(b) EXPAND_16(b), EXPAND_16((b) + 16), EXPAND_16((b) + 32), EXPAND_16((b) + 48)
+
+// en lecture seule, la table ne gêne pas la réentrance
+const uint8_t llmp16_bit_expand[256][8] = { EXPAND_64(0), EXPAND_64(64), EXPAND_64(128), EXPAND_64(192) };
+
+/* Exécute le blit demandé, retourne les cycles pendant lesquels le CPU attend le blitter */
+uint32_t llmp16_blitter_step(llmp16_t *vm) {
     uint16_t src   = vm->IO[LLMP_BLT_PORT][LLMP_BLT_REG_SRC];
     uint16_t x     = vm->IO[LLMP_BLT_PORT][LLMP_BLT_REG_X];
     uint16_t y     = vm->IO[LLMP_BLT_PORT][LLMP_BLT_REG_Y];
@@ -12,7 +23,7 @@ void llmp16_blitter_step(llmp16_t *vm) {
     uint16_t ctrl  = vm->IO[LLMP_BLT_PORT][LLMP_BLT_REG_CTRL];
 
     if (!(ctrl & BLT_CTRL_START))
-        return;
+        return 0;
 
     bool bitmode = (ctrl & BLT_CTRL_BITMODE) != 0;
 
@@ -27,25 +38,22 @@ void llmp16_blitter_step(llmp16_t *vm) {
             memcpy(dstptr, srcptr, w);
 
         } else {
-            static uint8_t expand[256][8];
-            // à l’initialisation du module :
-            for(int b=0; b<256; b++){
-            for(int i=0; i<8; i++){
-                expand[b][i] = (b & (0x80>>i)) ? 0xFF : 0x00;
-            }
-            }
-
-            // puis, dans la boucle :
+            // chaque bit source donne un pixel 0x00 ou 0xFF
             uint16_t bytesPerRow = w/8;
             uint8_t* dst  = vm->VRAM + vram_base;
             uint8_t* srcb = vm->memory + src + row*bytesPerRow;
             for(uint16_t k=0; k<bytesPerRow; k++){
-            memcpy(dst + k*8, expand[srcb[k]], 8);
+                memcpy(dst + k*8, llmp16_bit_expand[srcb[k]], 8);
             }
 
         }
     }
 
+    vm->stats.blits++;
+    vm->stats.blit_pixels += (uint32_t)w * h;
+    vm->stats.vram_writes += (uint32_t)w * h;
+
     // on nettoie START pour ne pas relancer
     vm->IO[LLMP_BLT_PORT][LLMP_BLT_REG_CTRL] &= ~(BLT_CTRL_START);
+    return ((uint32_t)w * h + LLMP_BLT_PIXELS_PER_CYCLE - 1) / LLMP_BLT_PIXELS_PER_CYCLE;
 }
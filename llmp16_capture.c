@@ -0,0 +1,321 @@
+#include "llmp16_capture.h"
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+
+#define CAPTURE_IMAGE_SIZE (LLMP_SCREEN_WIDTH * LLMP_SCREEN_HEIGHT)
+#define CAPTURE_MIN_SKIP   4    /* plus court, un passage inchangé reste dans le littéral */
+#define CAPTURE_MIN_FILL   4
+
+
+/*============================== Codage ==============================*/
+
+static uint8_t *put_token(uint8_t *p, uint32_t count, uint32_t op)
+{
+    uint32_t v = count << 2 | op;
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+/* Pixels égaux à l'image précédente à partir de <i>, comparés 8 par 8 */
+static uint32_t same_run(const uint8_t *a, const uint8_t *b, uint32_t i)
+{
+    uint32_t j = i;
+    for (; j + 8 <= CAPTURE_IMAGE_SIZE; j += 8) {
+        uint64_t x, y;
+        memcpy(&x, a + j, 8);
+        memcpy(&y, b + j, 8);
+        if (x != y) break;
+    }
+    while (j < CAPTURE_IMAGE_SIZE && a[j] == b[j]) j++;
+    return j - i;
+}
+
+static uint32_t fill_run(const uint8_t *a, uint32_t i)
+{
+    uint32_t j = i + 1;
+    while (j < CAPTURE_IMAGE_SIZE && a[j] == a[i]) j++;
+    return j - i;
+}
+
+uint32_t llmp16_capture_encode(const uint8_t *image, const uint8_t *prev, uint8_t *out)
+{
+    uint8_t *p = out;
+    uint32_t i = 0, lit = 0, nlit = 0;
+
+    while (i < CAPTURE_IMAGE_SIZE) {
+        uint32_t skip = same_run(image, prev, i);
+        uint32_t fill = skip >= CAPTURE_MIN_SKIP || i + skip == CAPTURE_IMAGE_SIZE ? 0 : fill_run(image, i);
+        if (skip < CAPTURE_MIN_SKIP && i + skip < CAPTURE_IMAGE_SIZE && fill < CAPTURE_MIN_FILL) {
+            if (nlit++ == 0) lit = i;
+            i++;
+            continue;
+        }
+        if (nlit) {
+            p = put_token(p, nlit, CAPTURE_COPY);
+            memcpy(p, image + lit, nlit);
+            p += nlit;
+            nlit = 0;
+        }
+        if (fill) {
+            p = put_token(p, fill, CAPTURE_FILL);
+            *p++ = image[i];
+            i += fill;
+        } else {
+            p = put_token(p, skip, CAPTURE_SKIP);
+            i += skip;
+        }
+    }
+    if (nlit) {
+        p = put_token(p, nlit, CAPTURE_COPY);
+        memcpy(p, image + lit, nlit);
+        p += nlit;
+    }
+    return (uint32_t)(p - out);
+}
+
+int llmp16_capture_decode(const uint8_t *in, uint32_t size, uint8_t *image)
+{
+    const uint8_t *p = in, *end = in + size;
+    uint32_t at = 0;
+
+    while (p < end) {
+        uint32_t v = 0;
+        int shift = 0;
+        do {
+            if (p == end || shift > 28) return -1;
+            v |= (uint32_t)(*p & 0x7F) << shift;
+            shift += 7;
+        } while (*p++ & 0x80);
+
+        uint32_t count = v >> 2;
+        if (count > CAPTURE_IMAGE_SIZE - at) return -1;
+        switch (v & 3) {
+        case CAPTURE_SKIP:
+            break;
+        case CAPTURE_COPY:
+            if ((uint32_t)(end - p) < count) return -1;
+            memcpy(image + at, p, count);
+            p += count;
+            break;
+        case CAPTURE_FILL:
+            if (p == end) return -1;
+            memset(image + at, *p++, count);
+            break;
+        default:
+            return -1;
+        }
+        at += count;
+    }
+    return 0;
+}
+
+int llmp16_capture_write_ppm(FILE *f, const uint8_t *image)
+{
+    uint8_t rgb[256][3], line[LLMP_SCREEN_WIDTH * 3];
+    for (int p = 0; p < 256; p++) {
+        rgb[p][0] = (uint8_t)((p >> 5) * 255 / 7);
+        rgb[p][1] = (uint8_t)(((p >> 2) & 7) * 255 / 7);
+        rgb[p][2] = (uint8_t)((p & 3) * 255 / 3);
+    }
+
+    fprintf(f, "P6\n%d %d\n255\n", LLMP_SCREEN_WIDTH, LLMP_SCREEN_HEIGHT);
+    for (int y = 0; y < LLMP_SCREEN_HEIGHT; y++) {
+        const uint8_t *src = image + y * LLMP_SCREEN_WIDTH;
+        for (int x = 0; x < LLMP_SCREEN_WIDTH; x++) memcpy(line + 3 * x, rgb[src[x]], 3);
+        if (fwrite(line, 1, sizeof(line), f) != sizeof(line)) return -1;
+    }
+    return ferror(f) ? -1 : 0;
+}
+
+
+/*============================== Thread d'encodage ==============================*/
+
+/* Écrit une image ; rend le nombre d'octets écrits, 0 en cas d'erreur */
+static uint64_t write_frame(llmp16_capture_t *cap, const uint8_t *image, uint64_t cycles)
+{
+    switch (cap->kind) {
+    case LLMP_CAPTURE_RAW: {
+        llmp16_capture_rec_t rec = { cycles, llmp16_capture_encode(image, cap->prev, cap->tokens), 0 };
+        memcpy(cap->prev, image, CAPTURE_IMAGE_SIZE);
+        if (fwrite(&rec, sizeof(rec), 1, cap->out) != 1 || fwrite(cap->tokens, 1, rec.size, cap->out) != rec.size)
+            return 0;
+        return sizeof(rec) + rec.size;
+    }
+    case LLMP_CAPTURE_PPM: {
+        char path[512];
+        snprintf(path, sizeof(path), cap->pattern, (unsigned)cap->frames);
+        FILE *f = fopen(path, "wb");
+        if (f == NULL) return 0;
+        int ret = llmp16_capture_write_ppm(f, image);
+        if (fclose(f) != 0 || ret != 0) return 0;
+        return CAPTURE_IMAGE_SIZE * 3;
+    }
+    default:
+        return llmp16_capture_write_ppm(cap->out, image) == 0 ? CAPTURE_IMAGE_SIZE * 3 : 0;
+    }
+}
+
+static void *capture_main(void *arg)
+{
+    llmp16_capture_t *cap = (llmp16_capture_t *)arg;
+
+    pthread_mutex_lock(&cap->lock);
+    for (;;) {
+        while (cap->count == 0 && !cap->stop) pthread_cond_wait(&cap->ready, &cap->lock);
+        if (cap->count == 0) break;
+        uint32_t slot = cap->head;
+        pthread_mutex_unlock(&cap->lock);
+
+        // le slot de tête n'est pas réécrit tant qu'il est compté dans <count>
+        uint64_t bytes = 0;
+        if (cap->errors == 0) {
+            bytes = write_frame(cap, cap->queue + (size_t)slot * CAPTURE_IMAGE_SIZE, cap->cycles[slot]);
+            if (bytes == 0) perror("Capture write error");
+            cap->frames += bytes != 0;
+            cap->bytes += bytes;
+        }
+
+        pthread_mutex_lock(&cap->lock);
+        if (bytes == 0) cap->errors++;
+        cap->head = (cap->head + 1) % LLMP_CAPTURE_QUEUE;
+        cap->count--;
+        pthread_cond_signal(&cap->space);
+    }
+    pthread_mutex_unlock(&cap->lock);
+    return NULL;
+}
+
+
+/*============================== API ==============================*/
+
+static void release(llmp16_capture_t *cap)
+{
+    if (cap->out != NULL) {
+        if (cap->kind == LLMP_CAPTURE_PIPE) pclose(cap->out);
+        else fclose(cap->out);
+    }
+    free(cap->queue);
+    free(cap->prev);
+    free(cap->tokens);
+    cap->queue = cap->prev = cap->tokens = NULL;
+    cap->out = NULL;
+}
+
+/* Recopie le motif PPM s'il contient exactement une conversion entière (%u, %05d...) et
+   aucune autre hors %% ; la conversion devient %u pour le numéro d'image */
+static int copy_pattern(char *dst, size_t size, const char *target)
+{
+    int conversions = 0;
+    size_t len = strlen(target);
+    if (len >= size) return -1;
+    memcpy(dst, target, len + 1);
+    for (char *p = dst; *p != '\0'; p++) {
+        if (*p != '%') continue;
+        if (p[1] == '%') {
+            p++;
+            continue;
+        }
+        p++;
+        while (*p == '0' || *p == '-') p++;
+        while (*p >= '0' && *p <= '9') p++;
+        if (*p != 'u' && *p != 'd' && *p != 'i') return -1;
+        *p = 'u';
+        conversions++;
+    }
+    return conversions == 1 ? 0 : -1;
+}
+
+int llmp16_capture_open(llmp16_capture_t *cap, const char *target)
+{
+    memset(cap, 0, sizeof(*cap));
+
+    if (target[0] == '|') {
+        cap->kind = LLMP_CAPTURE_PIPE;
+        signal(SIGPIPE, SIG_IGN);           // un encodeur qui s'arrête donne une erreur d'écriture
+        cap->out = popen(target + 1, "w");
+    } else if (strchr(target, '%') != NULL) {
+        cap->kind = LLMP_CAPTURE_PPM;
+        if (copy_pattern(cap->pattern, sizeof(cap->pattern), target) != 0) {
+            fprintf(stderr, "Capture : le motif %s doit contenir une seule conversion entière (%%u, %%05u...)\n", target);
+            return -1;
+        }
+    } else {
+        cap->kind = LLMP_CAPTURE_RAW;
+        cap->out = fopen(target, "wb");
+    }
+    if (cap->kind != LLMP_CAPTURE_PPM && cap->out == NULL) {
+        perror("Capture open error");
+        return -1;
+    }
+
+    cap->queue = (uint8_t *)malloc((size_t)LLMP_CAPTURE_QUEUE * CAPTURE_IMAGE_SIZE);
+    if (cap->kind == LLMP_CAPTURE_RAW) {
+        cap->prev = (uint8_t *)calloc(1, CAPTURE_IMAGE_SIZE);
+        cap->tokens = (uint8_t *)malloc(2 * CAPTURE_IMAGE_SIZE + 16);
+    }
+    if (cap->queue == NULL || (cap->kind == LLMP_CAPTURE_RAW && (cap->prev == NULL || cap->tokens == NULL))) {
+        perror("Capture alloc error");
+        release(cap);
+        return -1;
+    }
+    if (cap->kind == LLMP_CAPTURE_RAW) {
+        llmp16_capture_header_t header = { { 0 }, LLMP_SCREEN_WIDTH, LLMP_SCREEN_HEIGHT, FRAME_RATE, 0 };
+        memcpy(header.magic, LLMP_CAPTURE_MAGIC, sizeof(header.magic));
+        fwrite(&header, sizeof(header), 1, cap->out);
+    }
+
+    pthread_mutex_init(&cap->lock, NULL);
+    pthread_cond_init(&cap->ready, NULL);
+    pthread_cond_init(&cap->space, NULL);
+    if (pthread_create(&cap->thread, NULL, capture_main, cap) != 0) {
+        perror("Capture thread error");
+        pthread_mutex_destroy(&cap->lock);
+        pthread_cond_destroy(&cap->ready);
+        pthread_cond_destroy(&cap->space);
+        release(cap);
+        return -1;
+    }
+    return 0;
+}
+
+void llmp16_capture_push(llmp16_capture_t *cap, const uint8_t *image, uint64_t cycles)
+{
+    pthread_mutex_lock(&cap->lock);
+    if (cap->errors) {
+        pthread_mutex_unlock(&cap->lock);
+        return;
+    }
+    if (cap->count == LLMP_CAPTURE_QUEUE) {
+        cap->stalls++;
+        while (cap->count == LLMP_CAPTURE_QUEUE) pthread_cond_wait(&cap->space, &cap->lock);
+    }
+    uint32_t slot = (cap->head + cap->count) % LLMP_CAPTURE_QUEUE;
+    pthread_mutex_unlock(&cap->lock);
+
+    // seul ce thread ajoute des images : le slot reste libre hors du verrou
+    memcpy(cap->queue + (size_t)slot * CAPTURE_IMAGE_SIZE, image, CAPTURE_IMAGE_SIZE);
+    cap->cycles[slot] = cycles;
+
+    pthread_mutex_lock(&cap->lock);
+    cap->count++;
+    pthread_cond_signal(&cap->ready);
+    pthread_mutex_unlock(&cap->lock);
+}
+
+void llmp16_capture_close(llmp16_capture_t *cap)
+{
+    pthread_mutex_lock(&cap->lock);
+    cap->stop = true;
+    pthread_cond_signal(&cap->ready);
+    pthread_mutex_unlock(&cap->lock);
+    pthread_join(cap->thread, NULL);
+    pthread_mutex_destroy(&cap->lock);
+    pthread_cond_destroy(&cap->ready);
+    pthread_cond_destroy(&cap->space);
+    release(cap);
+}
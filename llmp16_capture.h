@@ -0,0 +1,97 @@
+#ifndef LLMP16_CAPTURE_H
+#define LLMP16_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <pthread.h>
+#include "llmp16.h"
+
+/*
+ * Capture des images présentées
+ * -----------------------------
+ * Chaque image passée à llmp16_video_present() est copiée dans une file, puis encodée et écrite
+ * par un thread dédié : l'émulation ne fait qu'une copie de 64000 octets par image. La cible
+ * choisit le format :
+ *   "sortie.cap"           flux brut compressé (voir plus bas), relu par build/llmp16_capdump
+ *   "images/f_%05u.ppm"    une image PPM (P6) par frame, le motif reçoit le numéro d'image
+ *   "|commande"            flux d'images PPM concaténées sur l'entrée d'un encodeur externe,
+ *                          par exemple "|ffmpeg -f image2pipe -framerate 60 -i - out.mp4"
+ * Aucune image n'est perdue : si l'encodeur prend plus de LLMP_CAPTURE_QUEUE images de retard,
+ * l'émulation l'attend (compté dans <stalls>).
+ *
+ * Flux brut : llmp16_capture_header_t puis, par image, llmp16_capture_rec_t et <size> octets de
+ * jetons codant l'image par rapport à la précédente (la première par rapport à une image
+ * noire). Un jeton est un entier variable (7 bits par octet, bit 7 = suite) valant
+ * count << 2 | op :
+ *   op 0 : <count> pixels inchangés
+ *   op 1 : <count> pixels, donnés à la suite
+ *   op 2 : <count> fois le pixel donné à la suite
+ * Tous les champs sont little-endian.
+ */
+
+#define LLMP_CAPTURE_MAGIC "LLMPCAP1"
+#define LLMP_CAPTURE_QUEUE 64            /* images d'avance sur l'encodeur, ~4 Mo */
+
+typedef enum {
+    LLMP_CAPTURE_RAW,
+    LLMP_CAPTURE_PPM,
+    LLMP_CAPTURE_PIPE
+} llmp16_capture_kind_t;
+
+enum {
+    CAPTURE_SKIP = 0,
+    CAPTURE_COPY = 1,
+    CAPTURE_FILL = 2
+};
+
+typedef struct {
+    char     magic[8];
+    uint32_t width, height;              /* pixels RGB332 */
+    uint32_t rate;                       /* images par seconde invitée (FRAME_RATE) */
+    uint32_t pad;
+} llmp16_capture_header_t;
+
+typedef struct {
+    uint64_t cycles;                     /* vm->stats.cycles à la présentation */
+    uint32_t size;                       /* octets de jetons qui suivent */
+    uint32_t pad;
+} llmp16_capture_rec_t;
+
+typedef struct llmp16_capture_s {
+    uint8_t kind;                        /* llmp16_capture_kind_t */
+    FILE *out;                           /* flux brut ou tube ; NULL en mode PPM */
+    char pattern[256];                   /* motif des fichiers PPM */
+
+    uint8_t *queue;                      /* LLMP_CAPTURE_QUEUE images */
+    uint64_t cycles[LLMP_CAPTURE_QUEUE];
+    uint32_t head, count;                /* première image à encoder, images en attente */
+    pthread_mutex_t lock;
+    pthread_cond_t ready, space;
+    pthread_t thread;
+    bool stop;
+
+    uint8_t *prev;                       /* flux brut : image précédente */
+    uint8_t *tokens;                     /* flux brut : jetons de l'image courante */
+
+    uint64_t frames;                     /* images écrites */
+    uint64_t bytes;                      /* octets écrits */
+    uint64_t stalls;                     /* attentes de l'émulation sur la file pleine */
+    uint64_t errors;                     /* écritures en échec, la capture s'arrête à la première */
+} llmp16_capture_t;
+
+/* Ouvre la cible et lance le thread d'encodage ; ne fait pas l'attache (vm->capture) */
+int  llmp16_capture_open(llmp16_capture_t *cap, const char *target);
+/* Met <image> dans la file, appelé par llmp16_video_present() */
+void llmp16_capture_push(llmp16_capture_t *cap, const uint8_t *image, uint64_t cycles);
+/* Encode les images en attente, arrête le thread et ferme la cible (après un open réussi) */
+void llmp16_capture_close(llmp16_capture_t *cap);
+
+/* Encode <image> par rapport à <prev> dans <out> (au plus 2 octets par pixel), rend la taille */
+uint32_t llmp16_capture_encode(const uint8_t *image, const uint8_t *prev, uint8_t *out);
+/* Applique <size> octets de jetons à <image> (l'image précédente), -1 si le flux est corrompu */
+int llmp16_capture_decode(const uint8_t *in, uint32_t size, uint8_t *image);
+/* Écrit une image RGB332 en PPM binaire (P6) */
+int llmp16_capture_write_ppm(FILE *f, const uint8_t *image);
+
+#endif // LLMP16_CAPTURE_H
@@ -0,0 +1,388 @@
+#include "llmp16_debug.h"
+#include "llmp16_rewind.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_SKIP 0xFFFFFFFFu
+#define DEBUG_PROT (LLMP_PROT_BREAK | LLMP_PROT_READ | LLMP_PROT_WRITE)
+
+static bool is_break(const llmp16_debug_t *dbg, uint32_t addr)
+{
+    for (int i = 0; i < dbg->nb_bp; i++)
+        if (dbg->bp[i] == addr) return true;
+    return false;
+}
+
+/* Recalcule les protections de toutes les pages à partir des points d'arrêt */
+static void protect(llmp16_t *vm)
+{
+    uint8_t prot[LLMP_PAGES] = { 0 };
+    uint8_t vprot[LLMP_VRAM_PAGES] = { 0 };
+    const llmp16_debug_t *dbg = vm->debug;
+
+    if (dbg != NULL) {
+        for (int i = 0; i < dbg->nb_bp; i++)
+            prot[dbg->bp[i] >> LLMP_PAGE_SHIFT] |= LLMP_PROT_BREAK;
+
+        for (int i = 0; i < dbg->nb_wp; i++) {
+            const llmp16_watch_t *w = &dbg->wp[i];
+            uint8_t bits = ((w->access & LLMP_WATCH_R) ? LLMP_PROT_READ : 0) |
+                           ((w->access & LLMP_WATCH_W) ? LLMP_PROT_WRITE : 0);
+            if (w->space == LLMP_WATCH_MEM) {
+                for (uint32_t p = w->lo >> LLMP_PAGE_SHIFT; p <= (w->hi - 1) >> LLMP_PAGE_SHIFT; p++)
+                    prot[p] |= bits;
+            } else if (w->space == LLMP_WATCH_VRAM) {
+                for (uint32_t p = w->lo >> LLMP_PAGE_SHIFT; p <= (w->hi - 1) >> LLMP_PAGE_SHIFT; p++)
+                    vprot[p] |= bits;
+            }
+        }
+    }
+
+    for (uint32_t p = 0; p < LLMP_PAGES; p++) {
+        // les autres bits (rembobinage) ne sont pas au debugger
+        uint8_t bits = (vm->pages[p].prot & ~DEBUG_PROT) | prot[p];
+        if (vm->pages[p].prot != bits) {
+            vm->pages[p].prot = bits;
+            llmp16_mem_refresh_page(vm, p);
+        }
+    }
+    for (uint32_t p = 0; p < LLMP_VRAM_PAGES; p++)
+        llmp16_vram_protect(vm, p, vprot[p]);
+}
+
+void llmp16_debug_attach(llmp16_t *vm, llmp16_debug_t *dbg)
+{
+    memset(dbg, 0, sizeof(*dbg));
+    dbg->skip = NO_SKIP;
+    dbg->reason = LLMP_STOP_USER;      // la VM est arrêtée avant sa première instruction
+    vm->debug = dbg;
+}
+
+/* Retire tous les points d'arrêt : la VM retrouve ses pointeurs d'accès direct */
+void llmp16_debug_detach(llmp16_t *vm)
+{
+    vm->debug = NULL;
+    protect(vm);
+}
+
+
+/*============================== Points d'arrêt ==============================*/
+
+int llmp16_debug_break_add(llmp16_t *vm, uint32_t addr)
+{
+    llmp16_debug_t *dbg = vm->debug;
+    addr &= LLMP_ADDR_MASK;
+    if (is_break(dbg, addr)) return 0;
+    if (dbg->nb_bp == LLMP_DEBUG_MAX_BP) return -1;
+
+    dbg->bp[dbg->nb_bp++] = addr;
+    protect(vm);
+    return 0;
+}
+
+int llmp16_debug_break_del(llmp16_t *vm, uint32_t addr)
+{
+    llmp16_debug_t *dbg = vm->debug;
+    addr &= LLMP_ADDR_MASK;
+    for (int i = 0; i < dbg->nb_bp; i++) {
+        if (dbg->bp[i] == addr) {
+            dbg->bp[i] = dbg->bp[--dbg->nb_bp];
+            protect(vm);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int llmp16_debug_watch_add(llmp16_t *vm, llmp16_watch_space_t space, uint32_t addr, uint32_t len, uint8_t access)
+{
+    llmp16_debug_t *dbg = vm->debug;
+    uint32_t limit = space == LLMP_WATCH_MEM ? LLMP_MEM_SIZE : space == LLMP_WATCH_VRAM ? LLMP_VRAM_BANK_SIZE : 0x100;
+    if (dbg->nb_wp == LLMP_DEBUG_MAX_WP || len == 0 || addr >= limit || access == 0) return -1;
+    if (addr + len > limit) len = limit - addr;
+
+    llmp16_watch_t *w = &dbg->wp[dbg->nb_wp++];
+    w->space = space;
+    w->access = access;
+    w->lo = addr;
+    w->hi = addr + len;
+    protect(vm);
+    return 0;
+}
+
+int llmp16_debug_watch_del(llmp16_t *vm, llmp16_watch_space_t space, uint32_t addr)
+{
+    llmp16_debug_t *dbg = vm->debug;
+    for (int i = 0; i < dbg->nb_wp; i++) {
+        if (dbg->wp[i].space == space && dbg->wp[i].lo == addr) {
+            dbg->wp[i] = dbg->wp[--dbg->nb_wp];
+            protect(vm);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+
+/*============================== Hooks ==============================*/
+
+static void stop(llmp16_t *vm, llmp16_stop_reason_t reason)
+{
+    vm->debug->reason = reason;
+    vm->cpu_halted = true;
+}
+
+static void check_watch(llmp16_t *vm, llmp16_watch_space_t space, uint32_t addr, bool write, uint32_t value)
+{
+    llmp16_debug_t *dbg = vm->debug;
+    uint8_t access = write ? LLMP_WATCH_W : LLMP_WATCH_R;
+    if (dbg->reason == LLMP_STOP_WATCH) return;     // on garde le premier accès de l'instruction
+
+    for (int i = 0; i < dbg->nb_wp; i++) {
+        const llmp16_watch_t *w = &dbg->wp[i];
+        if (w->space == space && (w->access & access) && addr >= w->lo && addr < w->hi) {
+            dbg->stop_space = space;
+            dbg->stop_addr = addr;
+            dbg->stop_value = value;
+            dbg->stop_write = write;
+            stop(vm, LLMP_STOP_WATCH);
+            return;
+        }
+    }
+}
+
+uint8_t llmp16_debug_mem_read(llmp16_t *vm, uint32_t addr, uint8_t value)
+{
+    llmp16_debug_t *dbg = vm->debug;
+
+    // fetch du premier mot de l'instruction : PC n'a pas encore avancé
+    if (dbg->fetch == LLMP_FETCH_OP) {
+        uint32_t pc = llmp16_reg_get(vm, PC) & LLMP_ADDR_MASK;
+        if (!is_break(dbg, pc)) return value;
+        if (dbg->skip == pc) {
+            if (addr != pc) dbg->skip = NO_SKIP;
+            return value;
+        }
+        return addr == pc ? (uint8_t)LLMP_OP_BRK : (uint8_t)(LLMP_OP_BRK >> 8);
+    }
+    if (dbg->fetch == LLMP_FETCH_EXT) return value;     // le mot d'extension n'est pas une donnée
+
+    check_watch(vm, LLMP_WATCH_MEM, addr, false, value);
+    return value;
+}
+
+void llmp16_debug_mem_write(llmp16_t *vm, uint32_t addr, uint8_t value)
+{
+    check_watch(vm, LLMP_WATCH_MEM, addr, true, value);
+}
+
+void llmp16_debug_vram(llmp16_t *vm, uint16_t addr, bool write, uint8_t value)
+{
+    check_watch(vm, LLMP_WATCH_VRAM, addr, write, value);
+}
+
+void llmp16_debug_io(llmp16_t *vm, uint8_t port, uint8_t reg, bool write, uint16_t value)
+{
+    check_watch(vm, LLMP_WATCH_IO, (uint32_t)(port << 4) | reg, write, value);
+}
+
+void llmp16_debug_trap(llmp16_t *vm, llmp16_stop_reason_t reason)
+{
+    stop(vm, reason);
+}
+
+/* BRK lu au fetch en <pc> : s'il vient d'un breakpoint, l'instruction d'origine n'est ni
+   exécutée ni comptée (cycles, instructions, périphériques) et PC reste dessus pour la reprise */
+bool llmp16_debug_break_hit(llmp16_t *vm, uint32_t pc)
+{
+    llmp16_debug_t *dbg = vm->debug;
+    if (!is_break(dbg, pc & LLMP_ADDR_MASK)) return false;
+    llmp16_reg_set(vm, PC, pc);
+    dbg->fetch = LLMP_FETCH_BREAK;
+    stop(vm, LLMP_STOP_BREAK);
+    return true;
+}
+
+
+/*============================== Exécution ==============================*/
+
+static void resume(llmp16_t *vm)
+{
+    llmp16_debug_t *dbg = vm->debug;
+    uint32_t pc = llmp16_reg_get(vm, PC) & LLMP_ADDR_MASK;
+
+    dbg->reason = LLMP_STOP_NONE;
+    dbg->skip = is_break(dbg, pc) ? pc : NO_SKIP;
+    vm->cpu_halted = false;
+}
+
+/* Exécute une instruction, retourne la raison de l'arrêt */
+uint8_t llmp16_debug_step(llmp16_t *vm)
+{
+    llmp16_debug_t *dbg = vm->debug;
+    resume(vm);
+    llmp16_step(vm);
+
+    if (dbg->reason == LLMP_STOP_NONE)
+        dbg->reason = vm->cpu_halted ? LLMP_STOP_HALT : LLMP_STOP_STEP;
+    return dbg->reason;
+}
+
+/* Reprend l'exécution jusqu'au prochain arrêt ou pendant au plus <max_cycles> (0 = sans limite).
+   Retourne LLMP_STOP_NONE si la limite est atteinte sans arrêt : un nouvel appel poursuit alors
+   l'exécution sans franchir le breakpoint éventuellement situé sur PC. */
+uint8_t llmp16_debug_continue(llmp16_t *vm, uint64_t max_cycles)
+{
+    llmp16_debug_t *dbg = vm->debug;
+    uint64_t done = 0;
+
+    if (dbg->reason != LLMP_STOP_NONE || vm->cpu_halted) resume(vm);
+    while (!vm->cpu_halted && !vm->halted && (max_cycles == 0 || done < max_cycles))
+        done += llmp16_run_cycles(vm, CYCLES_PER_FRAME);
+
+    if (dbg->reason == LLMP_STOP_NONE && vm->cpu_halted)
+        dbg->reason = LLMP_STOP_HALT;
+    return dbg->reason;
+}
+
+
+/*============================== Console ==============================*/
+
+static const char *space_names[3] = { "mem", "vram", "io" };
+
+static void print_instr(const llmp16_t *vm, uint32_t addr, FILE *out)
+{
+    char text[48];
+    instr_t in = llmp16_decode_raw(llmp16_mem_peek16(vm, addr), llmp16_mem_peek16(vm, addr + 2));
+    llmp16_disasm(&in, text, sizeof(text));
+    fprintf(out, "%c0x%05X  %s\n", is_break(vm->debug, addr) ? '*' : ' ', addr, text);
+}
+
+void llmp16_debug_describe_stop(const llmp16_t *vm, FILE *out)
+{
+    const llmp16_debug_t *dbg = vm->debug;
+    uint32_t pc = llmp16_reg_get((llmp16_t *)vm, PC) & LLMP_ADDR_MASK;
+
+    switch (dbg->reason) {
+    case LLMP_STOP_BREAK: fprintf(out, "breakpoint\n"); break;
+    case LLMP_STOP_INT3:  fprintf(out, "INT 3\n"); break;
+    case LLMP_STOP_HALT:  fprintf(out, "HALT\n"); break;
+    case LLMP_STOP_USER:  fprintf(out, "interrompu\n"); break;
+    case LLMP_STOP_WATCH:
+        fprintf(out, "watchpoint %s : %s 0x%05X = 0x%04X\n", space_names[dbg->stop_space],
+                dbg->stop_write ? "écriture" : "lecture", dbg->stop_addr, dbg->stop_value);
+        break;
+    default: break;
+    }
+    print_instr(vm, pc, out);
+}
+
+static uint8_t parse_access(const char *s)
+{
+    if (s == NULL || *s == '\0') return LLMP_WATCH_W;
+    return (strchr(s, 'r') ? LLMP_WATCH_R : 0) | (strchr(s, 'w') ? LLMP_WATCH_W : 0);
+}
+
+static void console_help(FILE *out)
+{
+    fprintf(out,
+        "b <adr>              breakpoint          bd <adr>         supprime le breakpoint\n"
+        "w <adr> [len] [rw]   watchpoint mémoire  wv <adr> [len] [rw]  watchpoint VRAM\n"
+        "wi <port> <reg> [rw] watchpoint IO       wd mem|vram|io <adr> supprime le watchpoint\n"
+        "s [n]                pas à pas           c                continue\n"
+        "r                    registres           x <adr> [n]      mots mémoire\n"
+        "l [adr] [n]          désassemble         i                points d'arrêt\n"
+        "rs [n]               pas en arrière      rc <cycle>       revient au cycle (-b)\n"
+        "q                    quitte\n");
+}
+
+/* Console de debug en ligne de commande, lit <in> jusqu'à "q" ou EOF */
+int llmp16_debug_console(llmp16_t *vm, FILE *in, FILE *out)
+{
+    llmp16_debug_t *dbg = vm->debug;
+    char line[128], cmd[8], a3[8];
+    long a1, a2;
+
+    fprintf(out, "LLMP-16 debugger, h pour l'aide\n");
+    print_instr(vm, llmp16_reg_get(vm, PC) & LLMP_ADDR_MASK, out);
+
+    for (;;) {
+        fprintf(out, "(llmp16) ");
+        fflush(out);
+        if (fgets(line, sizeof(line), in) == NULL) break;
+
+        a1 = 0; a2 = 0; a3[0] = '\0'; cmd[0] = '\0';
+        int n = sscanf(line, "%7s %li %li %7s", cmd, &a1, &a2, a3);
+        if (n < 1) continue;
+        // "w <adr> rw" : le mode peut suivre directement l'adresse
+        if (n == 2 && sscanf(line, "%*s %*s %7s", a3) == 1) a2 = 0;
+
+        if (strcmp(cmd, "q") == 0) {
+            break;
+        } else if (strcmp(cmd, "h") == 0) {
+            console_help(out);
+        } else if (strcmp(cmd, "b") == 0 && n >= 2) {
+            if (llmp16_debug_break_add(vm, a1) != 0) fprintf(out, "trop de breakpoints\n");
+        } else if (strcmp(cmd, "bd") == 0 && n >= 2) {
+            if (llmp16_debug_break_del(vm, a1) != 0) fprintf(out, "pas de breakpoint en 0x%05lX\n", (unsigned long)a1);
+        } else if ((strcmp(cmd, "w") == 0 || strcmp(cmd, "wv") == 0) && n >= 2) {
+            llmp16_watch_space_t space = cmd[1] == 'v' ? LLMP_WATCH_VRAM : LLMP_WATCH_MEM;
+            if (llmp16_debug_watch_add(vm, space, a1, a2 ? a2 : 2, parse_access(a3)) != 0)
+                fprintf(out, "watchpoint refusé\n");
+        } else if (strcmp(cmd, "wi") == 0 && n >= 3) {
+            if (llmp16_debug_watch_add(vm, LLMP_WATCH_IO, ((a1 & 0xF) << 4) | (a2 & 0xF), 1, parse_access(a3)) != 0)
+                fprintf(out, "watchpoint refusé\n");
+        } else if (strcmp(cmd, "wd") == 0) {
+            char space[8];
+            long addr;
+            if (sscanf(line, "%*s %7s %li", space, &addr) == 2) {
+                int s = strcmp(space, "vram") == 0 ? LLMP_WATCH_VRAM : strcmp(space, "io") == 0 ? LLMP_WATCH_IO : LLMP_WATCH_MEM;
+                if (llmp16_debug_watch_del(vm, s, addr) != 0) fprintf(out, "pas de watchpoint\n");
+            }
+        } else if (strcmp(cmd, "s") == 0) {
+            long count = n >= 2 && a1 > 0 ? a1 : 1;
+            uint8_t reason = LLMP_STOP_STEP;
+            for (long i = 0; i < count && reason == LLMP_STOP_STEP; i++)
+                reason = llmp16_debug_step(vm);
+            llmp16_debug_describe_stop(vm, out);
+        } else if (strcmp(cmd, "c") == 0) {
+            llmp16_debug_continue(vm, 0);
+            llmp16_debug_describe_stop(vm, out);
+        } else if (strcmp(cmd, "rs") == 0 || (strcmp(cmd, "rc") == 0 && n >= 2)) {
+            uint64_t count = n >= 2 && a1 > 0 ? (uint64_t)a1 : 1;
+            if (count > vm->stats.instructions) count = vm->stats.instructions;
+            int r = cmd[1] == 's' ? llmp16_rewind_to_instr(vm, vm->stats.instructions - count)
+                                  : llmp16_rewind_to_cycle(vm, (uint64_t)a1);
+            if (r != 0) fprintf(out, "hors du tampon de rembobinage\n");
+            fprintf(out, "cycle %llu, instruction %llu\n", (unsigned long long)vm->stats.cycles,
+                    (unsigned long long)vm->stats.instructions);
+            print_instr(vm, llmp16_reg_get(vm, PC) & LLMP_ADDR_MASK, out);
+        } else if (strcmp(cmd, "r") == 0) {
+            llmp16_debug_dump(vm);
+        } else if (strcmp(cmd, "x") == 0 && n >= 2) {
+            long count = n >= 3 && a2 > 0 ? a2 : 8;
+            for (long i = 0; i < count; i++) {
+                if (i % 8 == 0) fprintf(out, "%s0x%05lX:", i ? "\n" : "", (unsigned long)(a1 + i * 2) & LLMP_ADDR_MASK);
+                fprintf(out, " %04X", llmp16_mem_peek16(vm, a1 + i * 2));
+            }
+            fprintf(out, "\n");
+        } else if (strcmp(cmd, "l") == 0) {
+            uint32_t addr = n >= 2 ? a1 : llmp16_reg_get(vm, PC);
+            long count = n >= 3 && a2 > 0 ? a2 : 8;
+            for (long i = 0; i < count; i++) {
+                print_instr(vm, addr & LLMP_ADDR_MASK, out);
+                addr += 2 * llmp16_instr_words(llmp16_mem_peek16(vm, addr));
+            }
+        } else if (strcmp(cmd, "i") == 0) {
+            for (int i = 0; i < dbg->nb_bp; i++)
+                fprintf(out, "breakpoint 0x%05X\n", dbg->bp[i]);
+            for (int i = 0; i < dbg->nb_wp; i++)
+                fprintf(out, "watchpoint %s [0x%05X, 0x%05X[ %s%s\n", space_names[dbg->wp[i].space],
+                        dbg->wp[i].lo, dbg->wp[i].hi,
+                        (dbg->wp[i].access & LLMP_WATCH_R) ? "r" : "", (dbg->wp[i].access & LLMP_WATCH_W) ? "w" : "");
+        } else {
+            fprintf(out, "commande inconnue, h pour l'aide\n");
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+#ifndef LLMP16_DEBUG_H
+#define LLMP16_DEBUG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "llmp16.h"
+
+/*
+ * Debugger intégré pour LLMP16
+ * ----------------------------
+ * Attaché à une VM par vm->debug. Rien n'est testé dans la boucle d'exécution :
+ *
+ * - breakpoints : la page qui contient l'adresse perd son pointeur de lecture rapide. Au fetch
+ *   de l'instruction (signalé par llmp16_cpu_cycle dans <fetch>), le chemin lent renvoie
+ *   l'opcode réservé LLMP_OP_BRK à la place du mot d'origine ; llmp16_cpu_cycle arrête alors
+ *   le CPU (cpu_halted) sans exécuter ni compter l'instruction, PC reste dessus ;
+ * - watchpoints mémoire : bits de protection LLMP_PROT_READ/WRITE sur les pages concernées,
+ *   le chemin lent compare l'adresse aux plages surveillées ;
+ * - watchpoints VRAM : mêmes bits sur les pages du banc 0 (VLD/VSTR, DMA) ;
+ * - watchpoints IO : testés dans llmp16_io_read/llmp16_io_write, qui ne sont pas sur le
+ *   chemin chaud ;
+ * - INT (INT 3) arrête le CPU sous debugger, c'est un NOP sans debugger.
+ *
+ * Un watchpoint arrête le CPU après l'instruction qui a fait l'accès. Le pas à pas tient lieu
+ * de trap flag : llmp16_debug_step() exécute une instruction sans poser de point d'arrêt.
+ */
+
+#define LLMP_OP_BRK          0x0005   /* opcode réservé substitué au fetch */
+#define LLMP_DEBUG_MAX_BP    64
+#define LLMP_DEBUG_MAX_WP    16
+
+/* Lecture en cours par llmp16_cpu_cycle, pour distinguer le fetch des accès aux données */
+#define LLMP_FETCH_NONE      0
+#define LLMP_FETCH_OP        1        /* premier mot de l'instruction */
+#define LLMP_FETCH_EXT       2        /* mot d'extension */
+#define LLMP_FETCH_BREAK     3        /* le fetch a rencontré un breakpoint : rien n'est exécuté */
+
+typedef enum {
+    LLMP_STOP_NONE = 0,
+    LLMP_STOP_STEP,
+    LLMP_STOP_BREAK,
+    LLMP_STOP_INT3,
+    LLMP_STOP_WATCH,
+    LLMP_STOP_HALT,
+    LLMP_STOP_USER     /* interruption demandée par l'hôte (Ctrl-C de GDB) */
+} llmp16_stop_reason_t;
+
+typedef enum {
+    LLMP_WATCH_MEM,
+    LLMP_WATCH_VRAM,
+    LLMP_WATCH_IO      /* lo/hi = port << 4 | registre */
+} llmp16_watch_space_t;
+
+#define LLMP_WATCH_R  0x1
+#define LLMP_WATCH_W  0x2
+
+typedef struct {
+    uint8_t  space;                    /* llmp16_watch_space_t */
+    uint8_t  access;                   /* LLMP_WATCH_R | LLMP_WATCH_W */
+    uint32_t lo, hi;                   /* plage [lo, hi[ */
+} llmp16_watch_t;
+
+typedef struct llmp16_debug_s {
+    uint32_t bp[LLMP_DEBUG_MAX_BP];
+    int nb_bp;
+    llmp16_watch_t wp[LLMP_DEBUG_MAX_WP];
+    int nb_wp;
+
+    uint32_t skip;                     /* breakpoint à franchir une fois (reprise), ~0 = aucun */
+    uint8_t  fetch;                    /* LLMP_FETCH_* */
+
+    uint8_t  reason;                   /* llmp16_stop_reason_t du dernier arrêt */
+    uint8_t  stop_space;               /* watchpoint : espace, adresse, valeur, écriture */
+    uint32_t stop_addr;
+    uint32_t stop_value;
+    bool     stop_write;
+} llmp16_debug_t;
+
+void llmp16_debug_attach(llmp16_t *vm, llmp16_debug_t *dbg);
+void llmp16_debug_detach(llmp16_t *vm);
+
+int  llmp16_debug_break_add(llmp16_t *vm, uint32_t addr);
+int  llmp16_debug_break_del(llmp16_t *vm, uint32_t addr);
+int  llmp16_debug_watch_add(llmp16_t *vm, llmp16_watch_space_t space, uint32_t addr, uint32_t len, uint8_t access);
+int  llmp16_debug_watch_del(llmp16_t *vm, llmp16_watch_space_t space, uint32_t addr);
+
+uint8_t  llmp16_debug_step(llmp16_t *vm);
+uint8_t  llmp16_debug_continue(llmp16_t *vm, uint64_t max_cycles);
+void llmp16_debug_describe_stop(const llmp16_t *vm, FILE *out);
+int  llmp16_debug_console(llmp16_t *vm, FILE *in, FILE *out);
+
+/* Appelés par le chemin lent de la mémoire, par IN/OUT, par le fetch de BRK et par INT */
+uint8_t llmp16_debug_mem_read(llmp16_t *vm, uint32_t addr, uint8_t value);
+void llmp16_debug_mem_write(llmp16_t *vm, uint32_t addr, uint8_t value);
+void llmp16_debug_vram(llmp16_t *vm, uint16_t addr, bool write, uint8_t value);
+void llmp16_debug_io(llmp16_t *vm, uint8_t port, uint8_t reg, bool write, uint16_t value);
+void llmp16_debug_trap(llmp16_t *vm, llmp16_stop_reason_t reason);
+bool llmp16_debug_break_hit(llmp16_t *vm, uint32_t pc);
+
+#endif // LLMP16_DEBUG_H
@@ -1,7 +1,56 @@
 #include "llmp16.h"
+#include "llmp16_profiler.h"
+#include "llmp16_trace.h"
+#include "llmp16_debug.h"
 #include <stdio.h>
 
-instr_t decode(llmp16_t *vm, uint16_t instr)
+/* 0x2 (arith imm), 0x4 (logic imm), 0x6 (MOVI, PUSHI, VLDI, VSTRI), 0xD (ALU 32 bits imm) :
+   un immédiat de 16 bits, étendu à 20 bits par le nibble Y pour MOVI et la classe 0xD */
+static inline bool instr_has_imm(uint8_t op_class, uint8_t t)
+{
+    return op_class == 0x2 || op_class == 0x4 || op_class == 0xD
+        || (op_class == 0x6 && (t == 0 || t == 3 || t == 5 || t == 6));
+}
+
+/* 0x6 (LDI, STRI), 0x8 (jumps imm16) : une adresse de 20 bits (nibble Y + mot suivant) */
+static inline bool instr_has_addr(uint8_t op_class, uint8_t t)
+{
+    return op_class == 0x8 || (op_class == 0x6 && (t == 1 || t == 2));
+}
+
+int llmp16_instr_words(uint16_t instr)
+{
+    uint8_t op_class = (instr >> 12) & 0x0F;
+    uint8_t t = instr & 0x0F;
+    return (instr_has_imm(op_class, t) || instr_has_addr(op_class, t)) ? 2 : 1;
+}
+
+/* Coût en cycles de chaque opcode, mot d'extension compris (voir le modèle de timing dans llmp16.h) :
+   1 cycle par mot lu, +2 par accès mémoire 16 bits, +1 par accès VRAM, +2 par accès IO,
+   MUL 4 cycles et DIV/SDIV 18 cycles ; en 32 bits, un cycle de plus par passe sur le chemin de
+   16 bits (ADDL 2, MULL 10 pour trois produits partiels, MULHL 14, DIVL 34). Les sauts pris
+   ajoutent LLMP_CYC_BRANCH_TAKEN, les instructions de bloc leur coût par octet (retourné par
+   execute). */
+static const uint8_t op_cycles[16][16] = {
+    /* 0x0 */ { 1, 1, 1, 4, 4 },                                  /* NOP HALT WFI INT IRET */
+    /* 0x1 */ { 1, 1, 4, 18, 18, 1, 1, 1, 1, 1, 1, 4 },           /* ADD .. LSL, MULH */
+    /* 0x2 */ { 2, 2, 5, 19, 19, 2, 2, 2, 2, 2, 2 },              /* ADDI .. LSLI */
+    /* 0x3 */ { 1, 1, 1, 1, 1 },                                  /* AND .. TST */
+    /* 0x4 */ { 2, 2, 2, 2 },                                     /* ANDI .. TSTI */
+    /* 0x5 */ { 1, 3, 3, 3, 3, 2, 2, 3, 3 },                      /* MOV LD STR PUSH POP VLD VSTR VLDW VSTRW */
+    /* 0x6 */ { 2, 4, 4, 4, 0, 3, 3 },                            /* MOVI LDI STRI PUSHI - VLDI VSTRI */
+    /* 0x7 */ { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 3 },       /* JUMP .. JLS, RET */
+    /* 0x8 */ { 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4 },       /* JUMPI .. JLSI, CALL */
+    /* 0x9 */ { 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3 }, /* IN */
+    /* 0xA */ { 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3 }, /* OUT */
+    /* 0xB */ { 2, 2, 2, 2 },                                     /* MCPY MFIL VFIL MCMP, hors octets */
+    /* 0xC */ { 2, 2, 10, 34, 34, 0, 0, 2, 2, 2, 2, 14, 2, 2, 2 },/* ADDL .. LSLL, MULHL, ANDL ORL XORL */
+    /* 0xD */ { 3, 3, 11, 35, 35, 0, 0, 3, 3, 3, 3, 0, 3, 3, 3 }, /* ADDLI .. LSLLI, ANDLI ORLI XORLI */
+    /* 0xE */ { 1, 1, 1, 1, 1, 1 },                               /* PADDS PSUBS PAVG PMIN PMAX PSHUF */
+};
+
+/* Décode une instruction à partir de ses mots, sans accès à la VM (traces, désassembleur) */
+instr_t llmp16_decode_raw(uint16_t instr, uint16_t ext)
 {
     instr_t d;
     d.raw      = instr;
@@ -9,31 +58,143 @@ instr_t decode(llmp16_t *vm, uint16_t instr)
     d.X        = (d.raw >>  8) & 0x0F;
     d.Y        = (d.raw >>  4) & 0x0F;
     d.t        =  d.raw        & 0x0F;
-    d.has_imm  = false;
-    d.has_addr = false;
-    d.imm      = 0;
-    d.addr = 0;
- 
-    /* 0x2 (arith imm), 0x4 (logic imm)*/                                           
-    if (d.op_class == 0x2 || d.op_class == 0x4 || (d.op_class == 0x6 && (d.t == 0 || d.t == 3 || d.t == 5 || d.t == 6)))
-    {
-        d.has_imm = true;
-        d.imm     = fetch(vm);
-    }
-
-    /* 0x6 (memory imm), 0x8 (jumps imm16) */
-    if(d.op_class == 0x8 || (d.op_class == 0x6 && (d.t == 1 || d.t == 2)))
-    {
-        d.has_addr = true;
-        
-        d.addr = ((d.raw & 0x00F0) << 12) + fetch(vm); 
-    }
+    d.has_imm  = instr_has_imm(d.op_class, d.t);
+    d.has_addr = instr_has_addr(d.op_class, d.t);
+    d.imm      = d.has_imm ? ext : 0;
+    d.addr     = d.has_addr ? ((uint32_t)(d.raw & 0x00F0) << 12) + ext : 0;
+    // opcode non défini : seulement la lecture de ses mots (0x0013 n'est pas un INT)
+    d.cycles   = llmp16_instr_valid(&d) ? op_cycles[d.op_class][d.t] : (uint8_t)(d.has_imm || d.has_addr ? 2 : 1);
 
     return d;
 }
+
+instr_t decode(llmp16_t *vm, uint16_t instr)
+{
+    uint16_t ext = 0;
+    if (llmp16_instr_words(instr) == 2)
+        ext = fetch(vm);
+
+    return llmp16_decode_raw(instr, ext);
+}
+
+/* Opcodes définis par le jeu d'instructions (un bit par valeur de t, pour chaque classe) */
+static const uint16_t valid_ops[16] = {
+    0x001F,  /* 0x0 : NOP, HALT, WFI, INT, IRET */
+    0x0FFF,  /* 0x1 : ADD .. LSL, MULH */
+    0x079F,  /* 0x2 : ADDI .. SDIVI, CMPI .. LSLI */
+    0x001F,  /* 0x3 : AND .. TST */
+    0x000F,  /* 0x4 : ANDI .. TSTI */
+    0x01FF,  /* 0x5 : MOV .. VSTR, VLDW, VSTRW */
+    0x006F,  /* 0x6 : MOVI, LDI, STRI, PUSHI, VLDI, VSTRI */
+    0x3FFF,  /* 0x7 : JUMP .. JLS, RET */
+    0x3FFF,  /* 0x8 : JUMPI .. JLSI, CALL */
+    0xFFFF,  /* 0x9 : IN */
+    0xFFFF,  /* 0xA : OUT */
+    0x000F,  /* 0xB : MCPY, MFIL, VFIL, MCMP */
+    0x7F9F,  /* 0xC : ADDL .. SDIVL, CMPL .. LSLL, MULHL, ANDL, ORL, XORL */
+    0x779F,  /* 0xD : ADDLI .. SDIVLI, CMPLI .. LSLLI, ANDLI, ORLI, XORLI */
+    0x003F,  /* 0xE : PADDS, PSUBS, PAVG, PMIN, PMAX, PSHUF */
+    0
+};
+
+/* Noms des classes pour les rapports (profileur), dans l'ordre de valid_ops */
+static const char *class_names[16] = {
+    "special", "arith", "arith_imm", "logic", "logic_imm", "mem", "mem_imm", "jump",
+    "jump_imm", "in", "out", "block", "alu32", "alu32_imm", "packed", "0xF"
+};
+
+const char *llmp16_class_name(uint8_t op_class)
+{
+    return class_names[op_class & 0x0F];
+}
+
+bool llmp16_instr_valid(const instr_t *in)
+{
+    if (in->op_class == 0x0) return in->raw <= 0x0004;
+    return (valid_ops[in->op_class] >> in->t) & 1;
+}
  
-void execute(llmp16_t *vm, instr_t in)
+/* ALU 32 bits (classes 0xC et 0xD) : RX et <b> sur toute leur largeur (R0-R7 étendus par des
+   zéros), résultat dans ACC ou RX pour les décalages, flags sur les 32 bits. Mêmes opcodes t que
+   les classes 0x1 et 0x2, plus MULHL (mot haut du produit 32x32) et AND/OR/XOR en t = C, D, E.
+   Comme en 16 bits, les décalages immédiats ne touchent que N et Z. */
+static inline void alu32(llmp16_t *vm, const instr_t *in, uint32_t b, bool imm)
 {
+    uint32_t a = llmp16_reg_get(vm, in->X);
+    uint32_t res;
+
+    switch (in->t) {
+    case 0x0: { /* ADDL */
+        uint64_t r64 = (uint64_t)a + b;
+        res = (uint32_t)r64;
+        llmp16_reg_set(vm, ACC, res);
+        flag_nz32(vm, res);
+        flag_add_cv32(vm, a, b, r64);
+        return;
+    }
+    case 0x1: /* SUBL */
+    case 0x7: { /* CMPL */
+        uint64_t r64 = (uint64_t)a - b + 0x100000000ull;
+        res = (uint32_t)r64;
+        if (in->t == 0x1) llmp16_reg_set(vm, ACC, res);
+        flag_nz32(vm, res);
+        flag_sub_cv32(vm, a, b, r64);
+        return;
+    }
+    case 0x2: /* MULL : 32 bits bas du produit */
+        res = a * b;
+        break;
+    case 0xB: /* MULHL : 32 bits hauts du produit non signé, sans forme immédiate */
+        if (imm) return;
+        res = (uint32_t)(((uint64_t)a * b) >> 32);
+        break;
+    case 0x3: /* DIVL */
+        if (b == 0) return;
+        llmp16_reg_set(vm, ACC, a / b);
+        flag_nz32(vm, a / b);
+        return;
+    case 0x4: /* SDIVL : INT32_MIN / -1 donne 0x80000000 */
+        if (b == 0) return;
+        res = b == 0xFFFFFFFFu ? 0u - a : (uint32_t)((int32_t)a / (int32_t)b);
+        llmp16_reg_set(vm, ACC, res);
+        flag_nz32(vm, res);
+        return;
+    case 0x8: /* LSRL */
+    case 0x9: /* ASRL */
+    case 0xA: { /* LSLL */
+        uint8_t s = b & 0x1F;
+        if (in->t == 0x8)      res = a >> s;
+        else if (in->t == 0x9) res = (uint32_t)((int32_t)a >> s);
+        else                   res = a << s;
+        if (!imm) {  // C = dernier bit sorti, 0 sans décalage
+            bool c = s && (in->t == 0xA ? (a >> (32 - s)) & 1 : (a >> (s - 1)) & 1);
+            flag_set(vm, FLAG_C, c);
+        }
+        llmp16_reg_set(vm, in->X, res);
+        flag_nz32(vm, res);
+        return;
+    }
+    case 0xC: /* ANDL */
+    case 0xD: /* ORL */
+    case 0xE: /* XORL */
+        res = in->t == 0xC ? a & b : in->t == 0xD ? a | b : a ^ b;
+        llmp16_reg_set(vm, ACC, res);
+        flag_nz32(vm, res);
+        return;
+    default:
+        return;
+    }
+    // MULL, MULHL : C et V effacés
+    llmp16_reg_set(vm, ACC, res);
+    flag_nz32(vm, res);
+    flag_set(vm, FLAG_C | FLAG_V, false);
+}
+
+/* Exécute une instruction décodée. Retourne les cycles à ajouter à in.cycles : le coût par
+   octet des instructions de bloc, 0 pour toutes les autres. */
+uint32_t execute(llmp16_t *vm, instr_t in)
+{
+     uint32_t extra = 0;
      switch (in.op_class)
      {
      /* ========= 0x0 – Specials ======== */
@@ -43,7 +204,11 @@ void execute(llmp16_t *vm, instr_t in)
         case 0x0000:  /* NOP */
             break;
         case 0x0001:  /* HALT */
-            llmp16_reg_set(vm, PC, llmp16_reg_get(vm, PC)-2);
+            vm->R[PC] -= 2;
+            vm->cpu_halted = true;
+            break;
+        case 0x0003:  /* INT : sous debugger, INT 3 (point d'arrêt logiciel) */
+            if (vm->debug) llmp16_debug_trap(vm, LLMP_STOP_INT3);
             break;
         default: 
             break;
@@ -87,24 +252,31 @@ void execute(llmp16_t *vm, instr_t in)
             if (denom == 0) {
                 break;
             }
-            uint16_t res = llmp16_reg_get(vm, in.X) / denom;
+            uint16_t res = (uint16_t)llmp16_reg_get(vm, in.X) / denom;   // opérandes 16 bits, comme ADD
             llmp16_reg_set(vm, ACC, res);
             flag_nz(vm, res);
             break;
         }
-        case 0x4: { /* SDIV – signed division (optional) */
-            break; // TODO
+        case 0x4: { /* SDIV : division signée, tronquée vers zéro (-32768 / -1 donne 0x8000) */
+            int16_t denom = (int16_t)llmp16_reg_get(vm, in.Y);
+            if (denom == 0) {
+                break;
+            }
+            uint16_t res = (uint16_t)((int16_t)llmp16_reg_get(vm, in.X) / denom);
+            llmp16_reg_set(vm, ACC, res);
+            flag_nz(vm, res);
+            break;
         }
-        case 0x5: { /* INC */
-            uint16_t res = llmp16_reg_get(vm, in.X) + 1;
+        case 0x5: { /* INC : sur toute la largeur du registre, pour parcourir les adresses 20 bits */
+            uint32_t res = llmp16_reg_get(vm, in.X) + 1;
             llmp16_reg_set(vm, in.X, res);
-            flag_nz(vm, res);
+            flag_nz_reg(vm, in.X, res);
             break;
         }
         case 0x6: { /* DEC */
-            uint16_t res = llmp16_reg_get(vm, in.X) - 1;
+            uint32_t res = llmp16_reg_get(vm, in.X) - 1;
             llmp16_reg_set(vm, in.X, res);
-            flag_nz(vm, res);
+            flag_nz_reg(vm, in.X, res);
             break;
         }
         case 0x7: { /* CMP */
@@ -120,7 +292,7 @@ void execute(llmp16_t *vm, instr_t in)
             uint8_t shift = llmp16_reg_get(vm, in.Y) & 0xF;
             uint16_t val = llmp16_reg_get(vm, in.X);
             uint16_t res = val >> shift;
-            flag_set(vm, FLAG_C, (val >> (shift - 1)) & 0x1);
+            flag_set(vm, FLAG_C, shift && ((val >> (shift - 1)) & 0x1));   // décalage nul : C = 0, comme LSL
             llmp16_reg_set(vm, in.X, res);
             flag_nz(vm, res);
             break;
@@ -129,7 +301,7 @@ void execute(llmp16_t *vm, instr_t in)
             uint8_t shift = llmp16_reg_get(vm, in.Y) & 0xF;
             int16_t val = (int16_t)llmp16_reg_get(vm, in.X);
             int16_t res = val >> shift;
-            flag_set(vm, FLAG_C, (uint16_t)val >> (shift - 1) & 0x1);
+            flag_set(vm, FLAG_C, shift && (((uint16_t)val >> (shift - 1)) & 0x1));
             llmp16_reg_set(vm, in.X, (uint16_t)res);
             flag_nz(vm, (uint16_t)res);
             break;
@@ -143,6 +315,14 @@ void execute(llmp16_t *vm, instr_t in)
             flag_nz(vm, res);
             break;
         }
+        case 0xB: { /* MULH : mot haut du produit non signé des 16 bits bas */
+            uint32_t r32 = (uint32_t)(uint16_t)llmp16_reg_get(vm, in.X) * (uint16_t)llmp16_reg_get(vm, in.Y);
+            uint16_t r16 = (uint16_t)(r32 >> 16);
+            llmp16_reg_set(vm, ACC, r16);
+            flag_nz(vm, r16);
+            flag_set(vm, FLAG_C | FLAG_V, false);
+            break;
+        }
         default:
             break;
         }
@@ -181,7 +361,14 @@ void execute(llmp16_t *vm, instr_t in)
         }
         case 0x3: { /* DIVI */
             if (in.imm == 0) break;
-            uint16_t res = llmp16_reg_get(vm, in.X) / in.imm;
+            uint16_t res = (uint16_t)llmp16_reg_get(vm, in.X) / in.imm;
+            llmp16_reg_set(vm, ACC, res);
+            flag_nz(vm, res);
+            break;
+        }
+        case 0x4: { /* SDIVI */
+            if (in.imm == 0) break;
+            uint16_t res = (uint16_t)((int16_t)llmp16_reg_get(vm, in.X) / (int16_t)in.imm);
             llmp16_reg_set(vm, ACC, res);
             flag_nz(vm, res);
             break;
@@ -195,6 +382,24 @@ void execute(llmp16_t *vm, instr_t in)
             flag_sub_cv(vm, a, b, r32);
             break;
         }
+        case 0x8: { /* LSRI X,imm : flags N Z seulement */
+            uint16_t res = (uint16_t)llmp16_reg_get(vm, in.X) >> (in.imm & 0xF);
+            llmp16_reg_set(vm, in.X, res);
+            flag_nz(vm, res);
+            break;
+        }
+        case 0x9: { /* ASRI X,imm */
+            int16_t res = (int16_t)llmp16_reg_get(vm, in.X) >> (in.imm & 0xF);
+            llmp16_reg_set(vm, in.X, (uint16_t)res);
+            flag_nz(vm, (uint16_t)res);
+            break;
+        }
+        case 0xA: { /* LSLI X,imm */
+            uint16_t res = (uint16_t)(llmp16_reg_get(vm, in.X) << (in.imm & 0xF));
+            llmp16_reg_set(vm, in.X, res);
+            flag_nz(vm, res);
+            break;
+        }
         default:
             break;
         }
@@ -283,13 +488,15 @@ void execute(llmp16_t *vm, instr_t in)
         case 0x2: /* STR MEM[RX] <- RY */
             mem_write16(vm, llmp16_reg_get(vm, in.X), llmp16_reg_get(vm, in.Y));
             break;
-        case 0x3: /* PUSH RX */
-            llmp16_reg_set(vm, SP, llmp16_reg_get(vm, SP)-2);
-            mem_write16(vm, llmp16_reg_get(vm, SP), llmp16_reg_get(vm, in.X));
+        case 0x3: { /* PUSH RX : SP décrémenté d'abord, PUSH SP empile la nouvelle valeur */
+            uint32_t sp = vm->R[SP] - 2;
+            vm->R[SP] = sp;
+            mem_write16(vm, sp, llmp16_reg_get(vm, in.X));
             break;
-        case 0x4: /* POP RX */
-            llmp16_reg_set(vm, in.X, mem_read16(vm, llmp16_reg_get(vm, SP)));
-            llmp16_reg_set(vm, SP, llmp16_reg_get(vm, SP)+2);
+        }
+        case 0x4: /* POP RX : SP relu après l'écriture de RX (POP SP) */
+            llmp16_reg_set(vm, in.X, mem_read16(vm, vm->R[SP]));
+            vm->R[SP] += 2;
             break;
         case 0x5: /*VLOAD*/
             llmp16_reg_set(vm, in.X, vram_read(vm, llmp16_reg_get(vm, in.Y)));
@@ -297,6 +504,18 @@ void execute(llmp16_t *vm, instr_t in)
         case 0x6: /*VSTORE*/
             vram_write(vm, llmp16_reg_get(vm, in.X), llmp16_reg_get(vm, in.Y));
             break;
+        case 0x7: { /* VLDW : deux pixels, VRAM[RY] dans l'octet bas, adresse sur 16 bits */
+            uint16_t a = llmp16_reg_get(vm, in.Y);
+            uint8_t lo = vram_read(vm, a);
+            llmp16_reg_set(vm, in.X, lo | vram_read(vm, (uint16_t)(a + 1)) << 8);
+            break;
+        }
+        case 0x8: { /* VSTRW : VRAM[RX] <- octet bas de RY, VRAM[RX + 1] <- octet haut */
+            uint16_t a = llmp16_reg_get(vm, in.X), v = llmp16_reg_get(vm, in.Y);
+            vram_write(vm, a, (uint8_t)v);
+            vram_write(vm, (uint16_t)(a + 1), (uint8_t)(v >> 8));
+            break;
+        }
         default:
             break;
         }
@@ -305,8 +524,8 @@ void execute(llmp16_t *vm, instr_t in)
     case 0x6:
         switch (in.t)
          {
-        case 0x0: /* MOVI */
-            llmp16_reg_set(vm, in.X, in.imm);
+        case 0x0: /* MOVI : le nibble Y donne les bits 19..16 (mov rX [adresse]) */
+            llmp16_reg_set(vm, in.X, ((uint32_t)in.Y << 16) | in.imm);
             break;
         case 0x1: /* LDI */
             llmp16_reg_set(vm, in.X, mem_read16(vm, in.addr));
@@ -314,10 +533,12 @@ void execute(llmp16_t *vm, instr_t in)
         case 0x2: /* STRI MEM[imm] <- RX */
             mem_write16(vm, in.addr, llmp16_reg_get(vm, in.X));
             break;
-        case 0x3: /* PUSHI Imm */
-            llmp16_reg_set(vm, SP, llmp16_reg_get(vm, SP)-2);
-            mem_write16(vm, llmp16_reg_get(vm, SP), in.imm);
+        case 0x3: { /* PUSHI Imm */
+            uint32_t sp = vm->R[SP] - 2;
+            vm->R[SP] = sp;
+            mem_write16(vm, sp, in.imm);
             break;
+        }
         case 0x5: /* VLOADI */
             llmp16_reg_set(vm, in.X, vram_read(vm, in.imm));
             break;
@@ -334,23 +555,15 @@ void execute(llmp16_t *vm, instr_t in)
         bool take = false;
         switch (in.t)
         {
-            case 0x0: take = true; break;                     /* JUMP  */
-            case 0x1: take = flag_get(vm, FLAG_Z); break;     /* JEQ   */
-            case 0x2: take = !flag_get(vm, FLAG_Z); break;    /* JNE   */
-            case 0x3: take = flag_get(vm, FLAG_C); break;     /* JCS   */
-            case 0x4: take = !flag_get(vm, FLAG_C); break;    /* JCC   */
-            case 0x5: take = flag_get(vm, FLAG_V); break;     /* JVS   */
-            case 0x6: take = !flag_get(vm, FLAG_V); break;    /* JVC   */
-            case 0x7: take = ((flag_get(vm, FLAG_N) == flag_get(vm, FLAG_V)) && !flag_get(vm, FLAG_Z)); break; /*JGT*/
-            case 0x8: take = (flag_get(vm, FLAG_N) != flag_get(vm, FLAG_V)); break; /*JLT*/
-            case 0x9: take = (flag_get(vm, FLAG_N) == flag_get(vm, FLAG_V)); break; /*JGE*/
-            case 0xA: take = ((flag_get(vm, FLAG_N) != flag_get(vm, FLAG_V)) && flag_get(vm, FLAG_Z)); break; /*JLE*/
-            case 0xB: take = (!flag_get(vm, FLAG_C) && !flag_get(vm, FLAG_Z)); break; /*JHI*/
-            case 0xC: take = (flag_get(vm, FLAG_C) && flag_get(vm, FLAG_Z)); break; /*JLS*/
-            default:
+            case 0xD: { /* RET : POP PC */
+                uint32_t sp = vm->R[SP];
+                vm->R[PC] = mem_read16(vm, sp);
+                vm->R[SP] = sp + 2;
                 break;
+            }
+            default: take = llmp16_cond(vm, in.t); break;   /* JUMP .. JLS */
         }
-        if (take) llmp16_reg_set(vm, PC, llmp16_reg_get(vm, in.X));
+        if (take) vm->R[PC] = llmp16_reg_get(vm, in.X);
         break;
      }
  
@@ -359,64 +572,131 @@ void execute(llmp16_t *vm, instr_t in)
          bool take = false;
          switch (in.t)
          {
-            case 0x0: take = true; break;                     /* JUMP  */
-            case 0x1: take = flag_get(vm, FLAG_Z); ; break;     /* JEQ   */
-            case 0x2: take = !flag_get(vm, FLAG_Z); break;    /* JNE   */
-            case 0x3: take = flag_get(vm, FLAG_C); break;     /* JCS   */
-            case 0x4: take = !flag_get(vm, FLAG_C); break;    /* JCC   */
-            case 0x5: take = flag_get(vm, FLAG_V); break;     /* JVS   */
-            case 0x6: take = !flag_get(vm, FLAG_V); break;    /* JVC   */
-            case 0x7: take = ((flag_get(vm, FLAG_N) == flag_get(vm, FLAG_V)) && !flag_get(vm, FLAG_Z)); break; /*JGT*/
-            case 0x8: take = (flag_get(vm, FLAG_N) != flag_get(vm, FLAG_V)); break; /*JLT*/
-            case 0x9: take = (flag_get(vm, FLAG_N) == flag_get(vm, FLAG_V)); break; /*JGE*/
-            case 0xA: take = ((flag_get(vm, FLAG_N) != flag_get(vm, FLAG_V)) && flag_get(vm, FLAG_Z)); break; /*JLE*/
-            case 0xB: take = (!flag_get(vm, FLAG_C) && !flag_get(vm, FLAG_Z)); break; /*JHI*/
-            case 0xC: take = (flag_get(vm, FLAG_C) && flag_get(vm, FLAG_Z)); break; /*JLS*/
-            case 0xD: /* CALL */
-                llmp16_reg_set(vm, SP, llmp16_reg_get(vm, SP)-2);
-                mem_write16(vm, llmp16_reg_get(vm, SP), llmp16_reg_get(vm, PC));
-                llmp16_reg_set(vm, PC, in.addr);
-                break;
-            default:
+            case 0xD: { /* CALL : empile les 16 bits bas du PC de retour */
+                uint32_t sp = vm->R[SP] - 2;
+                vm->R[SP] = sp;
+                mem_write16(vm, sp, (uint16_t)vm->R[PC]);
+                vm->R[PC] = in.addr;
                 break;
+            }
+            default: take = llmp16_cond(vm, in.t); break;   /* JUMPI .. JLSI */
         }
-        if (take){
-        
-         llmp16_reg_set(vm, PC, in.addr);
-        }
+        if (take) vm->R[PC] = in.addr;
         break;
      }
  
-     /* ========= 0x8 – IN RX, port(Y, t) ================== */
-     case 0x9: {
-        uint8_t port = in.Y;
-        uint8_t reg  = in.t;
-        llmp16_reg_set(vm, in.X, vm->IO[port][reg]);
-        if (port == 1) {
-        // on consomme la donnée clavier
-        vm->IO[1][0]   = 0;
+     /* ========= 0x9 – IN RX, port(Y, t) ================== */
+     case 0x9:
+        llmp16_reg_set(vm, in.X, llmp16_io_read(vm, in.Y, in.t));
+        break;
+ 
+     /* ========= 0xA – OUT RX -> port(Y,t) ================ */
+     case 0xA:
+        llmp16_io_write(vm, in.Y, in.t, llmp16_reg_get(vm, in.X));
+        break;
+
+     /* ========= 0xB – Blocs de IDX octets ================= */
+     case 0xB: {
+        // RX et RY avancent des octets traités, IDX garde ce qui reste (écrit en dernier)
+        uint32_t idx = llmp16_reg_get(vm, IDX);
+        uint32_t n = idx < LLMP_BLK_MAX ? idx : LLMP_BLK_MAX;
+        uint32_t x = llmp16_reg_get(vm, in.X), y = llmp16_reg_get(vm, in.Y);
+        switch (in.t)
+        {
+        case 0x0: /* MCPY MEM[RX..] <- MEM[RY..] */
+            llmp16_mem_move(vm, x, y, n);
+            llmp16_reg_set(vm, in.X, x + n);
+            llmp16_reg_set(vm, in.Y, y + n);
+            extra = n * LLMP_CYC_BLK_COPY;
+            break;
+        case 0x1: /* MFIL MEM[RX..] <- RY (octet bas) */
+            llmp16_mem_fill(vm, x, (uint8_t)y, n);
+            llmp16_reg_set(vm, in.X, x + n);
+            extra = n * LLMP_CYC_BLK_FILL;
+            break;
+        case 0x2: /* VFIL VRAM[RX..] <- RY (octet bas) */
+            llmp16_vram_fill(vm, (uint16_t)x, (uint8_t)y, n);
+            llmp16_reg_set(vm, in.X, x + n);
+            extra = n * LLMP_CYC_BLK_FILL;
+            break;
+        case 0x3: { /* MCMP : s'arrête sur le premier octet différent, flags de CMP sur cette paire */
+            uint8_t a = 0, b = 0;
+            uint32_t eq = llmp16_mem_compare(vm, x, y, n, &a, &b);
+            uint32_t r32 = (uint32_t)a - b + 0x10000;
+            flag_nz(vm, (uint16_t)r32);
+            flag_sub_cv(vm, a, b, r32);
+            llmp16_reg_set(vm, in.X, x + eq);
+            llmp16_reg_set(vm, in.Y, y + eq);
+            extra = (eq < n ? eq + 1 : eq) * LLMP_CYC_BLK_CMP;   // la paire différente est lue
+            n = eq;
+            break;
         }
+        default:
+            n = 0;
+            break;
+        }
+        llmp16_reg_set(vm, IDX, idx - n);
         break;
      }
- 
-     /* ========= 0x9 – OUT RX -> port(Y,t) ================ */
-     case 0xA: {
-        uint8_t port = in.Y;
-        uint8_t reg  = in.t;
-        vm->IO[port][reg] = llmp16_reg_get(vm, in.X);
- 
 
-        
+     /* ========= 0xC / 0xD – ALU 32 bits, registre ou imm20 === */
+     case 0xC:
+        alu32(vm, &in, llmp16_reg_get(vm, in.Y), false);
         break;
-    }
+     case 0xD:
+        alu32(vm, &in, ((uint32_t)in.Y << 16) | in.imm, true);
+        break;
+
+     /* ========= 0xE – Deux octets par registre (pixels) ======= */
+     case 0xE: {
+        uint16_t res;
+        if (in.t <= 0x4)      res = llmp16_packed(in.t, llmp16_reg_get(vm, in.X), llmp16_reg_get(vm, in.Y));
+        else if (in.t == 0x5) res = llmp16_shuffle(llmp16_reg_get(vm, in.X), llmp16_reg_get(vm, ACC), in.Y);  /* PSHUF X, n */
+        else break;
+        llmp16_reg_set(vm, ACC, res);
+        flag_nz(vm, res);
+        break;
+     }
      default:
         break;
      }
+     return extra;
 }
 
-void llmp16_cpu_cycle(llmp16_t *vm)
+/* Exécute une instruction et retourne le nombre de cycles qu'elle a coûté */
+uint32_t llmp16_cpu_cycle(llmp16_t *vm)
 {
-    uint16_t instr = fetch(vm);
-    instr_t in = decode(vm, instr);
-    execute(vm, in);
+    // PC reste dans un registre hôte pendant le fetch ; vm->R[PC] avance mot par mot comme
+    // avec fetch(), pour que le PC d'un défaut de lecture reste le même
+    llmp16_debug_t *dbg = vm->debug;
+    uint32_t pc = vm->R[PC];
+    uint32_t next = pc + 2;
+    if (dbg) dbg->fetch = LLMP_FETCH_OP;
+    uint16_t instr = mem_read16(vm, pc);
+    uint16_t ext = 0;
+    vm->R[PC] = next;
+    if (llmp16_instr_words(instr) == 2) {
+        if (dbg) dbg->fetch = LLMP_FETCH_EXT;
+        ext = mem_read16(vm, next);
+        next += 2;
+        vm->R[PC] = next;
+    }
+    if (dbg) {
+        dbg->fetch = LLMP_FETCH_NONE;
+        // breakpoint substitué au fetch : l'instruction n'a pas lieu, aucun cycle n'est compté
+        if (instr == LLMP_OP_BRK && llmp16_debug_break_hit(vm, pc)) return 0;
+    }
+    instr_t in = llmp16_decode_raw(instr, ext);
+    if (vm->profiler) llmp16_profiler_hook(vm->profiler, pc, &in);
+    if (vm->trace) llmp16_trace_before(vm->trace, vm, pc, &in);
+    uint32_t cycles = in.cycles + execute(vm, in);
+    if (vm->trace) llmp16_trace_after(vm->trace, vm, &in);
+
+    // un saut pris vide le prefetch : PC ne suit pas l'instruction
+    if ((in.op_class == 0x7 || in.op_class == 0x8) && vm->R[PC] != next)
+        cycles += LLMP_CYC_BRANCH_TAKEN;
+
+    vm->stats.instructions++;
+    vm->stats.cycles += cycles;
+    return cycles;
 }
@@ -0,0 +1,90 @@
+#include "llmp16.h"
+#include <stdio.h>
+
+/*
+ * Désassembleur LLMP16
+ * Produit la syntaxe de llmpasm (mnémoniques en majuscules) à partir d'une instruction décodée.
+ * Utilisé par le décodeur de traces et la console de debug.
+ */
+
+static const char *reg_names[16] = {
+    "R0", "R1", "R2", "R3", "R4", "R5", "R6", "R7",
+    "R8", "R9", "R10", "R11", "PC", "SP", "IDX", "ACC"
+};
+
+static const char *special_ops[5] = { "NOP", "HALT", "WFI", "INT", "IRET" };
+static const char *arith_ops[16] = {
+    "ADD", "SUB", "MUL", "DIV", "SDIV", "INC", "DEC", "CMP", "LSR", "ASR", "LSL", "MULH", "AND", "OR", "XOR"
+};
+static const char *logic_ops[16] = { "AND", "OR", "XOR", "NOT", "TST" };
+static const char *mem_ops[16] = { "MOV", "LD", "STR", "PUSH", "POP", "VLD", "VSTR", "VLDW", "VSTRW" };
+static const char *mem_imm_ops[16] = { "MOVI", "LDI", "STRI", "PUSHI", NULL, "VLDI", "VSTRI" };
+static const char *jump_ops[16] = {
+    "JUMP", "JEQ", "JNE", "JCS", "JCC", "JVS", "JVC", "JGT", "JLT", "JGE", "JLE", "JHI", "JLS", "RET"
+};
+static const char *block_ops[16] = { "MCPY", "MFIL", "VFIL", "MCMP" };
+static const char *packed_ops[16] = { "PADDS", "PSUBS", "PAVG", "PMIN", "PMAX", "PSHUF" };
+
+const char *llmp16_reg_name(uint8_t reg)
+{
+    return reg_names[reg & 0x0F];
+}
+
+/* Écrit le texte de l'instruction dans <buf>, retourne le nombre de caractères écrits */
+int llmp16_disasm(const instr_t *in, char *buf, size_t size)
+{
+    const char *X = reg_names[in->X];
+    const char *Y = reg_names[in->Y];
+    const char *op = NULL;
+
+    if (!llmp16_instr_valid(in))
+        return snprintf(buf, size, ".word 0x%04X", in->raw);
+
+    switch (in->op_class) {
+    case 0x0:
+        return snprintf(buf, size, "%s", special_ops[in->raw]);
+    case 0x1:
+        op = arith_ops[in->t];
+        if (in->t == 0x5 || in->t == 0x6) return snprintf(buf, size, "%s %s", op, X);
+        return snprintf(buf, size, "%s %s, %s", op, X, Y);
+    case 0x2:
+        return snprintf(buf, size, "%sI %s, 0x%04X", arith_ops[in->t], X, in->imm);
+    case 0x3:
+        op = logic_ops[in->t];
+        if (in->t == 0x3) return snprintf(buf, size, "%s %s", op, X);
+        return snprintf(buf, size, "%s %s, %s", op, X, Y);
+    case 0x4:
+        return snprintf(buf, size, "%sI %s, 0x%04X", logic_ops[in->t], X, in->imm);
+    case 0x5:
+        op = mem_ops[in->t];
+        if (in->t == 0x3 || in->t == 0x4) return snprintf(buf, size, "%s %s", op, X);
+        return snprintf(buf, size, "%s %s, %s", op, X, Y);
+    case 0x6:
+        op = mem_imm_ops[in->t];
+        if (in->t == 0x3) return snprintf(buf, size, "%s 0x%04X", op, in->imm);
+        if (in->t == 0x0 && in->Y) return snprintf(buf, size, "%s %s, 0x%05X", op, X, ((uint32_t)in->Y << 16) | in->imm);
+        if (in->has_addr) return snprintf(buf, size, "%s %s, [0x%05X]", op, X, in->addr);
+        return snprintf(buf, size, "%s %s, 0x%04X", op, X, in->imm);
+    case 0x7:
+        if (in->t == 0xD) return snprintf(buf, size, "RET");
+        return snprintf(buf, size, "%s %s", jump_ops[in->t], X);
+    case 0x8:
+        if (in->t == 0xD) return snprintf(buf, size, "CALL [0x%05X]", in->addr);
+        return snprintf(buf, size, "%sI [0x%05X]", jump_ops[in->t], in->addr);
+    case 0x9:
+        return snprintf(buf, size, "IN %s, $%X, %u", X, in->Y, in->t);
+    case 0xA:
+        return snprintf(buf, size, "OUT %s, $%X, %u", X, in->Y, in->t);
+    case 0xB:
+        return snprintf(buf, size, "%s %s, %s", block_ops[in->t], X, Y);
+    case 0xC:   /* ALU 32 bits : mnémonique 16 bits suivie de L */
+        return snprintf(buf, size, "%sL %s, %s", arith_ops[in->t], X, Y);
+    case 0xD:
+        return snprintf(buf, size, "%sLI %s, 0x%05X", arith_ops[in->t], X, ((uint32_t)in->Y << 16) | in->imm);
+    case 0xE:
+        if (in->t == 0x5) return snprintf(buf, size, "PSHUF %s, %u", X, in->Y);
+        return snprintf(buf, size, "%s %s, %s", packed_ops[in->t], X, Y);
+    default:
+        return snprintf(buf, size, ".word 0x%04X", in->raw);
+    }
+}
@@ -20,36 +20,53 @@ void llmp16_dma_cpy(llmp16_t *vm, llmp16_dma_t *dma)
         return;
     }
     
-    for (uint16_t offset = 0; offset < dma->count; offset++)
-    {
-        value = mem_read8(vm, dma->src_addr+offset);
-        vram_write(vm, dma->dst_addr+offset, value);
+    if (dma->ctrl & DMA_CTRL_MEM) {
+        // destination 20 bits, à travers la table des pages (RAM, fenêtre VRAM ou MMIO)
+        for (uint16_t offset = 0; offset < dma->count; offset++)
+            mem_write8(vm, dma->dst_addr + offset, mem_read8(vm, dma->src_addr + offset));
+    } else {
+        for (uint16_t offset = 0; offset < dma->count; offset++)
+        {
+            value = mem_read8(vm, dma->src_addr+offset);
+            vram_write(vm, (uint16_t)(dma->dst_addr+offset), value);
+        }
     }
+    vm->stats.dma_transfers++;
+    vm->stats.dma_bytes += dma->count;
 }
 
 void llmp16_dma_readIO(llmp16_t *vm, llmp16_dma_t *dma)
 {
+    uint16_t hi = vm->IO[LLMP_DMA_PORT][LLMP_DMA_REG_HI];
     dma->count = vm->IO[LLMP_DMA_PORT][LLMP_DMA_REG_CNT];
     dma->ctrl = vm->IO[LLMP_DMA_PORT][LLMP_DMA_REG_CTRL];
-    dma->dst_addr = vm->IO[LLMP_DMA_PORT][LLMP_DMA_REG_DST];
-    dma->src_addr = vm->IO[LLMP_DMA_PORT][LLMP_DMA_REG_SRC];
+    dma->dst_addr = ((uint32_t)(hi >> 4) & 0xF) << 16 | vm->IO[LLMP_DMA_PORT][LLMP_DMA_REG_DST];
+    dma->src_addr = ((uint32_t)hi & 0xF) << 16 | vm->IO[LLMP_DMA_PORT][LLMP_DMA_REG_SRC];
     dma->stat = vm->IO[LLMP_DMA_PORT][LLMP_DMA_REG_STAT];
     dma->irq_line = 0;
 }
 
 
-void llmp16_dma_step(llmp16_t *vm, llmp16_dma_t *dma)
+/* Effectue le transfert demandé, retourne les cycles volés au CPU */
+uint32_t llmp16_dma_step(llmp16_t *vm, llmp16_dma_t *dma)
 {
     llmp16_dma_readIO(vm, dma);
-    if ((dma->ctrl & DMA_CTRL_ENABLE)) {
+    if (!(dma->ctrl & DMA_CTRL_ENABLE))
+        return 0;
 
-        llmp16_dma_cpy(vm, dma);
+    llmp16_dma_cpy(vm, dma);
 
-        dma->stat |= DMA_STAT_DONE;
+    dma->stat |= DMA_STAT_DONE;
 
-        if (dma->ctrl & DMA_CTRL_IRQ_EN) {
-            dma->irq_line = true;
-            // TODO : interruputions
-        }
+    // comme pour le blitter, on nettoie ENABLE pour ne pas relancer le transfert
+    vm->IO[LLMP_DMA_PORT][LLMP_DMA_REG_CTRL] &= ~(DMA_CTRL_ENABLE);
+    vm->IO[LLMP_DMA_PORT][LLMP_DMA_REG_STAT] = dma->stat;
+
+    if (dma->ctrl & DMA_CTRL_IRQ_EN) {
+        dma->irq_line = true;
+        // TODO : interruputions
     }
+
+    if (dma->stat & DMA_STAT_ERROR) return 0;
+    return ((uint32_t)dma->count + LLMP_DMA_BYTES_PER_CYCLE - 1) / LLMP_DMA_BYTES_PER_CYCLE;
 }
\ No newline at end of file
@@ -16,6 +16,10 @@
  *   Reg 2 (R2) : COUNT             (nombre d’octets à transférer, bits 15..0)
  *   Reg 3 (R3) : CTRL              (bit 0 = DMA_ENABLE, bit 1 = IRQ_ENABLE)
  *   Reg 4 (R4) : STAT              (bit 0 = BUSY, bit 1 = DONE, bit 2 = ERROR)
+ *   Reg 5 (R5) : HI                (bits 3..0 = SRC bits 19..16, bits 7..4 = DST bits 19..16)
+ *
+ * Sans DMA_CTRL_MEM la destination est la VRAM (adresse 16 bits dans le banc 0), avec
+ * DMA_CTRL_MEM c'est une adresse mémoire de 20 bits, y compris la fenêtre VRAM/MMIO.
  */
 
 #define LLMP_DMA_PORT       7
@@ -24,11 +28,13 @@
 #define LLMP_DMA_REG_CNT    2
 #define LLMP_DMA_REG_CTRL   3
 #define LLMP_DMA_REG_STAT   4
-#define LLMP_DMA_REG_MAX    5
+#define LLMP_DMA_REG_HI     5
+#define LLMP_DMA_REG_MAX    6
 
 /* Contrôle */
 #define DMA_CTRL_ENABLE     0x01  /* Démarrer le transfert */
 #define DMA_CTRL_IRQ_EN     0x02  /* Générer une IRQ à la fin */
+#define DMA_CTRL_MEM        0x04  /* Destination en mémoire (20 bits) plutôt qu'en VRAM */
 
 /* Statut */
 #define DMA_STAT_BUSY       0x01
@@ -36,8 +42,8 @@
 #define DMA_STAT_ERROR      0x04
 
 typedef struct {
-    uint16_t src_addr;   /* Adresse source 16-bits */
-    uint16_t dst_addr;   /* Adresse destination 1--bits */
+    uint32_t src_addr;   /* Adresse source 20-bits */
+    uint32_t dst_addr;   /* Adresse destination 20-bits */
     uint16_t count;      /* Nombre d’octets à copier */
     uint8_t  ctrl;       /* Registre de contrôle */
     uint8_t  stat;       /* Registre de statut */
@@ -48,7 +54,7 @@ typedef struct {
 void llmp16_dma_init(llmp16_dma_t *dma);
 void llmp16_dma_cpy(llmp16_t *cpu, llmp16_dma_t *dma);
 void llmp16_dma_readIO(llmp16_t *cpu, llmp16_dma_t *dma);
-void llmp16_dma_step(llmp16_t *cpu, llmp16_dma_t *dma);
+uint32_t llmp16_dma_step(llmp16_t *cpu, llmp16_dma_t *dma);
 
 
 
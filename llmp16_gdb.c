@@ -0,0 +1,536 @@
+#include "llmp16_gdb.h"
+#include "llmp16_rewind.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#define GDB_NB_REGS   17     /* R0-R15 puis FLAGS */
+#define GDB_REG_FLAGS 16
+#define GDB_CLOSED    (-1)
+#define GDB_TIMEOUT   (-2)
+
+static const char target_xml[] =
+    "<?xml version=\"1.0\"?>"
+    "<!DOCTYPE target SYSTEM \"gdb-target.dtd\">"
+    "<target version=\"1.0\"><feature name=\"org.llmp16.core\">"
+    "<reg name=\"r0\" bitsize=\"16\" type=\"uint16\" regnum=\"0\"/>"
+    "<reg name=\"r1\" bitsize=\"16\" type=\"uint16\"/>"
+    "<reg name=\"r2\" bitsize=\"16\" type=\"uint16\"/>"
+    "<reg name=\"r3\" bitsize=\"16\" type=\"uint16\"/>"
+    "<reg name=\"r4\" bitsize=\"16\" type=\"uint16\"/>"
+    "<reg name=\"r5\" bitsize=\"16\" type=\"uint16\"/>"
+    "<reg name=\"r6\" bitsize=\"16\" type=\"uint16\"/>"
+    "<reg name=\"r7\" bitsize=\"16\" type=\"uint16\"/>"
+    "<reg name=\"r8\" bitsize=\"32\" type=\"uint32\"/>"
+    "<reg name=\"r9\" bitsize=\"32\" type=\"uint32\"/>"
+    "<reg name=\"r10\" bitsize=\"32\" type=\"uint32\"/>"
+    "<reg name=\"r11\" bitsize=\"32\" type=\"uint32\"/>"
+    "<reg name=\"pc\" bitsize=\"32\" type=\"code_ptr\"/>"
+    "<reg name=\"sp\" bitsize=\"32\" type=\"data_ptr\"/>"
+    "<reg name=\"idx\" bitsize=\"32\" type=\"uint32\"/>"
+    "<reg name=\"acc\" bitsize=\"32\" type=\"uint32\"/>"
+    "<reg name=\"flags\" bitsize=\"32\" type=\"uint32\"/>"
+    "</feature></target>";
+
+static const char hexdigits[] = "0123456789abcdef";
+
+
+/*============================== Socket ==============================*/
+
+int llmp16_gdb_listen(llmp16_gdb_t *gdb, const char *endpoint)
+{
+    memset(gdb, 0, sizeof(*gdb));
+    gdb->fd = -1;
+
+    char *end;
+    unsigned long port = strtoul(endpoint, &end, 10);
+    if (*endpoint != '\0' && *end == '\0') {
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        int one = 1;
+        gdb->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (gdb->listen_fd < 0) { perror("GDB socket error"); return -1; }
+        setsockopt(gdb->listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (bind(gdb->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+            perror("GDB bind error");
+            close(gdb->listen_fd);
+            return -1;
+        }
+    } else {
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (strlen(endpoint) >= sizeof(addr.sun_path)) {
+            fprintf(stderr, "GDB : chemin de socket trop long\n");
+            return -1;
+        }
+        strcpy(addr.sun_path, endpoint);
+
+        gdb->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (gdb->listen_fd < 0) { perror("GDB socket error"); return -1; }
+        unlink(endpoint);
+        if (bind(gdb->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+            perror("GDB bind error");
+            close(gdb->listen_fd);
+            return -1;
+        }
+        strcpy(gdb->path, endpoint);
+    }
+
+    if (listen(gdb->listen_fd, 1) != 0) {
+        perror("GDB listen error");
+        llmp16_gdb_close(gdb);
+        return -1;
+    }
+    return 0;
+}
+
+void llmp16_gdb_close(llmp16_gdb_t *gdb)
+{
+    if (gdb->fd >= 0) close(gdb->fd);
+    if (gdb->listen_fd >= 0) close(gdb->listen_fd);
+    if (gdb->path[0] != '\0') unlink(gdb->path);
+    gdb->fd = -1;
+    gdb->listen_fd = -1;
+    gdb->path[0] = '\0';
+}
+
+/* Octet suivant de la connexion, GDB_TIMEOUT si rien n'arrive en <timeout_ms> (-1 = attente) */
+static int get_byte(llmp16_gdb_t *gdb, int timeout_ms)
+{
+    if (gdb->in_pos == gdb->in_len) {
+        struct pollfd pfd = { gdb->fd, POLLIN, 0 };
+        int r = poll(&pfd, 1, timeout_ms);
+        if (r == 0) return GDB_TIMEOUT;
+        if (r < 0) return errno == EINTR ? GDB_TIMEOUT : GDB_CLOSED;
+
+        ssize_t n = recv(gdb->fd, gdb->in, sizeof(gdb->in), 0);
+        if (n <= 0) return GDB_CLOSED;
+        gdb->in_len = (size_t)n;
+        gdb->in_pos = 0;
+    }
+    return gdb->in[gdb->in_pos++];
+}
+
+static int hex_value(int c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/* Reçoit le prochain paquet $...#cs dans gdb->packet, retourne sa longueur ou GDB_CLOSED */
+static int read_packet(llmp16_gdb_t *gdb)
+{
+    for (;;) {
+        int c;
+        do {
+            c = get_byte(gdb, -1);
+            if (c == GDB_CLOSED) return GDB_CLOSED;
+        } while (c != '$');     // acks et Ctrl-C hors exécution sont ignorés
+
+        size_t len = 0;
+        uint8_t sum = 0;
+        while ((c = get_byte(gdb, -1)) != '#') {
+            if (c == GDB_CLOSED) return GDB_CLOSED;
+            if (len < LLMP_GDB_PACKET_MAX) gdb->packet[len++] = (char)c;
+            sum += (uint8_t)c;
+        }
+        int hi = get_byte(gdb, -1);
+        int lo = get_byte(gdb, -1);
+        if (hi == GDB_CLOSED || lo == GDB_CLOSED) return GDB_CLOSED;
+        gdb->packet[len] = '\0';
+
+        if (gdb->no_ack) return (int)len;
+        if (hex_value(hi) * 16 + hex_value(lo) == sum) {
+            send(gdb->fd, "+", 1, 0);
+            return (int)len;
+        }
+        send(gdb->fd, "-", 1, 0);
+    }
+}
+
+static int send_packet(llmp16_gdb_t *gdb, const char *data, size_t len)
+{
+    static const size_t overhead = 4;
+    char frame[LLMP_GDB_PACKET_MAX + 8];
+    uint8_t sum = 0;
+
+    if (len > LLMP_GDB_PACKET_MAX) len = LLMP_GDB_PACKET_MAX;
+    frame[0] = '$';
+    for (size_t i = 0; i < len; i++) {
+        frame[i + 1] = data[i];
+        sum += (uint8_t)data[i];
+    }
+    frame[len + 1] = '#';
+    frame[len + 2] = hexdigits[sum >> 4];
+    frame[len + 3] = hexdigits[sum & 0xF];
+
+    for (;;) {
+        if (send(gdb->fd, frame, len + overhead, 0) < 0) return GDB_CLOSED;
+        if (gdb->no_ack) return 0;
+
+        int c;
+        do {
+            c = get_byte(gdb, -1);
+            if (c == GDB_CLOSED) return GDB_CLOSED;
+        } while (c != '+' && c != '-');
+        if (c == '+') return 0;
+    }
+}
+
+static int send_str(llmp16_gdb_t *gdb, const char *s)
+{
+    return send_packet(gdb, s, strlen(s));
+}
+
+
+/*============================== Registres et mémoire ==============================*/
+
+static int reg_size(int n)
+{
+    return n < 8 ? 2 : 4;
+}
+
+static uint32_t reg_read(llmp16_t *vm, int n)
+{
+    return n == GDB_REG_FLAGS ? vm->FLAGS : llmp16_reg_get(vm, (llmp16_register_t)n);
+}
+
+static void reg_write(llmp16_t *vm, int n, uint32_t v)
+{
+    if (n == GDB_REG_FLAGS) vm->FLAGS = (uint8_t)(v & 0x0F);
+    else llmp16_reg_set(vm, (llmp16_register_t)n, v);
+}
+
+/* Valeur en hexadécimal little-endian sur <bytes> octets */
+static char *put_le(char *out, uint32_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++, v >>= 8) {
+        *out++ = hexdigits[(v >> 4) & 0xF];
+        *out++ = hexdigits[v & 0xF];
+    }
+    return out;
+}
+
+static const char *get_le(const char *in, uint32_t *v, int bytes)
+{
+    *v = 0;
+    for (int i = 0; i < bytes; i++) {
+        int hi = hex_value(in[0]), lo = hex_value(in[1]);
+        if (hi < 0 || lo < 0) return NULL;
+        *v |= (uint32_t)(hi * 16 + lo) << (8 * i);
+        in += 2;
+    }
+    return in;
+}
+
+static void send_registers(llmp16_gdb_t *gdb, llmp16_t *vm)
+{
+    char buf[GDB_NB_REGS * 8 + 1];
+    char *p = buf;
+    for (int n = 0; n < GDB_NB_REGS; n++)
+        p = put_le(p, reg_read(vm, n), reg_size(n));
+    send_packet(gdb, buf, (size_t)(p - buf));
+}
+
+static void write_registers(llmp16_gdb_t *gdb, llmp16_t *vm, const char *in)
+{
+    for (int n = 0; n < GDB_NB_REGS && *in != '\0'; n++) {
+        uint32_t v;
+        if ((in = get_le(in, &v, reg_size(n))) == NULL) {
+            send_str(gdb, "E01");
+            return;
+        }
+        reg_write(vm, n, v);
+    }
+    send_str(gdb, "OK");
+}
+
+static void read_memory(llmp16_gdb_t *gdb, llmp16_t *vm, uint32_t addr, uint32_t len)
+{
+    char buf[LLMP_GDB_PACKET_MAX];
+    if (len > sizeof(buf) / 2) len = sizeof(buf) / 2;
+    for (uint32_t i = 0; i < len; i++) {
+        uint8_t b = llmp16_mem_peek8(vm, addr + i);
+        buf[2 * i] = hexdigits[b >> 4];
+        buf[2 * i + 1] = hexdigits[b & 0xF];
+    }
+    send_packet(gdb, buf, 2 * len);
+}
+
+static void write_memory(llmp16_gdb_t *gdb, llmp16_t *vm, uint32_t addr, uint32_t len, const char *in)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        int hi = hex_value(in[2 * i]), lo = hex_value(in[2 * i + 1]);
+        if (hi < 0 || lo < 0 || llmp16_mem_poke8(vm, addr + i, (uint8_t)(hi * 16 + lo)) != 0) {
+            send_str(gdb, "E01");
+            return;
+        }
+    }
+    send_str(gdb, "OK");
+}
+
+
+/*============================== Exécution ==============================*/
+
+static void send_stop(llmp16_gdb_t *gdb, llmp16_t *vm)
+{
+    const llmp16_debug_t *dbg = &gdb->dbg;
+    char buf[64];
+
+    if (vm->halted || dbg->reason == LLMP_STOP_HALT) {
+        send_str(gdb, "W00");
+        return;
+    }
+
+    int n = snprintf(buf, sizeof(buf), "T%02x", gdb->interrupted ? 2 : 5);
+    if (dbg->reason == LLMP_STOP_WATCH && dbg->stop_space == LLMP_WATCH_MEM) {
+        const char *kind = dbg->stop_write ? "watch" : "rwatch";
+        for (int i = 0; i < dbg->nb_wp; i++) {
+            const llmp16_watch_t *w = &dbg->wp[i];
+            if (w->space == LLMP_WATCH_MEM && dbg->stop_addr >= w->lo && dbg->stop_addr < w->hi &&
+                w->access == (LLMP_WATCH_R | LLMP_WATCH_W))
+                kind = "awatch";
+        }
+        n += snprintf(buf + n, sizeof(buf) - n, "%s:%x;", kind, dbg->stop_addr);
+    }
+    // PC dans la réponse évite à GDB un aller-retour 'p'
+    n += snprintf(buf + n, sizeof(buf) - n, "%02x:", PC);
+    char *p = put_le(buf + n, llmp16_reg_get(vm, PC), 4);
+    *p++ = ';';
+    send_packet(gdb, buf, (size_t)(p - buf));
+}
+
+/* Exécute par tranches d'une frame en surveillant un Ctrl-C entre deux tranches.
+   Retourne GDB_CLOSED si la connexion est perdue. */
+static int run(llmp16_gdb_t *gdb, llmp16_t *vm)
+{
+    gdb->interrupted = false;
+    for (;;) {
+        if (llmp16_debug_continue(vm, CYCLES_PER_FRAME) != LLMP_STOP_NONE || vm->halted)
+            return 0;
+
+        int c;
+        while ((c = get_byte(gdb, 0)) != GDB_TIMEOUT) {
+            if (c == GDB_CLOSED) return GDB_CLOSED;
+            if (c == 0x03) {
+                gdb->dbg.reason = LLMP_STOP_USER;
+                gdb->interrupted = true;
+                return 0;
+            }
+        }
+    }
+}
+
+/* "c [addr]" et "s [addr]" : reprise éventuellement à une autre adresse */
+static void set_resume_pc(llmp16_t *vm, const char *arg)
+{
+    if (*arg != '\0') llmp16_reg_set(vm, PC, (uint32_t)strtoul(arg, NULL, 16));
+}
+
+static void set_point(llmp16_gdb_t *gdb, llmp16_t *vm, const char *pkt)
+{
+    bool insert = pkt[0] == 'Z';
+    char *end;
+    unsigned long type = strtoul(pkt + 1, &end, 16);
+    if (*end != ',') { send_str(gdb, "E01"); return; }
+    uint32_t addr = (uint32_t)strtoul(end + 1, &end, 16);
+    uint32_t len = *end == ',' ? (uint32_t)strtoul(end + 1, NULL, 16) : 2;
+    if (len == 0) len = 1;
+
+    int r;
+    switch (type) {
+    case 0:
+    case 1:
+        r = insert ? llmp16_debug_break_add(vm, addr) : llmp16_debug_break_del(vm, addr);
+        break;
+    case 2:
+    case 3:
+    case 4: {
+        static const uint8_t access[3] = { LLMP_WATCH_W, LLMP_WATCH_R, LLMP_WATCH_R | LLMP_WATCH_W };
+        r = insert ? llmp16_debug_watch_add(vm, LLMP_WATCH_MEM, addr, len, access[type - 2])
+                   : llmp16_debug_watch_del(vm, LLMP_WATCH_MEM, addr);
+        break;
+    }
+    default:
+        send_str(gdb, "");
+        return;
+    }
+    send_str(gdb, r == 0 ? "OK" : "E01");
+}
+
+/* qXfer:features:read:target.xml:<off>,<len> */
+static void send_features(llmp16_gdb_t *gdb, const char *args)
+{
+    const char *annex = "target.xml:";
+    if (strncmp(args, annex, strlen(annex)) != 0) {
+        send_str(gdb, "E00");
+        return;
+    }
+    char *end;
+    size_t off = strtoul(args + strlen(annex), &end, 16);
+    size_t len = *end == ',' ? strtoul(end + 1, NULL, 16) : 0;
+    size_t total = sizeof(target_xml) - 1;
+
+    char buf[LLMP_GDB_PACKET_MAX];
+    if (off > total) off = total;
+    if (len > total - off) len = total - off;
+    if (len > sizeof(buf) - 1) len = sizeof(buf) - 1;
+    buf[0] = off + len < total ? 'm' : 'l';
+    memcpy(buf + 1, target_xml + off, len);
+    send_packet(gdb, buf, len + 1);
+}
+
+static void query(llmp16_gdb_t *gdb, llmp16_t *vm, const char *pkt)
+{
+    char buf[128];
+
+    if (strncmp(pkt, "qSupported", 10) == 0) {
+        snprintf(buf, sizeof(buf), "PacketSize=%x;qXfer:features:read+;QStartNoAckMode+%s", LLMP_GDB_PACKET_MAX,
+                 vm->rewind != NULL ? ";ReverseStep+" : "");
+        send_str(gdb, buf);
+    } else if (strncmp(pkt, "qXfer:features:read:", 20) == 0) {
+        send_features(gdb, pkt + 20);
+    } else if (strcmp(pkt, "qAttached") == 0) {
+        send_str(gdb, "1");
+    } else if (strcmp(pkt, "qC") == 0) {
+        send_str(gdb, "QC1");
+    } else if (strcmp(pkt, "qfThreadInfo") == 0) {
+        send_str(gdb, "m1");
+    } else if (strcmp(pkt, "qsThreadInfo") == 0) {
+        send_str(gdb, "l");
+    } else if (strcmp(pkt, "QStartNoAckMode") == 0) {
+        send_str(gdb, "OK");
+        gdb->no_ack = true;
+    } else {
+        send_str(gdb, "");
+    }
+}
+
+int llmp16_gdb_serve(llmp16_gdb_t *gdb, llmp16_t *vm)
+{
+    gdb->fd = accept(gdb->listen_fd, NULL, NULL);
+    if (gdb->fd < 0) {
+        perror("GDB accept error");
+        return EXIT_FAILURE;
+    }
+    gdb->no_ack = false;
+    gdb->interrupted = false;
+    gdb->in_len = gdb->in_pos = 0;
+
+    llmp16_debug_attach(vm, &gdb->dbg);
+
+    int len;
+    bool attached = true;
+    while (attached && (len = read_packet(gdb)) != GDB_CLOSED) {
+        const char *pkt = gdb->packet;
+        char *end;
+        uint32_t a, b;
+        (void)len;
+
+        switch (pkt[0]) {
+        case '?':
+            send_stop(gdb, vm);
+            break;
+        case 'g':
+            send_registers(gdb, vm);
+            break;
+        case 'G':
+            write_registers(gdb, vm, pkt + 1);
+            break;
+        case 'p': {
+            int n = (int)strtoul(pkt + 1, NULL, 16);
+            char buf[9];
+            if (n >= GDB_NB_REGS) { send_str(gdb, "E01"); break; }
+            send_packet(gdb, buf, (size_t)(put_le(buf, reg_read(vm, n), reg_size(n)) - buf));
+            break;
+        }
+        case 'P': {
+            int n = (int)strtoul(pkt + 1, &end, 16);
+            if (n >= GDB_NB_REGS || *end != '=' || get_le(end + 1, &a, reg_size(n)) == NULL) {
+                send_str(gdb, "E01");
+                break;
+            }
+            reg_write(vm, n, a);
+            send_str(gdb, "OK");
+            break;
+        }
+        case 'm':
+        case 'M':
+            a = (uint32_t)strtoul(pkt + 1, &end, 16);
+            if (*end != ',') { send_str(gdb, "E01"); break; }
+            b = (uint32_t)strtoul(end + 1, &end, 16);
+            if (pkt[0] == 'm') read_memory(gdb, vm, a, b);
+            else if (*end == ':' && strlen(end + 1) >= 2 * (size_t)b) write_memory(gdb, vm, a, b, end + 1);
+            else send_str(gdb, "E01");
+            break;
+        case 'c':
+            set_resume_pc(vm, pkt + 1);
+            if (run(gdb, vm) == GDB_CLOSED) attached = false;
+            else send_stop(gdb, vm);
+            break;
+        case 's':
+            set_resume_pc(vm, pkt + 1);
+            gdb->interrupted = false;
+            llmp16_debug_step(vm);
+            send_stop(gdb, vm);
+            break;
+        case 'b':
+            // bs : pas en arrière, avec le tampon de rembobinage (-b)
+            if (pkt[1] != 's' || vm->rewind == NULL) { send_str(gdb, ""); break; }
+            gdb->interrupted = false;
+            if (vm->stats.instructions == 0 || llmp16_rewind_to_instr(vm, vm->stats.instructions - 1) != 0)
+                send_str(gdb, "E01");
+            else
+                send_stop(gdb, vm);
+            break;
+        case 'Z':
+        case 'z':
+            set_point(gdb, vm, pkt);
+            break;
+        case 'q':
+        case 'Q':
+            query(gdb, vm, pkt);
+            break;
+        case 'H':
+        case 'T':
+            send_str(gdb, "OK");
+            break;
+        case 'D':
+            send_str(gdb, "OK");
+            attached = false;
+            break;
+        case 'k':
+            vm->halted = true;
+            attached = false;
+            break;
+        default:
+            if (strncmp(pkt, "vKill", 5) == 0) {
+                send_str(gdb, "OK");
+                vm->halted = true;
+                attached = false;
+            } else {
+                send_str(gdb, "");
+            }
+            break;
+        }
+    }
+
+    llmp16_debug_detach(vm);
+    close(gdb->fd);
+    gdb->fd = -1;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,49 @@
+#ifndef LLMP16_GDB_H
+#define LLMP16_GDB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "llmp16.h"
+#include "llmp16_debug.h"
+
+/*
+ * Stub GDB (Remote Serial Protocol) pour LLMP16
+ * ---------------------------------------------
+ * Sert une VM sur une socket locale : port TCP sur 127.0.0.1 ou socket Unix. Le stub s'appuie
+ * sur le debugger intégré (llmp16_debug.h) pour les breakpoints, watchpoints et le pas à pas.
+ *
+ * - registres 0-7 : R0-R7 sur 16 bits, 8-15 : R8-R11, PC, SP, IDX, ACC sur 32 bits,
+ *   16 : FLAGS (NZCV) ; la description est fournie par qXfer:features:read ;
+ * - mémoire : l'espace 20 bits, ROM comprise en écriture ; MMIO lu comme 0xFF ;
+ * - Z0/Z1 : breakpoint, Z2/Z3/Z4 : watchpoint mémoire en écriture/lecture/accès ;
+ * - un HALT du CPU est rapporté comme la fin du programme (W00) ;
+ * - bs (reverse-stepi) si un tampon de rembobinage est attaché.
+ *
+ * En exécution, la socket n'est consultée qu'entre deux tranches de CYCLES_PER_FRAME cycles :
+ * un Ctrl-C de GDB arrête la VM à la fin de la tranche en cours.
+ */
+
+#define LLMP_GDB_PACKET_MAX   4096
+
+typedef struct {
+    int listen_fd;
+    int fd;                                /* connexion GDB, -1 = aucune */
+    char path[108];                        /* socket Unix à supprimer à la fermeture */
+    bool no_ack;                           /* QStartNoAckMode accepté */
+    bool interrupted;                      /* dernier arrêt dû à un Ctrl-C (SIGINT) */
+
+    uint8_t in[512];                       /* octets reçus non consommés */
+    size_t in_len, in_pos;
+    char packet[LLMP_GDB_PACKET_MAX + 1];
+
+    llmp16_debug_t dbg;
+} llmp16_gdb_t;
+
+/* <endpoint> : un numéro de port TCP, ou le chemin d'une socket Unix */
+int  llmp16_gdb_listen(llmp16_gdb_t *gdb, const char *endpoint);
+/* Attend une connexion et sert la VM jusqu'au détachement ou au kill de GDB */
+int  llmp16_gdb_serve(llmp16_gdb_t *gdb, llmp16_t *vm);
+void llmp16_gdb_close(llmp16_gdb_t *gdb);
+
+#endif // LLMP16_GDB_H
@@ -0,0 +1,108 @@
+#include "llmp16_journal.h"
+#include <stdlib.h>
+#include <string.h>
+
+static uint32_t mem_hash(const llmp16_t *vm)
+{
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < LLMP_MEM_SIZE; i++) {
+        h ^= vm->memory[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void read_next(llmp16_journal_t *journal)
+{
+    journal->has_next = fread(&journal->next, sizeof(journal->next), 1, journal->file) == 1;
+}
+
+int llmp16_journal_open(llmp16_journal_t *journal, llmp16_t *vm, const char *path, llmp16_journal_mode_t mode)
+{
+    llmp16_journal_header_t header;
+
+    memset(journal, 0, sizeof(*journal));
+    journal->mode = mode;
+    journal->file = fopen(path, mode == LLMP_JOURNAL_RECORD ? "wb" : "rb");
+    if (journal->file == NULL) {
+        perror("Journal open error");
+        return -1;
+    }
+
+    if (mode == LLMP_JOURNAL_RECORD) {
+        memcpy(header.magic, LLMP_JOURNAL_MAGIC, sizeof(header.magic));
+        header.rec_size = sizeof(llmp16_journal_rec_t);
+        header.mem_hash = mem_hash(vm);
+        fwrite(&header, sizeof(header), 1, journal->file);
+        return 0;
+    }
+
+    if (fread(&header, sizeof(header), 1, journal->file) != 1 ||
+        memcmp(header.magic, LLMP_JOURNAL_MAGIC, sizeof(header.magic)) != 0 ||
+        header.rec_size != sizeof(llmp16_journal_rec_t)) {
+        fprintf(stderr, "Journal : %s n'est pas un journal LLMP16\n", path);
+        fclose(journal->file);
+        journal->file = NULL;
+        return -1;
+    }
+    if (header.mem_hash != mem_hash(vm))
+        fprintf(stderr, "Journal : la mémoire initiale diffère de l'enregistrement (ROM différente ?)\n");
+    read_next(journal);
+    return 0;
+}
+
+void llmp16_journal_close(llmp16_journal_t *journal)
+{
+    if (journal->file != NULL) fclose(journal->file);
+    journal->file = NULL;
+}
+
+static void record(llmp16_t *vm, uint8_t type, uint8_t port, uint8_t reg, uint32_t value)
+{
+    llmp16_journal_t *journal = vm->journal;
+    if (journal == NULL || journal->mode != LLMP_JOURNAL_RECORD) return;
+
+    llmp16_journal_rec_t rec = { vm->stats.cycles, type, port, reg, 0, value };
+    fwrite(&rec, sizeof(rec), 1, journal->file);
+    journal->events++;
+}
+
+void llmp16_host_input(llmp16_t *vm, uint8_t port, uint8_t reg, uint16_t value)
+{
+    record(vm, JOURNAL_IO, port, reg, value);
+    vm->IO[port & 0x0F][reg & 0x0F] = value;
+}
+
+void llmp16_host_quit(llmp16_t *vm)
+{
+    record(vm, JOURNAL_QUIT, 0, 0, 0);
+    vm->halted = true;
+}
+
+/* Réinjecte les entrées reçues au plus tard au cycle courant */
+static void apply_due(llmp16_t *vm, llmp16_journal_t *journal)
+{
+    while (journal->has_next && journal->next.cycle <= vm->stats.cycles) {
+        const llmp16_journal_rec_t *rec = &journal->next;
+        if (rec->cycle != vm->stats.cycles) journal->desync++;
+
+        if (rec->type == JOURNAL_IO) vm->IO[rec->port & 0x0F][rec->reg & 0x0F] = (uint16_t)rec->value;
+        else if (rec->type == JOURNAL_QUIT) vm->halted = true;
+        journal->events++;
+        read_next(journal);
+    }
+}
+
+void llmp16_journal_replay(llmp16_t *vm)
+{
+    llmp16_journal_t *journal = vm->journal;
+
+    // mêmes frontières de frame que llmp16_run(), sans affichage ni attente
+    while (!vm->halted && !vm->cpu_halted) {
+        apply_due(vm, journal);
+        llmp16_run_frame(vm);
+        if (vm->shm != NULL || vm->capture != NULL) llmp16_video_present(vm, llmp16_video_frame(vm));
+    }
+    if (journal->desync)
+        fprintf(stderr, "Journal : %llu entrée(s) rejouée(s) hors de leur cycle\n", (unsigned long long)journal->desync);
+}
@@ -0,0 +1,75 @@
+#ifndef LLMP16_JOURNAL_H
+#define LLMP16_JOURNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "llmp16.h"
+
+/*
+ * Journal d'entrées pour LLMP16 (enregistrement / rejeu)
+ * ------------------------------------------------------
+ * Le coeur est déterministe : les timers, le blitter, le DMA et les compteurs du port $F
+ * avancent au rythme des cycles invités, jamais du temps hôte. Les seules entrées extérieures
+ * sont les valeurs que l'hôte dépose dans les registres IO (clavier) et l'arrêt demandé par
+ * l'hôte ; elles passent toutes par llmp16_host_input() / llmp16_host_quit().
+ *
+ * Attaché à une VM par vm->journal :
+ *   - LLMP_JOURNAL_RECORD : chaque entrée est écrite avec le compteur de cycles courant ;
+ *   - LLMP_JOURNAL_REPLAY : llmp16_journal_replay() exécute la VM sans affichage et à pleine
+ *                           vitesse, frame par frame comme llmp16_run(), et réinjecte chaque
+ *                           entrée au début de la frame où elle avait été reçue.
+ *
+ * Fichier : en-tête llmp16_journal_header_t puis des enregistrements de 16 octets,
+ * little-endian. L'en-tête porte une empreinte de la mémoire initiale (ROM chargée) : le rejeu
+ * prévient si la ROM ne correspond pas.
+ */
+
+#define LLMP_JOURNAL_MAGIC "LLMPJRN1"
+
+typedef enum {
+    LLMP_JOURNAL_RECORD,
+    LLMP_JOURNAL_REPLAY
+} llmp16_journal_mode_t;
+
+typedef enum {
+    JOURNAL_IO = 1,     /* port, reg, value : valeur déposée par l'hôte dans un registre IO */
+    JOURNAL_QUIT        /* arrêt demandé par l'hôte (fenêtre fermée) */
+} llmp16_journal_type_t;
+
+typedef struct {
+    uint64_t cycle;     /* vm->stats.cycles au moment de l'entrée */
+    uint8_t  type;
+    uint8_t  port;
+    uint8_t  reg;
+    uint8_t  pad;
+    uint32_t value;
+} llmp16_journal_rec_t;
+
+typedef struct {
+    char     magic[8];
+    uint32_t rec_size;
+    uint32_t mem_hash;  /* FNV-1a de la mémoire à l'ouverture */
+} llmp16_journal_header_t;
+
+typedef struct llmp16_journal_s {
+    FILE *file;
+    uint8_t mode;                       /* llmp16_journal_mode_t */
+    llmp16_journal_rec_t next;          /* rejeu : prochain enregistrement */
+    bool has_next;
+    uint64_t events;                    /* enregistrements écrits ou rejoués */
+    uint64_t desync;                    /* rejeu : entrées tombées hors de leur cycle */
+} llmp16_journal_t;
+
+/* À ouvrir après le chargement de la ROM ; ne fait pas l'attache (vm->journal) */
+int  llmp16_journal_open(llmp16_journal_t *journal, llmp16_t *vm, const char *path, llmp16_journal_mode_t mode);
+void llmp16_journal_close(llmp16_journal_t *journal);
+
+/* Rejoue le journal attaché jusqu'au HALT, à l'arrêt enregistré ou à la fin du journal */
+void llmp16_journal_replay(llmp16_t *vm);
+
+/* Entrées de l'hôte, enregistrées si un journal est attaché en mode RECORD */
+void llmp16_host_input(llmp16_t *vm, uint8_t port, uint8_t reg, uint16_t value);
+void llmp16_host_quit(llmp16_t *vm);
+
+#endif // LLMP16_JOURNAL_H
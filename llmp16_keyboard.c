@@ -1,9 +1,10 @@
 #include "llmp16.h"
+#include "llmp16_journal.h"
 #include <SDL2/SDL.h>
 
+// Le sous-système vidéo (et donc la file d'événements) est initialisé par llmp16_screen_init()
 void llmp16_keyb_init()
 {
-    SDL_Init(SDL_INIT_VIDEO);
     SDL_StartTextInput();
 }
 
@@ -14,10 +15,10 @@ void llmp16_keyboard_scan(llmp16_t *vm)
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         if (event.type == SDL_KEYDOWN) {
-            vm->IO[1][0] = event.key.keysym.sym; // Envoie la touche pressée au registre 0
+            llmp16_host_input(vm, 1, 0, (uint16_t)event.key.keysym.sym); // Envoie la touche pressée au registre 0
             //vm->IO[1][1] = 0x01; // Indique qu'une touche est pressée
         }
-        if(event.type == SDL_QUIT) vm->halted = true;
+        if(event.type == SDL_QUIT) llmp16_host_quit(vm);
     }
 }
 
@@ -0,0 +1,387 @@
+#include "llmp16.h"
+#include "llmp16_debug.h"
+#include "llmp16_rewind.h"
+
+/*
+ * Contrôleur mémoire LLMP16
+ * Tient la nature de chaque page de 4 Ko et les fonctions d'accès qui en découlent. Le
+ * chemin lent n'est pris que pour les pages sans pointeur direct : MMIO, ROM en écriture,
+ * pages non mappées, pages protégées par le debugger ou en attente de copie pour le
+ * rembobinage.
+ */
+
+static uint8_t direct_read(llmp16_t *vm, uint32_t addr)
+{
+    return vm->rd_page[addr >> LLMP_PAGE_SHIFT][addr & LLMP_PAGE_MASK];
+}
+
+static void direct_write(llmp16_t *vm, uint32_t addr, uint8_t v)
+{
+    vm->wr_page[addr >> LLMP_PAGE_SHIFT][addr & LLMP_PAGE_MASK] = v;
+}
+
+/* Recalcule les pointeurs et les fonctions d'une page à partir de sa nature et de ses protections */
+void llmp16_mem_refresh_page(llmp16_t *vm, uint32_t page)
+{
+    uint8_t *backing = vm->pages[page].backing;
+    uint8_t prot = vm->pages[page].prot;
+    uint8_t *rd = (prot & (LLMP_PROT_BREAK | LLMP_PROT_READ)) ? NULL : backing;
+
+    switch (vm->pages[page].kind) {
+    case LLMP_MEM_RAM:
+        vm->rd_page[page] = rd;
+        vm->wr_page[page] = (prot & (LLMP_PROT_WRITE | LLMP_PROT_COW)) ? NULL : backing;
+        break;
+    case LLMP_MEM_ROM:
+        vm->rd_page[page] = rd;
+        vm->wr_page[page] = NULL;
+        break;
+    default:
+        vm->rd_page[page] = NULL;
+        vm->wr_page[page] = NULL;
+        break;
+    }
+    vm->rd_fn[page] = vm->rd_page[page] ? direct_read : llmp16_mem_read_slow;
+    vm->wr_fn[page] = vm->wr_page[page] ? direct_write : llmp16_mem_write_slow;
+}
+
+static int check_range(uint32_t base, uint32_t size)
+{
+    if ((base & LLMP_PAGE_MASK) || (size & LLMP_PAGE_MASK) || size == 0 || base + size > LLMP_MEM_SIZE) {
+        fprintf(stderr, "mem map: plage 0x%05X+0x%X non alignée sur 4 Ko\n", base, size);
+        return -1;
+    }
+    return 0;
+}
+
+/* Mappe une plage alignée sur des pages en RAM, ROM ou non mappée, adossée à vm->memory */
+int llmp16_mem_map(llmp16_t *vm, uint32_t base, uint32_t size, llmp16_mem_kind_t kind)
+{
+    return llmp16_mem_map_backed(vm, base, size, kind, vm->memory + base);
+}
+
+/* Idem avec un stockage fourni par l'appelant (VRAM, mémoire partagée...) d'au moins <size> octets */
+int llmp16_mem_map_backed(llmp16_t *vm, uint32_t base, uint32_t size, llmp16_mem_kind_t kind, uint8_t *backing)
+{
+    if (check_range(base, size) != 0 || kind == LLMP_MEM_MMIO) return -1;
+
+    for (uint32_t p = base >> LLMP_PAGE_SHIFT; p < (base + size) >> LLMP_PAGE_SHIFT; p++) {
+        vm->pages[p].kind = kind;
+        vm->pages[p].backing = kind == LLMP_MEM_UNMAPPED ? NULL : backing + ((p << LLMP_PAGE_SHIFT) - base);
+        vm->pages[p].read = NULL;
+        vm->pages[p].write = NULL;
+        llmp16_mem_refresh_page(vm, p);
+    }
+    return 0;
+}
+
+/* Mappe une plage sur des registres de périphérique, chaque accès passe par read/write */
+int llmp16_mem_map_mmio(llmp16_t *vm, uint32_t base, uint32_t size,
+                        llmp16_mmio_read_t read, llmp16_mmio_write_t write)
+{
+    if (check_range(base, size) != 0) return -1;
+
+    for (uint32_t p = base >> LLMP_PAGE_SHIFT; p < (base + size) >> LLMP_PAGE_SHIFT; p++) {
+        vm->pages[p].kind = LLMP_MEM_MMIO;
+        vm->pages[p].backing = NULL;
+        vm->pages[p].read = read;
+        vm->pages[p].write = write;
+        llmp16_mem_refresh_page(vm, p);
+    }
+    return 0;
+}
+
+
+/*============================== Fenêtre périphériques ==============================*/
+
+static uint8_t io_window_read(llmp16_t *vm, uint32_t addr)
+{
+    uint32_t off = addr - LLMP_MMIO_IO;
+    if (off >= LLMP_IO_PORTS * LLMP_IO_REGS * 2) return 0xFF;
+
+    uint8_t port = (off >> 5) & 0x0F;
+    uint8_t reg = (off >> 1) & 0x0F;
+    if ((off & 1) == 0) {
+        // l'octet bas porte les effets de bord, l'octet haut relit le même mot
+        vm->io_latch = llmp16_io_read(vm, port, reg);
+        vm->io_latch_addr = addr;
+        return (uint8_t)vm->io_latch;
+    }
+    if (vm->io_latch_addr + 1 == addr) return (uint8_t)(vm->io_latch >> 8);
+    return (uint8_t)(vm->IO[port][reg] >> 8);
+}
+
+static void io_window_write(llmp16_t *vm, uint32_t addr, uint8_t v)
+{
+    uint32_t off = addr - LLMP_MMIO_IO;
+    if (off >= LLMP_IO_PORTS * LLMP_IO_REGS * 2) return;
+
+    if ((off & 1) == 0) {
+        vm->io_latch = v;
+        vm->io_latch_addr = addr;
+        return;
+    }
+    uint16_t low = vm->io_latch_addr + 1 == addr ? (uint8_t)vm->io_latch : (uint8_t)vm->IO[(off >> 5) & 0x0F][(off >> 1) & 0x0F];
+    llmp16_io_write(vm, (off >> 5) & 0x0F, (off >> 1) & 0x0F, (uint16_t)(low | (v << 8)));
+}
+
+/* Installe la fenêtre VRAM et registres IO (voir la carte mémoire dans llmp16.h) */
+int llmp16_mem_map_devices(llmp16_t *vm)
+{
+    if (llmp16_mem_map_backed(vm, LLMP_MMIO_VRAM, LLMP_VRAM_SIZE, LLMP_MEM_RAM, vm->VRAM) != 0)
+        return -1;
+    return llmp16_mem_map_mmio(vm, LLMP_MMIO_IO, LLMP_PAGE_SIZE, io_window_read, io_window_write);
+}
+
+
+/*============================== Chemin lent ==============================*/
+
+static void fault(llmp16_t *vm, llmp16_fault_kind_t kind, uint32_t addr)
+{
+    uint32_t pc = llmp16_reg_get(vm, PC);
+    // l'octet haut d'un accès 16 bits ne compte pas comme un second défaut
+    bool same_access = vm->fault.kind == kind && vm->fault.pc == pc && addr == ((vm->fault.addr + 1) & LLMP_ADDR_MASK);
+    if (!same_access) vm->stats.mem_faults++;
+    vm->fault.kind = kind;
+    vm->fault.addr = addr;
+    vm->fault.pc = pc;
+    if (vm->fault_halt) vm->cpu_halted = true;
+}
+
+uint8_t llmp16_mem_read_slow(llmp16_t *vm, uint32_t addr)
+{
+    const llmp16_mem_page_t *page = &vm->pages[addr >> LLMP_PAGE_SHIFT];
+    uint8_t v;
+
+    switch (page->kind) {
+    case LLMP_MEM_RAM:
+    case LLMP_MEM_ROM:
+        v = page->backing[addr & LLMP_PAGE_MASK];
+        break;
+    case LLMP_MEM_MMIO:
+        v = page->read ? page->read(vm, addr) : 0xFF;
+        break;
+    default:
+        fault(vm, LLMP_FAULT_UNMAPPED_READ, addr);
+        v = 0xFF;
+        break;
+    }
+    if (page->prot && vm->debug) v = llmp16_debug_mem_read(vm, addr, v);
+    return v;
+}
+
+void llmp16_mem_write_slow(llmp16_t *vm, uint32_t addr, uint8_t v)
+{
+    const llmp16_mem_page_t *page = &vm->pages[addr >> LLMP_PAGE_SHIFT];
+
+    if (page->prot & LLMP_PROT_COW) llmp16_rewind_save_page(vm, addr >> LLMP_PAGE_SHIFT);
+    if (page->prot && vm->debug) llmp16_debug_mem_write(vm, addr, v);
+    switch (page->kind) {
+    case LLMP_MEM_RAM:
+        page->backing[addr & LLMP_PAGE_MASK] = v;
+        break;
+    case LLMP_MEM_ROM:
+        fault(vm, LLMP_FAULT_ROM_WRITE, addr);
+        break;
+    case LLMP_MEM_MMIO:
+        if (page->write) page->write(vm, addr, v);
+        break;
+    default:
+        fault(vm, LLMP_FAULT_UNMAPPED_WRITE, addr);
+        break;
+    }
+}
+
+
+/*============================== VRAM (VLD/VSTR, DMA) ==============================*/
+
+/* Pose les protections d'une page du banc 0 de VRAM, 0 rétablit l'accès direct */
+void llmp16_vram_protect(llmp16_t *vm, uint32_t page, uint8_t prot)
+{
+    uint8_t *backing = vm->VRAM + ((size_t)page << LLMP_PAGE_SHIFT);
+    vm->vram_rd[page] = (prot & LLMP_PROT_READ) ? NULL : backing;
+    vm->vram_wr[page] = (prot & LLMP_PROT_WRITE) ? NULL : backing;
+}
+
+uint8_t llmp16_vram_read_slow(llmp16_t *vm, uint16_t addr)
+{
+    uint8_t v = vm->VRAM[addr];
+    if (vm->debug) llmp16_debug_vram(vm, addr, false, v);
+    return v;
+}
+
+void llmp16_vram_write_slow(llmp16_t *vm, uint16_t addr, uint8_t v)
+{
+    if (vm->debug) llmp16_debug_vram(vm, addr, true, v);
+    vm->VRAM[addr] = v;
+}
+
+
+/*============================== Instructions de bloc ==============================*/
+
+/* Octets à partir de <a> et de <b> qui restent dans leur page, au plus <n> */
+static inline uint32_t segment(uint32_t a, uint32_t b, uint32_t n)
+{
+    uint32_t len = LLMP_PAGE_SIZE - (a & LLMP_PAGE_MASK);
+    if (LLMP_PAGE_SIZE - (b & LLMP_PAGE_MASK) < len) len = LLMP_PAGE_SIZE - (b & LLMP_PAGE_MASK);
+    return len < n ? len : n;
+}
+
+/* Idem en descendant : octets jusqu'à <a> et <b> inclus depuis le début de leur page */
+static inline uint32_t segment_down(uint32_t a, uint32_t b, uint32_t n)
+{
+    uint32_t len = (a & LLMP_PAGE_MASK) + 1;
+    if ((b & LLMP_PAGE_MASK) + 1 < len) len = (b & LLMP_PAGE_MASK) + 1;
+    return len < n ? len : n;
+}
+
+/* MCPY : copie de <n> octets (n <= LLMP_BLK_MAX) comme memmove. Page par page sur les pointeurs
+   rapides, octet par octet par le chemin lent ailleurs (MMIO, défauts, page à copier) ; l'ordre
+   des octets est celui d'une boucle, par le haut quand la destination recouvre la source. */
+void llmp16_mem_move(llmp16_t *vm, uint32_t dst, uint32_t src, uint32_t n)
+{
+    uint32_t delta = (dst - src) & LLMP_ADDR_MASK;
+
+    if (delta != 0 && delta < n) {
+        dst += n;
+        src += n;
+        while (n > 0) {
+            uint32_t d = (dst - 1) & LLMP_ADDR_MASK, s = (src - 1) & LLMP_ADDR_MASK;
+            uint32_t len = segment_down(d, s, n);
+            uint8_t *wp = vm->wr_page[d >> LLMP_PAGE_SHIFT];
+            const uint8_t *rp = vm->rd_page[s >> LLMP_PAGE_SHIFT];
+            if (wp != NULL && rp != NULL)
+                memmove(wp + (d & LLMP_PAGE_MASK) + 1 - len, rp + (s & LLMP_PAGE_MASK) + 1 - len, len);
+            else {
+                len = 1;
+                mem_write8(vm, d, mem_read8(vm, s));
+            }
+            dst -= len;
+            src -= len;
+            n -= len;
+        }
+        return;
+    }
+
+    while (n > 0) {
+        uint32_t d = dst & LLMP_ADDR_MASK, s = src & LLMP_ADDR_MASK;
+        uint32_t len = segment(d, s, n);
+        uint8_t *wp = vm->wr_page[d >> LLMP_PAGE_SHIFT];
+        const uint8_t *rp = vm->rd_page[s >> LLMP_PAGE_SHIFT];
+        if (wp != NULL && rp != NULL)
+            memmove(wp + (d & LLMP_PAGE_MASK), rp + (s & LLMP_PAGE_MASK), len);
+        else {
+            len = 1;
+            mem_write8(vm, d, mem_read8(vm, s));
+        }
+        dst += len;
+        src += len;
+        n -= len;
+    }
+}
+
+/* MFIL : <n> octets à <v> */
+void llmp16_mem_fill(llmp16_t *vm, uint32_t dst, uint8_t v, uint32_t n)
+{
+    while (n > 0) {
+        uint32_t d = dst & LLMP_ADDR_MASK;
+        uint32_t len = segment(d, d, n);
+        uint8_t *wp = vm->wr_page[d >> LLMP_PAGE_SHIFT];
+        if (wp != NULL)
+            memset(wp + (d & LLMP_PAGE_MASK), v, len);
+        else {
+            len = 1;
+            mem_write8(vm, d, v);
+        }
+        dst += len;
+        n -= len;
+    }
+}
+
+/* VFIL : <n> octets du banc 0 à <v>, l'adresse reste sur 16 bits */
+void llmp16_vram_fill(llmp16_t *vm, uint16_t dst, uint8_t v, uint32_t n)
+{
+    vm->stats.vram_writes += n;
+    while (n > 0) {
+        uint32_t len = segment(dst, dst, n);
+        uint8_t *wp = vm->vram_wr[dst >> LLMP_PAGE_SHIFT];
+        if (wp != NULL)
+            memset(wp + (dst & LLMP_PAGE_MASK), v, len);
+        else {
+            len = 1;
+            llmp16_vram_write_slow(vm, dst, v);
+        }
+        dst = (uint16_t)(dst + len);
+        n -= len;
+    }
+}
+
+/* MCMP : compare <n> octets à partir de <a> et <b>. Retourne le nombre d'octets égaux en tête ;
+   s'il est inférieur à <n>, *va et *vb reçoivent la première paire différente. */
+uint32_t llmp16_mem_compare(llmp16_t *vm, uint32_t a, uint32_t b, uint32_t n, uint8_t *va, uint8_t *vb)
+{
+    uint32_t eq = 0;
+
+    while (eq < n) {
+        uint32_t x = (a + eq) & LLMP_ADDR_MASK, y = (b + eq) & LLMP_ADDR_MASK;
+        uint32_t len = segment(x, y, n - eq);
+        const uint8_t *pa = vm->rd_page[x >> LLMP_PAGE_SHIFT];
+        const uint8_t *pb = vm->rd_page[y >> LLMP_PAGE_SHIFT];
+        if (pa != NULL && pb != NULL) {
+            pa += x & LLMP_PAGE_MASK;
+            pb += y & LLMP_PAGE_MASK;
+            if (memcmp(pa, pb, len) == 0) {
+                eq += len;
+                continue;
+            }
+            while (*pa == *pb) pa++, pb++, eq++;
+            *va = *pa;
+            *vb = *pb;
+            return eq;
+        }
+        *va = mem_read8(vm, x);
+        *vb = mem_read8(vm, y);
+        if (*va != *vb) return eq;
+        eq++;
+    }
+    return eq;
+}
+
+
+/*============================== Accès de debug ==============================*/
+
+/* Lecture sans effet de bord ni défaut (traces, désassembleur, debugger) :
+   les pages MMIO et non mappées renvoient 0xFF */
+uint8_t llmp16_mem_peek8(const llmp16_t *vm, uint32_t addr)
+{
+    addr &= LLMP_ADDR_MASK;
+    const llmp16_mem_page_t *page = &vm->pages[addr >> LLMP_PAGE_SHIFT];
+    if (page->backing != NULL) return page->backing[addr & LLMP_PAGE_MASK];
+    return 0xFF;
+}
+
+uint16_t llmp16_mem_peek16(const llmp16_t *vm, uint32_t addr)
+{
+    return (uint16_t)(llmp16_mem_peek8(vm, addr) | (llmp16_mem_peek8(vm, addr + 1) << 8));
+}
+
+/* Écriture de debug : ignore la protection de la ROM, refusée (-1) sur MMIO et pages non mappées */
+int llmp16_mem_poke8(llmp16_t *vm, uint32_t addr, uint8_t v)
+{
+    addr &= LLMP_ADDR_MASK;
+    const llmp16_mem_page_t *page = &vm->pages[addr >> LLMP_PAGE_SHIFT];
+    if (page->backing == NULL) return -1;
+    if (page->prot & LLMP_PROT_COW) llmp16_rewind_save_page(vm, addr >> LLMP_PAGE_SHIFT);
+    page->backing[addr & LLMP_PAGE_MASK] = v;
+    return 0;
+}
+
+const char *llmp16_fault_name(uint8_t kind)
+{
+    switch (kind) {
+    case LLMP_FAULT_ROM_WRITE:       return "écriture en ROM";
+    case LLMP_FAULT_UNMAPPED_READ:   return "lecture non mappée";
+    case LLMP_FAULT_UNMAPPED_WRITE:  return "écriture non mappée";
+    default:                         return "aucun";
+    }
+}
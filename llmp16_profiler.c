@@ -0,0 +1,250 @@
+#include "llmp16_profiler.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define PROF_STACKS_INIT 1024
+
+int llmp16_profiler_init(llmp16_profiler_t *prof, uint32_t period)
+{
+    memset(prof, 0, sizeof(*prof));
+    prof->period = period ? period : 1;
+    prof->countdown = prof->period;
+
+    prof->addr_hits = (uint64_t *)calloc(LLMP_PROF_SLOTS, sizeof(uint64_t));
+    prof->stacks = (llmp16_stack_entry_t *)calloc(PROF_STACKS_INIT, sizeof(llmp16_stack_entry_t));
+    if (prof->addr_hits == NULL || prof->stacks == NULL) {
+        llmp16_profiler_free(prof);
+        return -1;
+    }
+    prof->stacks_capacity = PROF_STACKS_INIT;
+    return 0;
+}
+
+
+/*============================== Symboles ==============================*/
+
+static int symbol_cmp(const void *a, const void *b)
+{
+    uint32_t x = ((const llmp16_symbol_t *)a)->addr;
+    uint32_t y = ((const llmp16_symbol_t *)b)->addr;
+    return (x > y) - (x < y);
+}
+
+int llmp16_profiler_load_symbols(llmp16_profiler_t *prof, const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        perror("Symbol map open error");
+        return -1;
+    }
+
+    size_t capacity = 64;
+    llmp16_symbol_t *symbols = (llmp16_symbol_t *)malloc(capacity * sizeof(llmp16_symbol_t));
+    size_t count = 0;
+    char line[128];
+    unsigned int addr;
+    char name[48];
+
+    while (symbols != NULL && fgets(line, sizeof(line), f) != NULL) {
+        if (sscanf(line, "%x %47s", &addr, name) != 2) continue;
+        if (count == capacity) {
+            capacity *= 2;
+            llmp16_symbol_t *grown = (llmp16_symbol_t *)realloc(symbols, capacity * sizeof(llmp16_symbol_t));
+            if (grown == NULL) break;
+            symbols = grown;
+        }
+        symbols[count].addr = addr;
+        snprintf(symbols[count].name, sizeof(symbols[count].name), "%s", name);
+        count++;
+    }
+    fclose(f);
+
+    if (symbols == NULL) return -1;
+    qsort(symbols, count, sizeof(llmp16_symbol_t), symbol_cmp);
+    free(prof->symbols);
+    prof->symbols = symbols;
+    prof->nb_symbols = count;
+    return 0;
+}
+
+/* Label le plus proche à une adresse inférieure ou égale, NULL si aucun */
+static const llmp16_symbol_t *symbol_find(const llmp16_profiler_t *prof, uint32_t addr)
+{
+    size_t lo = 0, hi = prof->nb_symbols;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (prof->symbols[mid].addr <= addr) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo ? &prof->symbols[lo - 1] : NULL;
+}
+
+static void symbol_print(const llmp16_profiler_t *prof, uint32_t addr, FILE *out)
+{
+    const llmp16_symbol_t *sym = symbol_find(prof, addr);
+    if (sym == NULL) fprintf(out, "0x%05X", addr);
+    else if (sym->addr == addr) fprintf(out, "%s", sym->name);
+    else fprintf(out, "%s+0x%X", sym->name, addr - sym->addr);
+}
+
+
+/*============================== Piles échantillonnées ==============================*/
+
+static uint32_t stack_hash(const uint32_t *frames, uint32_t depth)
+{
+    uint32_t h = 2166136261u;                // FNV-1a
+    for (uint32_t i = 0; i < depth; i++) {
+        h ^= frames[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static llmp16_stack_entry_t *stack_slot(llmp16_stack_entry_t *table, size_t capacity,
+                                        const uint32_t *frames, uint32_t depth, uint32_t hash)
+{
+    size_t i = hash & (capacity - 1);
+    while (table[i].depth != 0) {
+        if (table[i].hash == hash && table[i].depth == depth
+            && memcmp(table[i].frames, frames, depth * sizeof(uint32_t)) == 0)
+            break;
+        i = (i + 1) & (capacity - 1);
+    }
+    return &table[i];
+}
+
+static int stacks_grow(llmp16_profiler_t *prof)
+{
+    size_t capacity = prof->stacks_capacity * 2;
+    llmp16_stack_entry_t *table = (llmp16_stack_entry_t *)calloc(capacity, sizeof(llmp16_stack_entry_t));
+    if (table == NULL) return -1;
+
+    for (size_t i = 0; i < prof->stacks_capacity; i++) {
+        llmp16_stack_entry_t *e = &prof->stacks[i];
+        if (e->depth == 0) continue;
+        *stack_slot(table, capacity, e->frames, e->depth, e->hash) = *e;
+    }
+    free(prof->stacks);
+    prof->stacks = table;
+    prof->stacks_capacity = capacity;
+    return 0;
+}
+
+static void sample(llmp16_profiler_t *prof, uint32_t pc)
+{
+    uint32_t frames[LLMP_PROF_MAX_DEPTH + 1];
+    uint32_t depth = prof->depth < LLMP_PROF_MAX_DEPTH ? prof->depth : LLMP_PROF_MAX_DEPTH;
+    memcpy(frames, prof->stack, depth * sizeof(uint32_t));
+
+    // la feuille est ramenée au label qui contient PC pour regrouper les échantillons
+    const llmp16_symbol_t *leaf = symbol_find(prof, pc);
+    frames[depth++] = leaf ? leaf->addr : pc;
+
+    if (prof->stacks_count * 2 >= prof->stacks_capacity && stacks_grow(prof) != 0)
+        return;
+
+    uint32_t hash = stack_hash(frames, depth);
+    llmp16_stack_entry_t *e = stack_slot(prof->stacks, prof->stacks_capacity, frames, depth, hash);
+    if (e->depth == 0) {
+        e->hash = hash;
+        e->depth = depth;
+        memcpy(e->frames, frames, depth * sizeof(uint32_t));
+        prof->stacks_count++;
+    }
+    e->samples++;
+    prof->samples++;
+}
+
+
+/*============================== Hook CPU ==============================*/
+
+void llmp16_profiler_hook(llmp16_profiler_t *prof, uint32_t pc, const instr_t *in)
+{
+    prof->instructions++;
+    prof->addr_hits[(pc >> 1) % LLMP_PROF_SLOTS]++;
+    prof->class_hits[in->op_class]++;
+
+    // échantillonnage pondéré par le coût en cycles de l'instruction
+    if (prof->countdown > in->cycles) {
+        prof->countdown -= in->cycles;
+    } else {
+        prof->countdown = prof->period;
+        sample(prof, pc);
+    }
+
+    if (in->op_class == 0x8 && in->t == 0xD) {          /* CALL */
+        if (prof->depth < LLMP_PROF_MAX_DEPTH) prof->stack[prof->depth] = in->addr;
+        prof->depth++;
+    } else if (in->op_class == 0x7 && in->t == 0xD) {   /* RET */
+        if (prof->depth > 0) prof->depth--;
+    }
+}
+
+
+/*============================== Sorties ==============================*/
+
+void llmp16_profiler_write_folded(const llmp16_profiler_t *prof, FILE *out)
+{
+    for (size_t i = 0; i < prof->stacks_capacity; i++) {
+        const llmp16_stack_entry_t *e = &prof->stacks[i];
+        if (e->depth == 0) continue;
+
+        fprintf(out, "rom");
+        for (uint32_t f = 0; f < e->depth; f++) {
+            // la feuille n'est pas répétée si elle est le label de la fonction courante
+            if (f == e->depth - 1 && f > 0 && e->frames[f] == e->frames[f - 1]) break;
+            fputc(';', out);
+            symbol_print(prof, e->frames[f], out);
+        }
+        fprintf(out, " %llu\n", (unsigned long long)e->samples);
+    }
+}
+
+void llmp16_profiler_report(const llmp16_profiler_t *prof, FILE *out, int top)
+{
+    fprintf(out, "=== Profil ===\n");
+    fprintf(out, "Instructions : %llu, échantillons : %llu (période %u)\n",
+            (unsigned long long)prof->instructions, (unsigned long long)prof->samples, prof->period);
+
+    fprintf(out, "\n--- Classes d'opcodes ---\n");
+    for (int c = 0; c < 16; c++) {
+        if (prof->class_hits[c] == 0) continue;
+        fprintf(out, "%-10s %12llu  %5.1f %%\n", llmp16_class_name((uint8_t)c), (unsigned long long)prof->class_hits[c],
+                100.0 * prof->class_hits[c] / (prof->instructions ? prof->instructions : 1));
+    }
+
+    // sélection des <top> adresses les plus exécutées
+    uint32_t best[top > 0 ? top : 1];
+    int found = 0;
+    for (uint32_t slot = 0; slot < LLMP_PROF_SLOTS && top > 0; slot++) {
+        uint64_t hits = prof->addr_hits[slot];
+        if (hits == 0) continue;
+        if (found == top && hits <= prof->addr_hits[best[found - 1]]) continue;
+
+        int i = found < top ? found++ : top - 1;
+        while (i > 0 && prof->addr_hits[best[i - 1]] < hits) {
+            best[i] = best[i - 1];
+            i--;
+        }
+        best[i] = slot;
+    }
+
+    fprintf(out, "\n--- Adresses les plus exécutées ---\n");
+    for (int i = 0; i < found; i++) {
+        uint32_t addr = best[i] << 1;
+        fprintf(out, "0x%05X  %12llu  %5.1f %%  ", addr, (unsigned long long)prof->addr_hits[best[i]],
+                100.0 * prof->addr_hits[best[i]] / (prof->instructions ? prof->instructions : 1));
+        symbol_print(prof, addr, out);
+        fputc('\n', out);
+    }
+}
+
+void llmp16_profiler_free(llmp16_profiler_t *prof)
+{
+    free(prof->addr_hits);
+    free(prof->stacks);
+    free(prof->symbols);
+    prof->addr_hits = NULL;
+    prof->stacks = NULL;
+    prof->symbols = NULL;
+}
@@ -0,0 +1,66 @@
+#ifndef LLMP16_PROFILER_H
+#define LLMP16_PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "llmp16.h"
+
+/*
+ * Profileur invité pour LLMP16
+ * ----------------------------
+ * Optionnel : attaché à une VM par vm->profiler, il est appelé par llmp16_cpu_cycle() avant
+ * l'exécution de chaque instruction. Sans profileur, le coût se limite à un test de pointeur.
+ *
+ * - compte les exécutions par adresse (mot de 16 bits) et par classe d'opcode ;
+ * - suit la pile d'appels en observant CALL (0x80nD) et RET (0x7X0D) ;
+ * - tous les <period> cycles, enregistre la pile courante.
+ *
+ * Les piles sont écrites au format "folded" (une ligne "f1;f2;f3 N" par pile) accepté par
+ * flamegraph.pl et speedscope. Les adresses sont symbolisées avec la table de labels produite
+ * par `llmpasm.py -m` (une ligne "0xADDR label" par label).
+ */
+
+#define LLMP_PROF_MAX_DEPTH   64
+#define LLMP_PROF_SLOTS       (1 << 19)   /* un compteur par mot de l'espace 20 bits */
+
+typedef struct {
+    uint32_t addr;
+    char name[48];
+} llmp16_symbol_t;
+
+typedef struct {
+    uint32_t hash;
+    uint32_t depth;                        /* 0 = entrée libre */
+    uint32_t frames[LLMP_PROF_MAX_DEPTH + 1]; /* appels puis la feuille */
+    uint64_t samples;
+} llmp16_stack_entry_t;
+
+typedef struct llmp16_profiler_s {
+    uint32_t period;                       /* cycles entre deux échantillons */
+    uint32_t countdown;
+
+    uint64_t *addr_hits;                   /* exécutions par mot d'adresse */
+    uint64_t class_hits[16];               /* exécutions par classe d'opcode */
+    uint64_t instructions;
+    uint64_t samples;
+
+    uint32_t stack[LLMP_PROF_MAX_DEPTH];   /* adresses des fonctions appelées */
+    uint32_t depth;                        /* profondeur réelle (peut dépasser MAX_DEPTH) */
+
+    llmp16_stack_entry_t *stacks;          /* table de hachage des piles échantillonnées */
+    size_t stacks_capacity;
+    size_t stacks_count;
+
+    llmp16_symbol_t *symbols;              /* triés par adresse croissante */
+    size_t nb_symbols;
+} llmp16_profiler_t;
+
+int  llmp16_profiler_init(llmp16_profiler_t *prof, uint32_t period);
+int  llmp16_profiler_load_symbols(llmp16_profiler_t *prof, const char *path);
+void llmp16_profiler_hook(llmp16_profiler_t *prof, uint32_t pc, const instr_t *in);
+void llmp16_profiler_write_folded(const llmp16_profiler_t *prof, FILE *out);
+void llmp16_profiler_report(const llmp16_profiler_t *prof, FILE *out, int top);
+void llmp16_profiler_free(llmp16_profiler_t *prof);
+
+#endif // LLMP16_PROFILER_H
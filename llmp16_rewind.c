@@ -0,0 +1,240 @@
+#include "llmp16_rewind.h"
+#include "llmp16_debug.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static void save_state(const llmp16_t *vm, llmp16_machine_state_t *s)
+{
+    memcpy(s->R, vm->R, sizeof(s->R));
+    s->FLAGS = vm->FLAGS;
+    s->fault = vm->fault;
+    s->io_latch = vm->io_latch;
+    s->io_latch_addr = vm->io_latch_addr;
+    s->dma = vm->dma;
+    s->timer1 = vm->timer1;
+    s->timer2 = vm->timer2;
+    s->timer3 = vm->timer3;
+    memcpy(s->IO, vm->IO, sizeof(s->IO));
+    s->int_vector_pending = vm->int_vector_pending;
+    s->int_pending = vm->int_pending;
+    s->stats = vm->stats;
+    s->stats_next = vm->stats_next;
+    s->frame_credit = vm->frame_credit;
+}
+
+static void load_state(llmp16_t *vm, const llmp16_machine_state_t *s)
+{
+    memcpy(vm->R, s->R, sizeof(vm->R));
+    vm->FLAGS = s->FLAGS;
+    vm->fault = s->fault;
+    vm->io_latch = s->io_latch;
+    vm->io_latch_addr = s->io_latch_addr;
+    vm->dma = s->dma;
+    vm->timer1 = s->timer1;
+    vm->timer2 = s->timer2;
+    vm->timer3 = s->timer3;
+    memcpy(vm->IO, s->IO, sizeof(vm->IO));
+    vm->int_vector_pending = s->int_vector_pending;
+    vm->int_pending = s->int_pending;
+    vm->stats = s->stats;
+    vm->stats_next = s->stats_next;
+    vm->frame_credit = s->frame_credit;
+    vm->cpu_halted = false;     // pas d'instantané d'un CPU arrêté
+}
+
+int llmp16_rewind_init(llmp16_rewind_t *rw, size_t budget, uint64_t period)
+{
+    memset(rw, 0, sizeof(*rw));
+    rw->budget = budget;
+    rw->period = period ? period : LLMP_REWIND_PERIOD;
+
+    // chaque instantané coûte au moins la copie de la VRAM
+    rw->capacity = (uint32_t)(budget / LLMP_VRAM_SIZE);
+    if (rw->capacity < 2) {
+        fprintf(stderr, "Rewind : budget trop petit (minimum %u Ko)\n", 2 * LLMP_VRAM_SIZE / 1024);
+        return -1;
+    }
+    rw->ring = (llmp16_snapshot_t *)calloc(rw->capacity, sizeof(llmp16_snapshot_t));
+    return rw->ring == NULL ? -1 : 0;
+}
+
+static llmp16_snapshot_t *at(llmp16_rewind_t *rw, uint32_t i)
+{
+    return &rw->ring[(rw->first + i) % rw->capacity];
+}
+
+static void release(llmp16_rewind_t *rw, llmp16_snapshot_t *snap)
+{
+    rw->used -= LLMP_VRAM_SIZE + (size_t)snap->cap_pages * LLMP_PAGE_SIZE;
+    free(snap->vram);
+    free(snap->data);
+    free(snap->page);
+    memset(snap, 0, sizeof(*snap));
+}
+
+static void drop_oldest(llmp16_rewind_t *rw)
+{
+    release(rw, at(rw, 0));
+    rw->first = (rw->first + 1) % rw->capacity;
+    rw->count--;
+}
+
+static void drop_newest(llmp16_rewind_t *rw)
+{
+    release(rw, at(rw, rw->count - 1));
+    rw->count--;
+}
+
+void llmp16_rewind_free(llmp16_rewind_t *rw)
+{
+    while (rw->count > 0) drop_oldest(rw);
+    free(rw->ring);
+    rw->ring = NULL;
+}
+
+/* Pose ou retire le bit COW sur toutes les pages de RAM */
+static void mark_pages(llmp16_t *vm, bool cow)
+{
+    for (uint32_t p = 0; p < LLMP_PAGES; p++) {
+        llmp16_mem_page_t *page = &vm->pages[p];
+        uint8_t prot = cow && page->kind == LLMP_MEM_RAM ? page->prot | LLMP_PROT_COW : page->prot & ~LLMP_PROT_COW;
+        if (prot != page->prot) {
+            page->prot = prot;
+            llmp16_mem_refresh_page(vm, p);
+        }
+    }
+}
+
+void llmp16_rewind_attach(llmp16_t *vm, llmp16_rewind_t *rw)
+{
+    vm->rewind = rw;
+    llmp16_rewind_snapshot(vm);
+}
+
+void llmp16_rewind_detach(llmp16_t *vm)
+{
+    vm->rewind = NULL;
+    mark_pages(vm, false);
+}
+
+
+/*============================== Prise d'instantané ==============================*/
+
+void llmp16_rewind_snapshot(llmp16_t *vm)
+{
+    llmp16_rewind_t *rw = vm->rewind;
+    struct timespec t0, t1;
+
+    rw->next = vm->stats.cycles + rw->period;
+    if (vm->cpu_halted) return;     // arrêt du debugger ou HALT : rien à réexécuter
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    if (rw->count == rw->capacity) drop_oldest(rw);
+    llmp16_snapshot_t *snap = at(rw, rw->count);
+    snap->vram = (uint8_t *)malloc(LLMP_VRAM_SIZE);
+    if (snap->vram == NULL) return;
+    save_state(vm, &snap->state);
+    memcpy(snap->vram, vm->VRAM, LLMP_VRAM_SIZE);
+    rw->count++;
+    rw->used += LLMP_VRAM_SIZE;
+
+    // les pages encore COW n'ont pas changé depuis l'instantané précédent : elles le restent
+    mark_pages(vm, true);
+    while (rw->used > rw->budget && rw->count > 1) drop_oldest(rw);
+    rw->taken++;
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    uint64_t ns = (uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000000ull + (uint64_t)(t1.tv_nsec - t0.tv_nsec);
+    if (ns > rw->max_pause_ns) rw->max_pause_ns = ns;
+}
+
+void llmp16_rewind_save_page(llmp16_t *vm, uint32_t page)
+{
+    llmp16_rewind_t *rw = vm->rewind;
+
+    if (rw != NULL && rw->count > 0 && vm->pages[page].backing != NULL) {
+        llmp16_snapshot_t *snap = at(rw, rw->count - 1);
+        if (snap->nb_pages == snap->cap_pages) {
+            uint32_t cap = snap->cap_pages ? snap->cap_pages * 2 : 8;
+            void *data = realloc(snap->data, (size_t)cap * LLMP_PAGE_SIZE);
+            if (data != NULL) snap->data = (uint8_t (*)[LLMP_PAGE_SIZE])data;
+            void *num = realloc(snap->page, cap * sizeof(uint16_t));
+            if (num != NULL) snap->page = (uint16_t *)num;
+            if (data != NULL && num != NULL) {
+                rw->used += (size_t)(cap - snap->cap_pages) * LLMP_PAGE_SIZE;
+                snap->cap_pages = cap;
+            }
+        }
+        if (snap->nb_pages < snap->cap_pages) {
+            memcpy(snap->data[snap->nb_pages], vm->pages[page].backing, LLMP_PAGE_SIZE);
+            snap->page[snap->nb_pages++] = (uint16_t)page;
+        }
+    }
+    vm->pages[page].prot &= ~LLMP_PROT_COW;
+    llmp16_mem_refresh_page(vm, page);
+}
+
+
+/*============================== Retour en arrière ==============================*/
+
+/* Ramène la mémoire, la VRAM et l'état à l'instantané <k> et oublie les suivants */
+static void restore(llmp16_t *vm, uint32_t k)
+{
+    llmp16_rewind_t *rw = vm->rewind;
+
+    // du plus récent au plus ancien : l'image la plus ancienne d'une page l'emporte
+    for (uint32_t j = rw->count; j-- > k;) {
+        const llmp16_snapshot_t *snap = at(rw, j);
+        for (uint32_t i = 0; i < snap->nb_pages; i++)
+            memcpy(vm->pages[snap->page[i]].backing, snap->data[i], LLMP_PAGE_SIZE);
+    }
+
+    llmp16_snapshot_t *snap = at(rw, k);
+    load_state(vm, &snap->state);
+    memcpy(vm->VRAM, snap->vram, LLMP_VRAM_SIZE);
+    while (rw->count > k + 1) drop_newest(rw);
+    snap->nb_pages = 0;
+    mark_pages(vm, true);
+    rw->next = vm->stats.cycles + rw->period;
+}
+
+static uint64_t position(const llmp16_stats_t *stats, bool by_instr)
+{
+    return by_instr ? stats->instructions : stats->cycles;
+}
+
+static int seek(llmp16_t *vm, uint64_t target, bool by_instr)
+{
+    llmp16_rewind_t *rw = vm->rewind;
+    if (rw == NULL) return -1;
+
+    if (target < position(&vm->stats, by_instr)) {
+        uint32_t k = rw->count;
+        while (k > 0 && position(&at(rw, k - 1)->state.stats, by_instr) > target) k--;
+        if (k == 0) return -1;
+        restore(vm, k - 1);
+    }
+
+    // réexécution sans breakpoints ni watchpoints jusqu'à la cible ; un arrêt du debugger
+    // (breakpoint, watchpoint, pas) n'est pas un HALT, l'exécution repart de PC
+    llmp16_debug_t *dbg = vm->debug;
+    if (dbg != NULL && dbg->reason != LLMP_STOP_NONE && dbg->reason != LLMP_STOP_HALT) vm->cpu_halted = false;
+    vm->debug = NULL;
+    while (position(&vm->stats, by_instr) < target && !vm->cpu_halted && !vm->halted)
+        llmp16_step(vm);
+    vm->debug = dbg;
+    if (dbg != NULL) dbg->reason = LLMP_STOP_STEP;
+    return 0;
+}
+
+int llmp16_rewind_to_cycle(llmp16_t *vm, uint64_t target)
+{
+    return seek(vm, target, false);
+}
+
+int llmp16_rewind_to_instr(llmp16_t *vm, uint64_t target)
+{
+    return seek(vm, target, true);
+}
@@ -0,0 +1,83 @@
+#ifndef LLMP16_REWIND_H
+#define LLMP16_REWIND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "llmp16.h"
+
+/*
+ * Rembobinage pour LLMP16
+ * -----------------------
+ * Attaché à une VM par vm->rewind. Tous les <period> cycles (vérifié en fin de tranche, comme
+ * les relevés de compteurs), un instantané est pris : état du CPU et des périphériques, copie
+ * de la VRAM, puis toutes les pages de RAM reçoivent le bit LLMP_PROT_COW qui leur retire le
+ * pointeur d'écriture rapide. La première écriture dans une page passe par le chemin lent, qui
+ * copie la page dans l'instantané courant puis rend l'accès direct : un instantané ne coûte
+ * que les pages réellement modifiées, et la boucle principale n'a aucun test supplémentaire.
+ *
+ * Chaque instantané garde ainsi l'image "d'avant" des pages écrites jusqu'à l'instantané
+ * suivant. Pour revenir à l'instantané k, on recopie ces images du plus récent jusqu'à k.
+ * llmp16_rewind_to_cycle() / _to_instr() repartent de l'instantané le plus proche et
+ * réexécutent jusqu'à la cible, debugger suspendu.
+ *
+ * Les instantanés les plus anciens sont libérés dès que le budget mémoire est dépassé.
+ * Les entrées de l'hôte (clavier) reçues entre l'instantané et la cible ne sont pas
+ * réinjectées : pour une session interactive, rembobiner pendant un rejeu (-R).
+ */
+
+#define LLMP_REWIND_PERIOD   (CPU_FREQ / 10)       /* un instantané par 100 ms invitées */
+#define LLMP_REWIND_BUDGET   (64u << 20)           /* octets */
+
+/* État du CPU et des périphériques, hors mémoire et VRAM */
+typedef struct {
+    uint32_t R[16];
+    uint8_t  FLAGS;
+    llmp16_fault_t fault;
+    uint16_t io_latch;
+    uint32_t io_latch_addr;
+    llmp16_dma_t dma;
+    llmp16_timer_t timer1, timer2, timer3;
+    uint16_t IO[LLMP_IO_PORTS][LLMP_IO_REGS];
+    uint16_t int_vector_pending;
+    bool int_pending;
+    llmp16_stats_t stats;
+    uint64_t stats_next;
+    int64_t frame_credit;
+} llmp16_machine_state_t;
+
+typedef struct {
+    llmp16_machine_state_t state;
+    uint8_t *vram;                         /* copie complète (LLMP_VRAM_SIZE) */
+    uint8_t (*data)[LLMP_PAGE_SIZE];       /* images des pages avant leur première écriture */
+    uint16_t *page;                        /* numéro de page de chaque image */
+    uint32_t nb_pages, cap_pages;
+} llmp16_snapshot_t;
+
+typedef struct llmp16_rewind_s {
+    llmp16_snapshot_t *ring;
+    uint32_t capacity, first, count;
+    uint64_t period;
+    uint64_t next;                         /* cycle du prochain instantané */
+    size_t budget, used;
+
+    uint64_t taken;                        /* instantanés pris depuis l'attache */
+    uint64_t max_pause_ns;                 /* plus longue prise d'instantané */
+} llmp16_rewind_t;
+
+int  llmp16_rewind_init(llmp16_rewind_t *rw, size_t budget, uint64_t period);
+void llmp16_rewind_free(llmp16_rewind_t *rw);
+
+/* Attache le tampon à la VM et prend un premier instantané */
+void llmp16_rewind_attach(llmp16_t *vm, llmp16_rewind_t *rw);
+void llmp16_rewind_detach(llmp16_t *vm);
+
+void llmp16_rewind_snapshot(llmp16_t *vm);
+/* Ramène la VM au cycle / à l'instruction <target>, -1 si elle est plus ancienne que le tampon */
+int  llmp16_rewind_to_cycle(llmp16_t *vm, uint64_t target);
+int  llmp16_rewind_to_instr(llmp16_t *vm, uint64_t target);
+
+/* Appelé par le chemin lent à la première écriture dans une page LLMP_PROT_COW */
+void llmp16_rewind_save_page(llmp16_t *vm, uint32_t page);
+
+#endif // LLMP16_REWIND_H
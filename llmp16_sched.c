@@ -0,0 +1,215 @@
+#include "llmp16_sched.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+/*============================== File double ==============================*/
+
+static int deque_init(llmp16_deque_t *q, size_t capacity)
+{
+    q->slots = (size_t *)malloc(capacity * sizeof(size_t));
+    if (q->slots == NULL) return -1;
+    q->capacity = capacity;
+    q->head = 0;
+    q->count = 0;
+    pthread_mutex_init(&q->lock, NULL);
+    return 0;
+}
+
+static void deque_free(llmp16_deque_t *q)
+{
+    pthread_mutex_destroy(&q->lock);
+    free(q->slots);
+}
+
+static void deque_push(llmp16_deque_t *q, size_t task)
+{
+    pthread_mutex_lock(&q->lock);
+    q->slots[(q->head + q->count) % q->capacity] = task;
+    q->count++;
+    pthread_mutex_unlock(&q->lock);
+}
+
+/* Le propriétaire prend la tâche la plus ancienne : les VMs tournent en round-robin */
+static bool deque_pop_front(llmp16_deque_t *q, size_t *task)
+{
+    bool ok = false;
+    pthread_mutex_lock(&q->lock);
+    if (q->count > 0) {
+        *task = q->slots[q->head];
+        q->head = (q->head + 1) % q->capacity;
+        q->count--;
+        ok = true;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+/* Un voleur prend la tâche la plus récente, à l'opposé du propriétaire */
+static bool deque_pop_back(llmp16_deque_t *q, size_t *task)
+{
+    bool ok = false;
+    pthread_mutex_lock(&q->lock);
+    if (q->count > 0) {
+        q->count--;
+        *task = q->slots[(q->head + q->count) % q->capacity];
+        ok = true;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+
+/*============================== Threads ==============================*/
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static bool steal(llmp16_worker_t *self, size_t *task)
+{
+    llmp16_sched_t *sched = self->sched;
+    for (int k = 1; k < sched->nb_workers; k++) {
+        llmp16_worker_t *victim = &sched->workers[(self->id + k) % sched->nb_workers];
+        if (deque_pop_back(&victim->queue, task)) {
+            self->steals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void *worker_main(void *arg)
+{
+    llmp16_worker_t *self = (llmp16_worker_t *)arg;
+    llmp16_sched_t *sched = self->sched;
+    size_t t;
+
+    while (atomic_load(&sched->remaining) > 0) {
+        // rien dans la file ni chez les autres : chaque VM encore active est en cours
+        // d'exécution sur un autre thread, qui la remet dans sa propre file ; ce thread n'aura
+        // plus de travail et s'arrête au lieu de tourner à vide
+        if (!deque_pop_front(&self->queue, &t) && !steal(self, &t))
+            break;
+
+        llmp16_task_t *task = &sched->tasks[t];
+        uint32_t quota = sched->slice;
+        if (sched->budget && sched->budget - task->executed < quota)
+            quota = (uint32_t)(sched->budget - task->executed);
+
+        uint32_t done = llmp16_run_slice(task->vm, quota);
+        llmp16_video_tick(task->vm);
+        task->executed += done;
+        self->executed += done;
+
+        bool finished = task->vm->cpu_halted || task->vm->halted
+                     || (sched->budget && task->executed >= sched->budget);
+        if (finished)
+            atomic_fetch_sub(&sched->remaining, 1);
+        else
+            deque_push(&self->queue, t);
+    }
+    return NULL;
+}
+
+
+/*============================== API ==============================*/
+
+int llmp16_sched_init(llmp16_sched_t *sched, llmp16_t **vms, size_t nb_vms, int nb_workers,
+                      uint32_t slice, uint64_t budget)
+{
+    if (nb_workers < 1) nb_workers = 1;
+    if (nb_workers > LLMP_SCHED_MAX_WORKERS) nb_workers = LLMP_SCHED_MAX_WORKERS;
+
+    sched->nb_tasks = nb_vms;
+    sched->nb_workers = nb_workers;
+    sched->slice = slice ? slice : LLMP_SCHED_SLICE;
+    sched->budget = budget;
+    sched->elapsed = 0.0;
+    atomic_init(&sched->remaining, 0);
+
+    sched->tasks = (llmp16_task_t *)calloc(nb_vms, sizeof(llmp16_task_t));
+    sched->workers = (llmp16_worker_t *)calloc(nb_workers, sizeof(llmp16_worker_t));
+    if (sched->tasks == NULL || sched->workers == NULL) {
+        free(sched->tasks);
+        free(sched->workers);
+        return -1;
+    }
+
+    for (int w = 0; w < nb_workers; w++) {
+        sched->workers[w].sched = sched;
+        sched->workers[w].id = w;
+        // chaque file doit pouvoir contenir toutes les VMs, le vol peut les concentrer
+        if (deque_init(&sched->workers[w].queue, nb_vms ? nb_vms : 1) != 0) {
+            sched->nb_workers = w;
+            llmp16_sched_free(sched);
+            return -1;
+        }
+    }
+
+    for (size_t i = 0; i < nb_vms; i++)
+        sched->tasks[i].vm = vms[i];
+
+    return 0;
+}
+
+void llmp16_sched_run(llmp16_sched_t *sched)
+{
+    size_t active = 0;
+
+    // distribution initiale en round-robin sur les threads
+    for (size_t i = 0; i < sched->nb_tasks; i++) {
+        llmp16_t *vm = sched->tasks[i].vm;
+        if (vm->cpu_halted || vm->halted) continue;
+        deque_push(&sched->workers[active % sched->nb_workers].queue, i);
+        active++;
+    }
+    atomic_store(&sched->remaining, active);
+
+    double start = now_seconds();
+    for (int w = 0; w < sched->nb_workers; w++)
+        pthread_create(&sched->workers[w].thread, NULL, worker_main, &sched->workers[w]);
+    for (int w = 0; w < sched->nb_workers; w++)
+        pthread_join(sched->workers[w].thread, NULL);
+    sched->elapsed += now_seconds() - start;
+}
+
+uint64_t llmp16_sched_instructions(const llmp16_sched_t *sched)
+{
+    uint64_t total = 0;
+    for (int w = 0; w < sched->nb_workers; w++)
+        total += sched->workers[w].executed;
+    return total;
+}
+
+void llmp16_sched_report(const llmp16_sched_t *sched, FILE *out)
+{
+    uint64_t total = llmp16_sched_instructions(sched);
+    double ips = sched->elapsed > 0.0 ? total / sched->elapsed : 0.0;
+
+    fprintf(out, "=== Ordonnanceur ===\n");
+    fprintf(out, "VMs          : %zu\n", sched->nb_tasks);
+    fprintf(out, "Threads      : %d\n", sched->nb_workers);
+    fprintf(out, "Instructions : %llu\n", (unsigned long long)total);
+    fprintf(out, "Durée        : %.3f s\n", sched->elapsed);
+    fprintf(out, "Débit        : %.2f MIPS\n", ips / 1e6);
+    for (int w = 0; w < sched->nb_workers; w++) {
+        fprintf(out, "  thread %2d : %llu instructions, %llu vols\n", w,
+                (unsigned long long)sched->workers[w].executed,
+                (unsigned long long)sched->workers[w].steals);
+    }
+}
+
+void llmp16_sched_free(llmp16_sched_t *sched)
+{
+    for (int w = 0; w < sched->nb_workers; w++)
+        deque_free(&sched->workers[w].queue);
+    free(sched->workers);
+    free(sched->tasks);
+    sched->workers = NULL;
+    sched->tasks = NULL;
+}
@@ -0,0 +1,73 @@
+#ifndef LLMP16_SCHED_H
+#define LLMP16_SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "llmp16.h"
+
+/*
+ * Ordonnanceur multi-VM pour LLMP16
+ * ---------------------------------
+ * Répartit un ensemble de machines virtuelles headless sur un pool de threads.
+ * Chaque VM est exécutée par tranches de <slice> instructions ; après chaque tranche
+ * elle est remise dans la file du thread qui l'a exécutée. Un thread dont la file est
+ * vide vole une VM dans la file d'un autre thread (work-stealing). Un thread qui ne trouve
+ * rien à voler s'arrête : il reste alors moins de VMs actives que de threads.
+ *
+ * Une VM quitte l'ordonnanceur lorsqu'elle exécute HALT, qu'elle est éteinte, ou qu'elle
+ * a consommé son quota total <budget> (0 = pas de limite).
+ */
+
+#define LLMP_SCHED_MAX_WORKERS  64
+#define LLMP_SCHED_SLICE        10000   /* instructions par tranche par défaut */
+
+typedef struct {
+    llmp16_t *vm;
+    uint64_t executed;               /* instructions exécutées par cette VM */
+} llmp16_task_t;
+
+/* File double d'indices de tâches : le propriétaire prend en tête, les voleurs en queue */
+typedef struct {
+    pthread_mutex_t lock;
+    size_t *slots;
+    size_t capacity;
+    size_t head;
+    size_t count;
+} llmp16_deque_t;
+
+typedef struct llmp16_sched_s llmp16_sched_t;
+
+typedef struct {
+    llmp16_sched_t *sched;
+    pthread_t thread;
+    int id;
+    llmp16_deque_t queue;
+    uint64_t executed;               /* instructions exécutées par ce thread */
+    uint64_t steals;                 /* nombre de VMs volées */
+} llmp16_worker_t;
+
+struct llmp16_sched_s {
+    llmp16_task_t *tasks;
+    size_t nb_tasks;
+
+    llmp16_worker_t *workers;
+    int nb_workers;
+
+    uint32_t slice;                  /* quota d'instructions par tranche */
+    uint64_t budget;                 /* quota total par VM (0 = jusqu'au HALT) */
+
+    atomic_size_t remaining;         /* VMs encore actives */
+    double elapsed;                  /* durée cumulée des llmp16_sched_run() en secondes */
+};
+
+int  llmp16_sched_init(llmp16_sched_t *sched, llmp16_t **vms, size_t nb_vms, int nb_workers,
+                       uint32_t slice, uint64_t budget);
+void llmp16_sched_run(llmp16_sched_t *sched);
+uint64_t llmp16_sched_instructions(const llmp16_sched_t *sched);
+void llmp16_sched_report(const llmp16_sched_t *sched, FILE *out);
+void llmp16_sched_free(llmp16_sched_t *sched);
+
+#endif // LLMP16_SCHED_H
@@ -5,35 +5,135 @@
 #include "llmp16.h"
 
 
+/* Composante de <bits> bits étendue à 8 bits, pondérée par <weight> / 64 */
+static uint32_t channel(uint32_t v, uint32_t bits, uint32_t weight)
+{
+    return (v * 255 / ((1u << bits) - 1)) * weight / 64;
+}
+
+void llmp16_screen_setup(llmp16_screen_t *screen)
+{
+    if (screen->scale < 1 || screen->scale > LLMP_SCREEN_SCALE_MAX) screen->scale = LLMP_SCREEN_SCALE;
+    // les effets ont besoin d'au moins deux lignes et deux colonnes par pixel
+    bool effects = screen->scale > 1 && screen->filter != LLMP_FILTER_NONE;
+    bool mask = effects && screen->filter == LLMP_FILTER_CRT;
+
+    for (int dark = 0; dark < 2; dark++)
+        for (int phase = 0; phase < 3; phase++)
+            for (int p = 0; p < 256; p++) {
+                uint32_t w[3] = { 64, 64, 64 };
+                for (int c = 0; c < 3; c++) {
+                    if (dark && effects) w[c] = w[c] * 5 / 8;
+                    if (mask && c != phase) w[c] = w[c] * 6 / 8;
+                }
+                screen->lut[dark][phase][p] = channel(p >> 5, 3, w[0]) << 16
+                                            | channel((p >> 2) & 7, 3, w[1]) << 8
+                                            | channel(p & 3, 2, w[2]);
+            }
+}
+
+/* Une ligne agrandie horizontalement : un facteur constant par boucle laisse le compilateur
+   dérouler et vectoriser les écritures */
+static void scale_line(uint32_t *out, const uint8_t *src, const uint32_t *lut, int scale)
+{
+    switch (scale) {
+    case 1:
+        for (int x = 0; x < LLMP_SCREEN_WIDTH; x++) out[x] = lut[src[x]];
+        break;
+    case 2:
+        for (int x = 0; x < LLMP_SCREEN_WIDTH; x++) {
+            uint32_t p = lut[src[x]];
+            out[2 * x] = p; out[2 * x + 1] = p;
+        }
+        break;
+    case 3:
+        for (int x = 0; x < LLMP_SCREEN_WIDTH; x++) {
+            uint32_t p = lut[src[x]];
+            out[3 * x] = p; out[3 * x + 1] = p; out[3 * x + 2] = p;
+        }
+        break;
+    default:
+        for (int x = 0; x < LLMP_SCREEN_WIDTH; x++) {
+            uint32_t p = lut[src[x]];
+            out[4 * x] = p; out[4 * x + 1] = p; out[4 * x + 2] = p; out[4 * x + 3] = p;
+        }
+        break;
+    }
+}
+
+/* Même chose avec le masque CRT : la table suit la colonne de sortie modulo 3 */
+static void mask_line(uint32_t *out, const uint8_t *src, const uint32_t lut[3][256], int scale)
+{
+    int phase = 0;
+    for (int x = 0; x < LLMP_SCREEN_WIDTH; x++)
+        for (int k = 0; k < scale; k++) {
+            *out++ = lut[phase][src[x]];
+            if (++phase == 3) phase = 0;
+        }
+}
+
+void llmp16_screen_scale(const llmp16_screen_t *screen, const uint8_t *frame, uint32_t *dst, int pitch)
+{
+    const int scale = screen->scale;
+    const bool effects = scale > 1 && screen->filter != LLMP_FILTER_NONE;
+    const bool mask = effects && screen->filter == LLMP_FILTER_CRT;
+    const size_t width = (size_t)LLMP_SCREEN_WIDTH * scale * sizeof(uint32_t);
+
+    for (int y = 0; y < LLMP_SCREEN_HEIGHT; y++) {
+        const uint8_t *src = frame + y * LLMP_SCREEN_WIDTH;
+        uint8_t *row = (uint8_t *)dst + (size_t)y * scale * pitch;
+        if (mask) mask_line((uint32_t *)row, src, screen->lut[0], scale);
+        else scale_line((uint32_t *)row, src, screen->lut[0][0], scale);
+        // les lignes suivantes du groupe sont des copies, sauf la ligne sombre
+        for (int k = 1; k < scale; k++) {
+            uint32_t *out = (uint32_t *)(row + (size_t)k * pitch);
+            if (k < scale - 1 || !effects) memcpy(out, row, width);
+            else if (mask) mask_line(out, src, screen->lut[1], scale);
+            else scale_line(out, src, screen->lut[1][0], scale);
+        }
+    }
+}
+
+
+/* SDL_InitSubSystem()/SDL_QuitSubSystem() sont comptés par référence : chaque VM qui ouvre une
+   fenêtre prend une référence sur le sous-système vidéo sans perturber les autres instances. */
 int llmp16_screen_init(llmp16_screen_t *screen)
 {
-    if(0 != SDL_Init(SDL_INIT_VIDEO))
+    screen->window = NULL;
+    screen->renderer = NULL;
+    screen->framebuffer = NULL;
+    llmp16_screen_setup(screen);
+    const int width = LLMP_SCREEN_WIDTH * screen->scale, height = LLMP_SCREEN_HEIGHT * screen->scale;
+
+    if(0 != SDL_InitSubSystem(SDL_INIT_VIDEO))
     {
         fprintf(stderr, "Erreur SDL_Init : %s", SDL_GetError());
-        SDL_Quit();
         return EXIT_FAILURE;
     }
 
     screen->window = SDL_CreateWindow("LLMP-16", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 
-        LLMP_WINDOW_WIDTH, LLMP_WINDOW_HEIGHT, SDL_WINDOW_SHOWN);
+        width, height, SDL_WINDOW_SHOWN);
     
     if(NULL == screen->window)
     {
         fprintf(stderr, "Erreur SDL_CreateWindow : %s", SDL_GetError());
-        SDL_Quit();
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
         return EXIT_FAILURE;
     }
 
+    // la texture est déjà à la taille de la fenêtre : le renderer logiciel suffit sans GPU
     screen->renderer = SDL_CreateRenderer(screen->window, -1, SDL_RENDERER_ACCELERATED);
+    if(screen->renderer == NULL)
+        screen->renderer = SDL_CreateRenderer(screen->window, -1, SDL_RENDERER_SOFTWARE);
 
     if(screen->renderer == NULL)
     {
         fprintf(stderr, "Erreur SDL_CreateRenderer : %s", SDL_GetError());
-        SDL_Quit();
+        llmp16_screen_off(screen);
         return EXIT_FAILURE;
     }
 
-    screen->framebuffer = SDL_CreateTexture(screen->renderer, SDL_PIXELFORMAT_RGB332, SDL_TEXTUREACCESS_STREAMING, LLMP_SCREEN_WIDTH, LLMP_SCREEN_HEIGHT);
+    screen->framebuffer = SDL_CreateTexture(screen->renderer, SDL_PIXELFORMAT_RGB888, SDL_TEXTUREACCESS_STREAMING, width, height);
 
     if(screen->framebuffer == NULL)
     {
@@ -48,21 +148,28 @@ int llmp16_screen_init(llmp16_screen_t *screen)
 
 void llmp16_screen_off(llmp16_screen_t *screen)
 {
+    if(screen->window == NULL) return; // VM sans affichage
+
     if(screen->framebuffer != NULL) SDL_DestroyTexture(screen->framebuffer);
     if(screen->renderer != NULL) SDL_DestroyRenderer(screen->renderer);
-    if(screen->window != NULL) SDL_DestroyWindow(screen->window);
-    SDL_Quit();
+    SDL_DestroyWindow(screen->window);
+    screen->framebuffer = NULL;
+    screen->renderer = NULL;
+    screen->window = NULL;
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
 }
 
 
-void llmp16_screen_render(llmp16_screen_t screen,uint8_t* VRAM)
+void llmp16_screen_render(llmp16_screen_t *screen, const uint8_t* VRAM)
 {
-    SDL_UpdateTexture(screen.framebuffer, NULL,
-                  VRAM, LLMP_SCREEN_WIDTH);
-    SDL_RenderClear(screen.renderer);
-    SDL_RenderCopy(screen.renderer, screen.framebuffer, NULL, NULL);
-    SDL_RenderPresent(screen.renderer);
+    if(screen->framebuffer == NULL) return;
 
+    void *pixels;
+    int pitch;
+    if(SDL_LockTexture(screen->framebuffer, NULL, &pixels, &pitch) != 0) return;
+    llmp16_screen_scale(screen, VRAM, (uint32_t *)pixels, pitch);
+    SDL_UnlockTexture(screen->framebuffer);
 
+    SDL_RenderCopy(screen->renderer, screen->framebuffer, NULL, NULL);
+    SDL_RenderPresent(screen->renderer);
 }
-
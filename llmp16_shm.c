@@ -0,0 +1,213 @@
+#define _GNU_SOURCE             /* syscall() malgré -D_POSIX_C_SOURCE */
+#include "llmp16_shm.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <limits.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+#define SHM_IMAGE_SIZE (LLMP_SCREEN_WIDTH * LLMP_SCREEN_HEIGHT)
+
+static llmp16_shm_slot_t *slot_at(const llmp16_shm_header_t *h, uint64_t seq)
+{
+    uint8_t *base = (uint8_t *)h + sizeof(llmp16_shm_header_t);
+    return (llmp16_shm_slot_t *)(base + (size_t)(seq % h->slots) * h->slot_size);
+}
+
+static uint64_t now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* Futex partagé entre processus : pas de FUTEX_PRIVATE_FLAG */
+static void futex_wake(_Atomic uint32_t *word)
+{
+#ifdef __linux__
+    syscall(SYS_futex, (uint32_t *)word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#else
+    (void)word;
+#endif
+}
+
+static void futex_wait(_Atomic uint32_t *word, uint32_t value, int timeout_ms)
+{
+    struct timespec ts = { timeout_ms / 1000, (long)(timeout_ms % 1000) * 1000000 };
+#ifdef __linux__
+    syscall(SYS_futex, (uint32_t *)word, FUTEX_WAIT, value, &ts, NULL, 0);
+#else
+    // sans futex : on réinterroge toutes les millisecondes
+    (void)word; (void)value;
+    ts.tv_sec = 0;
+    ts.tv_nsec = 1000000;
+    nanosleep(&ts, NULL);
+#endif
+}
+
+
+/*============================== Émulateur ==============================*/
+
+int llmp16_shm_create(llmp16_shm_t *shm, const char *name, uint32_t slots)
+{
+    memset(shm, 0, sizeof(*shm));
+    if (slots < 2) slots = LLMP_SHM_SLOTS;
+    snprintf(shm->name, sizeof(shm->name), "%s", name);
+
+    // un segment laissé par une exécution précédente est remplacé, ses lecteurs gardent l'ancien
+    shm_unlink(shm->name);
+    int fd = shm_open(shm->name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        perror("Shm open error");
+        return -1;
+    }
+    uint32_t slot_size = (sizeof(llmp16_shm_slot_t) + SHM_IMAGE_SIZE + 63) & ~63u;
+    shm->size = sizeof(llmp16_shm_header_t) + (size_t)slots * slot_size;
+    if (ftruncate(fd, (off_t)shm->size) != 0) {
+        perror("Shm truncate error");
+        close(fd);
+        shm_unlink(shm->name);
+        return -1;
+    }
+    void *map = mmap(NULL, shm->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("Shm map error");
+        shm_unlink(shm->name);
+        return -1;
+    }
+
+    llmp16_shm_header_t *h = (llmp16_shm_header_t *)map;
+    h->width = LLMP_SCREEN_WIDTH;
+    h->height = LLMP_SCREEN_HEIGHT;
+    h->slots = slots;
+    h->slot_size = slot_size;
+    // le magic en dernier : un lecteur qui le voit trouve une géométrie complète
+    atomic_thread_fence(memory_order_release);
+    memcpy(h->magic, LLMP_SHM_MAGIC, sizeof(h->magic));
+
+    shm->header = h;
+    shm->owner = true;
+    return 0;
+}
+
+void llmp16_shm_close(llmp16_shm_t *shm)
+{
+    if (shm->header == NULL) return;
+    if (shm->owner) {
+        // réveille les lecteurs bloqués pour qu'ils voient la fermeture
+        atomic_store(&shm->header->closed, 1);
+        atomic_fetch_add(&shm->header->futex, 1);
+        futex_wake(&shm->header->futex);
+        shm_unlink(shm->name);
+    }
+    munmap(shm->header, shm->size);
+    shm->header = NULL;
+}
+
+void llmp16_shm_publish(llmp16_shm_t *shm, const llmp16_t *vm, const uint8_t *image)
+{
+    llmp16_shm_header_t *h = shm->header;
+    uint64_t n = atomic_load_explicit(&h->seq, memory_order_relaxed) + 1;
+    llmp16_shm_slot_t *slot = slot_at(h, n);
+
+    // slot marqué en cours d'écriture avant d'y toucher, un lecteur en retard le verra
+    atomic_store_explicit(&slot->seq, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot->cycles = vm->stats.cycles;
+    slot->instructions = vm->stats.instructions;
+    memcpy((uint8_t *)(slot + 1), image, SHM_IMAGE_SIZE);
+    atomic_store_explicit(&slot->seq, n, memory_order_release);
+
+    // ordre séquentiel : un lecteur qui s'inscrit dans <waiters> après ce test voit le nouveau mot
+    atomic_store(&h->seq, n);
+    atomic_store(&h->futex, (uint32_t)n);
+    if (atomic_load(&h->waiters) != 0) futex_wake(&h->futex);
+
+    shm->published++;
+}
+
+
+/*============================== Lecteurs ==============================*/
+
+int llmp16_shm_open(llmp16_shm_t *shm, const char *name)
+{
+    memset(shm, 0, sizeof(*shm));
+    snprintf(shm->name, sizeof(shm->name), "%s", name);
+
+    int fd = shm_open(shm->name, O_RDWR, 0);
+    if (fd < 0) {
+        perror("Shm open error");
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(llmp16_shm_header_t)) {
+        fprintf(stderr, "Shm : segment %s vide ou illisible\n", shm->name);
+        close(fd);
+        return -1;
+    }
+    shm->size = (size_t)st.st_size;
+    void *map = mmap(NULL, shm->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror("Shm map error");
+        return -1;
+    }
+
+    llmp16_shm_header_t *h = (llmp16_shm_header_t *)map;
+    if (memcmp(h->magic, LLMP_SHM_MAGIC, sizeof(h->magic)) != 0 || h->slots == 0
+        || sizeof(llmp16_shm_header_t) + (size_t)h->slots * h->slot_size > shm->size
+        || h->width * h->height + sizeof(llmp16_shm_slot_t) > h->slot_size) {
+        fprintf(stderr, "Shm : %s n'est pas un anneau d'images LLMP16\n", shm->name);
+        munmap(map, shm->size);
+        return -1;
+    }
+    atomic_thread_fence(memory_order_acquire);
+    shm->header = h;
+    return 0;
+}
+
+uint64_t llmp16_shm_wait(llmp16_shm_t *shm, uint64_t last, int timeout_ms)
+{
+    llmp16_shm_header_t *h = shm->header;
+    uint64_t deadline = now_ms() + (uint64_t)(timeout_ms > 0 ? timeout_ms : 0);
+
+    for (;;) {
+        uint32_t word = atomic_load(&h->futex);
+        uint64_t seq = atomic_load(&h->seq);
+        if (seq != last || atomic_load(&h->closed)) return seq;
+        uint64_t now = now_ms();
+        if (now >= deadline) return last;
+
+        // le noyau ne dort que si le mot vaut encore <word> : pas de réveil perdu
+        atomic_fetch_add(&h->waiters, 1);
+        futex_wait(&h->futex, word, (int)(deadline - now));
+        atomic_fetch_sub(&h->waiters, 1);
+    }
+}
+
+const uint8_t *llmp16_shm_image(const llmp16_shm_t *shm, uint64_t seq, const llmp16_shm_slot_t **slot)
+{
+    if (seq == 0) return NULL;
+    const llmp16_shm_slot_t *s = slot_at(shm->header, seq);
+    if (atomic_load_explicit(&s->seq, memory_order_acquire) != seq) return NULL;
+    if (slot != NULL) *slot = s;
+    return (const uint8_t *)(s + 1);
+}
+
+bool llmp16_shm_valid(const llmp16_shm_t *shm, uint64_t seq)
+{
+    // les lectures des pixels ne doivent pas passer après ce test
+    atomic_thread_fence(memory_order_acquire);
+    const llmp16_shm_slot_t *s = slot_at(shm->header, seq);
+    return atomic_load_explicit(&s->seq, memory_order_relaxed) == seq;
+}
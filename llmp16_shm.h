@@ -0,0 +1,78 @@
+#ifndef LLMP16_SHM_H
+#define LLMP16_SHM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "llmp16.h"
+
+/*
+ * Export des images en mémoire partagée
+ * -------------------------------------
+ * Chaque image terminée (celle de llmp16_video_frame, RGB332) est publiée dans un anneau POSIX
+ * (shm_open) que d'autres processus - visualiseur, enregistreur, tests - lisent sur place, sans
+ * copie. L'émulateur n'attend jamais : il réécrit le slot suivant même si un lecteur y lit
+ * encore, et c'est au lecteur de vérifier après coup que son slot n'a pas changé.
+ *
+ * Segment : llmp16_shm_header_t, puis <slots> slots de <slot_size> octets, chacun
+ * llmp16_shm_slot_t suivi des pixels. Publication de l'image n (1, 2, ...) dans le slot n % slots :
+ *   slot.seq <- 0, copie des pixels, slot.seq <- n, header.seq <- n,
+ *   header.futex <- n (32 bits bas), FUTEX_WAKE seulement si header.waiters != 0.
+ * Lecture de l'image n : pixels valides si slot.seq vaut n avant ET après leur lecture
+ * (llmp16_shm_image puis llmp16_shm_valid). L'attente d'une nouvelle image se fait sur le mot
+ * header.futex (futex partagé sous Linux, interrogation périodique ailleurs).
+ *
+ * Tous les champs sont little-endian, le segment n'est lu que sur la même machine.
+ */
+
+#define LLMP_SHM_MAGIC "LLMPSHM1"
+#define LLMP_SHM_SLOTS 4                 /* trois images d'avance pour un lecteur lent */
+
+typedef struct {
+    char magic[8];
+    uint32_t width, height;              /* pixels RGB332, <width> octets par ligne */
+    uint32_t slots;
+    uint32_t slot_size;                  /* octets entre deux slots, en-tête du slot compris */
+    _Atomic uint64_t seq;                /* dernière image publiée (0 = aucune) */
+    _Atomic uint32_t futex;              /* 32 bits bas de <seq>, mot d'attente des lecteurs */
+    _Atomic uint32_t waiters;            /* lecteurs bloqués sur <futex> */
+    _Atomic uint32_t closed;             /* 1 quand l'émulateur a fermé l'anneau */
+    uint8_t pad[20];
+} llmp16_shm_header_t;
+
+typedef struct {
+    _Atomic uint64_t seq;                /* image contenue, 0 pendant l'écriture */
+    uint64_t cycles;                     /* vm->stats.cycles à la publication */
+    uint64_t instructions;               /* vm->stats.instructions à la publication */
+    uint8_t pad[40];
+} llmp16_shm_slot_t;
+
+typedef struct llmp16_shm_s {
+    llmp16_shm_header_t *header;         /* segment projeté */
+    size_t size;
+    char name[64];
+    bool owner;                          /* créateur : détruit le segment à la fermeture */
+    uint64_t published;                  /* images publiées par ce processus */
+} llmp16_shm_t;
+
+/* Émulateur : crée (ou remplace) le segment <name>, "/llmp16" par exemple ; ne fait pas
+   l'attache (vm->shm). La fermeture détruit le segment créé. */
+int  llmp16_shm_create(llmp16_shm_t *shm, const char *name, uint32_t slots);
+void llmp16_shm_close(llmp16_shm_t *shm);
+
+/* Publie <image> (LLMP_SCREEN_WIDTH x LLMP_SCREEN_HEIGHT), ne bloque jamais ; appelé par
+   llmp16_video_present() */
+void llmp16_shm_publish(llmp16_shm_t *shm, const llmp16_t *vm, const uint8_t *image);
+
+/* Lecteur : projette un segment existant (seul <waiters> y est écrit) */
+int  llmp16_shm_open(llmp16_shm_t *shm, const char *name);
+/* Attend une image plus récente que <last> au plus <timeout_ms> ms ; rend la dernière publiée
+   (<last> si rien de nouveau) */
+uint64_t llmp16_shm_wait(llmp16_shm_t *shm, uint64_t last, int timeout_ms);
+/* Pixels et slot de l'image <seq>, NULL si elle n'est plus dans l'anneau */
+const uint8_t *llmp16_shm_image(const llmp16_shm_t *shm, uint64_t seq, const llmp16_shm_slot_t **slot);
+/* Vrai si l'image <seq> n'a pas été réécrite depuis llmp16_shm_image */
+bool llmp16_shm_valid(const llmp16_shm_t *shm, uint64_t seq);
+
+#endif // LLMP16_SHM_H
@@ -0,0 +1,73 @@
+#include "llmp16.h"
+#include "llmp16_debug.h"
+#include <stdio.h>
+#include <string.h>
+
+
+void llmp16_stats_get(const llmp16_t *vm, llmp16_stats_t *out)
+{
+    memcpy(out, &vm->stats, sizeof(*out));
+}
+
+void llmp16_stats_write_json(const llmp16_t *vm, FILE *out)
+{
+    const llmp16_stats_t *s = &vm->stats;
+    fprintf(out, "{\"vm\":\"%p\",\"instructions\":%llu,\"cycles\":%llu,\"frames\":%llu,"
+                 "\"blits\":%llu,\"blit_pixels\":%llu,\"dma_transfers\":%llu,\"dma_bytes\":%llu,"
+                 "\"vram_writes\":%llu,\"io_reads\":%llu,\"io_writes\":%llu,\"interrupts\":%llu,"
+                 "\"mem_faults\":%llu}\n",
+            (const void *)vm,
+            (unsigned long long)s->instructions, (unsigned long long)s->cycles,
+            (unsigned long long)s->frames, (unsigned long long)s->blits,
+            (unsigned long long)s->blit_pixels, (unsigned long long)s->dma_transfers,
+            (unsigned long long)s->dma_bytes, (unsigned long long)s->vram_writes,
+            (unsigned long long)s->io_reads, (unsigned long long)s->io_writes,
+            (unsigned long long)s->interrupts, (unsigned long long)s->mem_faults);
+}
+
+/* Active un relevé JSON tous les <period> cycles (vérifié en fin de tranche), NULL pour désactiver */
+void llmp16_stats_set_dump(llmp16_t *vm, FILE *out, uint64_t period)
+{
+    vm->stats_out = out;
+    vm->stats_period = period ? period : CYCLES_PER_FRAME;
+    vm->stats_next = vm->stats.cycles + vm->stats_period;
+}
+
+/* Copie les compteurs dans les registres du port $F */
+void llmp16_stats_latch(llmp16_t *vm)
+{
+    uint16_t *regs = vm->IO[LLMP_STATS_PORT];
+    for (int i = 0; i < 4; i++) {
+        regs[LLMP_STATS_REG_CYCLES + i] = (uint16_t)(vm->stats.cycles >> (16 * i));
+        regs[LLMP_STATS_REG_INSTR + i]  = (uint16_t)(vm->stats.instructions >> (16 * i));
+    }
+    regs[LLMP_STATS_REG_FRAMES]     = (uint16_t)vm->stats.frames;
+    regs[LLMP_STATS_REG_FRAMES + 1] = (uint16_t)(vm->stats.frames >> 16);
+}
+
+
+/*============================== Accès IN/OUT ==============================*/
+
+uint16_t llmp16_io_read(llmp16_t *vm, uint8_t port, uint8_t reg)
+{
+    vm->stats.io_reads++;
+    if (port == LLMP_STATS_PORT && reg == LLMP_STATS_REG_CYCLES)
+        llmp16_stats_latch(vm);
+
+    uint16_t value = vm->IO[port][reg];
+    if (vm->debug) llmp16_debug_io(vm, port, reg, false, value);
+    if (port == 1) {
+        // on consomme la donnée clavier
+        vm->IO[1][0] = 0;
+    }
+    return value;
+}
+
+void llmp16_io_write(llmp16_t *vm, uint8_t port, uint8_t reg, uint16_t value)
+{
+    vm->stats.io_writes++;
+    if (vm->debug) llmp16_debug_io(vm, port, reg, true, value);
+    if (port == LLMP_STATS_PORT) return;   // compteurs en lecture seule
+
+    vm->IO[port][reg] = value;
+}
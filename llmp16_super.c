@@ -0,0 +1,270 @@
+#include "llmp16.h"
+#include <stdlib.h>
+
+/*
+ * Cache de prédécodage et superinstructions
+ * Les groupes retenus viennent d'un profil des paires d'opcodes exécutées par les ROMs de bench :
+ *   INC INC                16.6 %   (pointeurs de memcpy, vcopy)
+ *   CMPI Jcc               10.1 %   (fin de boucle)
+ *   INC CMPI               9.6 %    (suivi du Jcc : compteur de boucle complet)
+ *   LD STR                 5.5 %    (copie de mots)
+ *   VSTR INC               5.3 %    (remplissage de la VRAM, llmpasm/test.asm)
+ *   ADD MOV r15            2.7 %    (ALU vers ACC puis recopie)
+ *   DEC Jcc                2.6 %
+ * Les groupes ne contiennent ni IN/OUT ni saut au milieu : les périphériques (blitter, DMA),
+ * qui ne démarrent que sur une écriture IO, ne peuvent pas changer d'état entre deux
+ * instructions d'un groupe.
+ */
+
+#define LLMP_PREDECODE_BITS  12
+#define LLMP_PREDECODE_SIZE  (1u << LLMP_PREDECODE_BITS)
+#define LLMP_GROUP_MAX       3
+#define LLMP_GROUP_WORDS     (2 * LLMP_GROUP_MAX)
+
+typedef enum {
+    SUPER_SINGLE = 0,       /* instruction seule, déjà décodée */
+    SUPER_STEP2,            /* INC/DEC X ; INC/DEC Y */
+    SUPER_STEP_JCC,         /* INC/DEC X ; Jcc imm */
+    SUPER_CMP_JCC,          /* CMP X Y ou CMPI X imm ; Jcc imm */
+    SUPER_STEP_CMP_JCC,     /* INC/DEC X ; CMP/CMPI ; Jcc imm */
+    SUPER_ALU_MOV,          /* opération vers ACC ; MOV Z R15 */
+    SUPER_LD_STR,           /* LD X [Y] ; STR [Z] W */
+    SUPER_VSTR_STEP         /* VSTR X Y ; INC/DEC Z */
+} llmp16_super_op_t;
+
+typedef struct {
+    uint32_t pc;                            /* adresse de la première instruction, tag */
+    uint16_t words[LLMP_GROUP_WORDS];       /* mots d'origine, comparés à chaque passage */
+    uint8_t  nwords;
+    uint8_t  op;                            /* llmp16_super_op_t */
+    uint8_t  count;                         /* instructions du groupe */
+    uint8_t  head_cycles;                   /* coût de toutes sauf la dernière */
+    uint8_t  cycles;                        /* coût du groupe hors saut pris */
+    uint8_t  len;                           /* octets du groupe */
+    instr_t  in[LLMP_GROUP_MAX];
+} llmp16_predecode_entry_t;
+
+struct llmp16_predecode_s {
+    llmp16_predecode_entry_t e[LLMP_PREDECODE_SIZE];
+};
+
+void llmp16_predecode_free(llmp16_t *vm)
+{
+    free(vm->predecode);
+    vm->predecode = NULL;
+}
+
+/* Lecture d'un mot par les pointeurs rapides seulement : pas d'effet de bord MMIO */
+static inline bool peek_fast(const llmp16_t *vm, uint32_t addr, uint16_t *w)
+{
+    addr &= LLMP_ADDR_MASK;
+    uint32_t next = (addr + 1) & LLMP_ADDR_MASK;
+    const uint8_t *lo = vm->rd_page[addr >> LLMP_PAGE_SHIFT];
+    const uint8_t *hi = vm->rd_page[next >> LLMP_PAGE_SHIFT];
+    if (lo == NULL || hi == NULL) return false;
+    *w = (uint16_t)(lo[addr & LLMP_PAGE_MASK] | hi[next & LLMP_PAGE_MASK] << 8);
+    return true;
+}
+
+static inline bool is_step(const instr_t *in) { return in->op_class == 0x1 && (in->t == 0x5 || in->t == 0x6); }
+static inline bool is_jcc(const instr_t *in)  { return in->op_class == 0x8 && in->t <= 0xC; }
+static inline bool is_cmp(const instr_t *in)  { return (in->op_class == 0x1 || in->op_class == 0x2) && in->t == 0x7; }
+
+/* ADD SUB MUL DIV, leurs immédiats, AND OR XOR NOT, ANDI ORI XORI : résultat dans ACC */
+static inline bool writes_acc(const instr_t *in)
+{
+    switch (in->op_class) {
+    case 0x1: case 0x2: return in->t <= 0x3;
+    case 0x3:           return in->t <= 0x3;
+    case 0x4:           return in->t <= 0x2;
+    default:            return false;
+    }
+}
+
+/* Le code doit être en RAM ou en ROM principale : une VSTR ne peut pas modifier le groupe */
+static bool code_in_memory(const llmp16_t *vm, uint32_t addr)
+{
+    const uint8_t *backing = vm->pages[(addr & LLMP_ADDR_MASK) >> LLMP_PAGE_SHIFT].backing;
+    return backing >= vm->memory && backing < vm->memory + LLMP_MEM_SIZE;
+}
+
+/* Décode jusqu'à trois instructions à partir de <pc> et choisit le groupe le plus long.
+   Retourne false si le code n'est pas lisible par les pointeurs rapides. */
+static bool predecode(const llmp16_t *vm, llmp16_predecode_entry_t *e, uint32_t pc)
+{
+    uint32_t at = pc;
+    int n = 0, words = 0;
+
+    for (; n < LLMP_GROUP_MAX; n++) {
+        uint16_t w, ext = 0;
+        if (!peek_fast(vm, at, &w)) break;
+        int size = llmp16_instr_words(w);
+        if (size == 2 && !peek_fast(vm, at + 2, &ext)) break;
+        e->words[words++] = w;
+        if (size == 2) e->words[words++] = ext;
+        e->in[n] = llmp16_decode_raw(w, ext);
+        at += 2 * size;
+    }
+    if (n == 0) return false;
+
+    const instr_t *in = e->in;
+    e->op = SUPER_SINGLE;
+    e->count = 1;
+    // seule la dernière instruction d'un groupe peut écrire PC (INC PC, LD PC...)
+    bool head_keeps_pc = !((is_step(&in[0]) || (in[0].op_class == 0x5 && in[0].t == 0x1)) && in[0].X == PC);
+    if (n >= 2 && head_keeps_pc && code_in_memory(vm, pc) && code_in_memory(vm, at - 1)) {
+        if (n == 3 && is_step(&in[0]) && is_cmp(&in[1]) && is_jcc(&in[2]))
+            e->op = SUPER_STEP_CMP_JCC, e->count = 3;
+        else if (is_step(&in[0]) && is_step(&in[1]))
+            e->op = SUPER_STEP2, e->count = 2;
+        else if (is_step(&in[0]) && is_jcc(&in[1]))
+            e->op = SUPER_STEP_JCC, e->count = 2;
+        else if (is_cmp(&in[0]) && is_jcc(&in[1]))
+            e->op = SUPER_CMP_JCC, e->count = 2;
+        else if (writes_acc(&in[0]) && in[1].op_class == 0x5 && in[1].t == 0x0 && in[1].Y == ACC)
+            e->op = SUPER_ALU_MOV, e->count = 2;
+        else if (in[0].op_class == 0x5 && in[0].t == 0x1 && in[1].op_class == 0x5 && in[1].t == 0x2)
+            e->op = SUPER_LD_STR, e->count = 2;
+        else if (in[0].op_class == 0x5 && in[0].t == 0x6 && is_step(&in[1]))
+            e->op = SUPER_VSTR_STEP, e->count = 2;
+    }
+
+    e->pc = pc;
+    e->nwords = 0;
+    e->len = 0;
+    e->head_cycles = 0;
+    for (int i = 0; i < e->count; i++) {
+        int size = llmp16_instr_words(in[i].raw);
+        e->nwords += size;
+        e->len += 2 * size;
+        if (i < e->count - 1) e->head_cycles += in[i].cycles;
+    }
+    e->cycles = e->head_cycles + in[e->count - 1].cycles;
+    return true;
+}
+
+static inline bool still_valid(const llmp16_t *vm, const llmp16_predecode_entry_t *e, uint32_t pc)
+{
+    if (e->pc != pc || e->nwords == 0) return false;
+    for (int i = 0; i < e->nwords; i++) {
+        uint16_t w;
+        if (!peek_fast(vm, pc + 2 * i, &w) || w != e->words[i]) return false;
+    }
+    return true;
+}
+
+/* INC/DEC sur toute la largeur du registre, N et Z sur cette largeur (32 bits pour R8-R15) */
+static inline void step_reg(llmp16_t *vm, const instr_t *in)
+{
+    uint32_t res = llmp16_reg_get(vm, in->X) + (in->t == 0x5 ? 1u : (uint32_t)-1);
+    llmp16_reg_set(vm, in->X, res);
+    flag_nz_reg(vm, in->X, res);
+}
+
+static inline void compare(llmp16_t *vm, const instr_t *in)
+{
+    uint16_t a = llmp16_reg_get(vm, in->X);
+    uint16_t b = in->op_class == 0x1 ? (uint16_t)llmp16_reg_get(vm, in->Y) : in->imm;
+    uint32_t r32 = (uint32_t)a - b + 0x10000;
+    flag_nz(vm, (uint16_t)r32);
+    flag_sub_cv(vm, a, b, r32);
+}
+
+/* Exécute l'instruction à PC, ou le groupe qui commence à PC s'il tient dans les limites.
+   Retourne les cycles écoulés, *count reçoit le nombre d'instructions exécutées. */
+uint32_t llmp16_cpu_group(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    if (vm->predecode == NULL) {
+        vm->predecode = (llmp16_predecode_t *)calloc(1, sizeof(llmp16_predecode_t));
+        if (vm->predecode == NULL) {
+            *count = 1;
+            return llmp16_cpu_cycle(vm);
+        }
+    }
+
+    uint32_t pc = vm->R[PC];
+    llmp16_predecode_entry_t *e = &vm->predecode->e[(pc >> 1) & (LLMP_PREDECODE_SIZE - 1)];
+    if (!still_valid(vm, e, pc) && !predecode(vm, e, pc)) {
+        *count = 1;
+        return llmp16_cpu_cycle(vm);   // code hors RAM/ROM directe (MMIO, page non mappée)
+    }
+
+    // un groupe qui dépasserait le quota : sa première instruction seule, depuis l'entrée
+    const instr_t *in = e->in;
+    uint32_t n = e->count, cycles;
+    if (n > max_instr || e->head_cycles > slack) n = 1;
+
+    uint32_t next = pc + e->len;
+    if (n == 1) {
+        next = pc + 2 * llmp16_instr_words(in[0].raw);
+        vm->R[PC] = next;
+        cycles = in[0].cycles + execute(vm, in[0]);
+        if ((in[0].op_class == 0x7 || in[0].op_class == 0x8) && vm->R[PC] != next)
+            cycles += LLMP_CYC_BRANCH_TAKEN;
+        vm->stats.instructions++;
+        vm->stats.cycles += cycles;
+        *count = 1;
+        return cycles;
+    }
+
+    // PC suit chaque instruction du groupe comme après son fetch : un opérande PC ou un défaut
+    // mémoire y voient la même valeur qu'instruction par instruction
+    uint32_t mid = pc + 2 * llmp16_instr_words(in[0].raw);
+    vm->R[PC] = mid;
+    switch (e->op) {
+    case SUPER_STEP2:
+        step_reg(vm, &in[0]);
+        vm->R[PC] = next;
+        step_reg(vm, &in[1]);
+        break;
+
+    case SUPER_STEP_JCC:
+        step_reg(vm, &in[0]);
+        vm->R[PC] = llmp16_cond(vm, in[1].t) ? in[1].addr : next;
+        break;
+
+    case SUPER_CMP_JCC:
+        compare(vm, &in[0]);
+        vm->R[PC] = llmp16_cond(vm, in[1].t) ? in[1].addr : next;
+        break;
+
+    case SUPER_STEP_CMP_JCC:
+        step_reg(vm, &in[0]);
+        vm->R[PC] = mid + 2 * llmp16_instr_words(in[1].raw);
+        compare(vm, &in[1]);
+        vm->R[PC] = llmp16_cond(vm, in[2].t) ? in[2].addr : next;
+        break;
+
+    case SUPER_ALU_MOV:
+        execute(vm, in[0]);
+        vm->R[PC] = next;
+        llmp16_reg_set(vm, in[1].X, llmp16_reg_get(vm, ACC));
+        break;
+
+    case SUPER_LD_STR:
+        llmp16_reg_set(vm, in[0].X, mem_read16(vm, llmp16_reg_get(vm, in[0].Y)));
+        if (vm->cpu_halted) {   // défaut avec fault_halt : le STR ne s'exécute pas
+            n = 1;
+            break;
+        }
+        vm->R[PC] = next;
+        mem_write16(vm, llmp16_reg_get(vm, in[1].X), llmp16_reg_get(vm, in[1].Y));
+        break;
+
+    case SUPER_VSTR_STEP:
+        vram_write(vm, llmp16_reg_get(vm, in[0].X), llmp16_reg_get(vm, in[0].Y));
+        vm->R[PC] = next;
+        step_reg(vm, &in[1]);
+        break;
+
+    default:
+        break;
+    }
+
+    cycles = n == e->count ? e->cycles : in[0].cycles;
+    if (in[n - 1].op_class == 0x8 && vm->R[PC] != next) cycles += LLMP_CYC_BRANCH_TAKEN;
+    vm->stats.instructions += n;
+    vm->stats.cycles += cycles;
+    *count = n;
+    return cycles;
+}
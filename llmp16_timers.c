@@ -4,14 +4,20 @@ void llmp16_timer_init(llmp16_timer_t *timer, uint8_t PSC, uint16_t value, uint1
 {
     timer->count = init_value;
     timer->PSC = PSC + 1;
+    timer->prescale = 0;
     timer->status = 0x0000;
     timer->value = value;
     timer->init_value = init_value;
 }
 
-void llmp16_timer_count(llmp16_timer_t *timer, uint8_t clk_counter)
+/* Fait avancer le timer de <cycles> cycles CPU, divisés par le préscaler */
+void llmp16_timer_count(llmp16_timer_t *timer, uint32_t cycles)
 {
-    if(clk_counter % timer->PSC == 0) timer->count++;
+    timer->prescale += cycles;
+    if (timer->prescale < timer->PSC) return;
+    timer->count += timer->prescale / timer->PSC;
+    timer->prescale %= timer->PSC;
+
     if((timer->status & 0x01) == 0 && timer->count >= timer->value)
     {
         timer->count = timer->init_value;
@@ -0,0 +1,182 @@
+#include "llmp16_trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+int llmp16_trace_open(llmp16_trace_t *trace, const char *path, llmp16_trace_mode_t mode, uint32_t records)
+{
+    memset(trace, 0, sizeof(*trace));
+    trace->mode = mode;
+
+    // capacité arrondie à la puissance de 2 supérieure pour un index par masque
+    uint32_t capacity = 1024;
+    while (capacity < records) capacity <<= 1;
+    trace->capacity = capacity;
+
+    trace->ring = (llmp16_trace_rec_t *)malloc(capacity * sizeof(llmp16_trace_rec_t));
+    if (trace->ring == NULL) return -1;
+
+    trace->out = fopen(path, "wb");
+    if (trace->out == NULL) {
+        perror("Trace open error");
+        free(trace->ring);
+        trace->ring = NULL;
+        return -1;
+    }
+
+    llmp16_trace_header_t header;
+    memcpy(header.magic, LLMP_TRACE_MAGIC, sizeof(header.magic));
+    header.rec_size = sizeof(llmp16_trace_rec_t);
+    header.mode = mode;
+    fwrite(&header, sizeof(header), 1, trace->out);
+    return 0;
+}
+
+void llmp16_trace_watch(llmp16_trace_t *trace, uint32_t addr, uint32_t len)
+{
+    trace->watch_lo = addr;
+    trace->watch_hi = addr + len;
+}
+
+/* Écrit le contenu du tampon dans l'ordre chronologique */
+static void flush(llmp16_trace_t *trace)
+{
+    if (trace->wrapped)
+        fwrite(trace->ring + trace->head, sizeof(llmp16_trace_rec_t), trace->capacity - trace->head, trace->out);
+    fwrite(trace->ring, sizeof(llmp16_trace_rec_t), trace->head, trace->out);
+    trace->head = 0;
+    trace->wrapped = false;
+}
+
+static inline void emit(llmp16_trace_t *trace, uint8_t type, uint8_t a, uint16_t b,
+                        uint32_t addr, uint32_t value, uint32_t ext)
+{
+    llmp16_trace_rec_t *rec = &trace->ring[trace->head];
+    rec->type = type;
+    rec->a = a;
+    rec->b = b;
+    rec->addr = addr;
+    rec->value = value;
+    rec->ext = ext;
+
+    trace->head = (trace->head + 1) & (trace->capacity - 1);
+    if (trace->head == 0) {
+        trace->wrapped = true;
+        if (trace->mode == LLMP_TRACE_STREAM) flush(trace);
+    }
+}
+
+static void trigger(llmp16_trace_t *trace, llmp16_trace_reason_t reason, uint32_t pc)
+{
+    emit(trace, TRACE_TRIGGER, reason, 0, pc, 0, (uint32_t)trace->seq);
+    if (trace->mode == LLMP_TRACE_TRIGGER) {
+        flush(trace);
+        fflush(trace->out);
+        trace->done = true;
+    }
+}
+
+static inline uint32_t pre_reg(const llmp16_trace_t *trace, uint8_t X)
+{
+    return trace->R[X & 15];
+}
+
+static void mem_written(llmp16_trace_t *trace, llmp16_t *vm, uint32_t addr)
+{
+    emit(trace, TRACE_MEM, 2, 0, addr, llmp16_mem_peek16(vm, addr), (uint32_t)trace->seq);
+    if (addr + 1 >= trace->watch_lo && addr < trace->watch_hi)
+        trigger(trace, TRACE_REASON_WATCH, trace->pc);
+}
+
+/* MCPY, MFIL, VFIL : un seul enregistrement pour la plage écrite, IDX donne les octets traités */
+static void block_written(llmp16_trace_t *trace, llmp16_t *vm, const instr_t *in)
+{
+    uint32_t n = pre_reg(trace, IDX) - llmp16_reg_get(vm, IDX);
+    if (n == 0) return;
+    uint32_t addr = pre_reg(trace, in->X);
+    uint16_t fill = in->t == 0x0 ? 0 : (uint8_t)pre_reg(trace, in->Y);
+    if (in->t == 0x2) addr &= 0xFFFF;
+    emit(trace, TRACE_BLOCK, in->t, fill, addr, n, (uint32_t)trace->seq);
+    if (in->t != 0x2 && addr + n > trace->watch_lo && addr < trace->watch_hi)
+        trigger(trace, TRACE_REASON_WATCH, trace->pc);
+}
+
+/*============================== Hooks CPU ==============================*/
+
+void llmp16_trace_before(llmp16_trace_t *trace, llmp16_t *vm, uint32_t pc, const instr_t *in)
+{
+    if (trace->done) return;
+
+    trace->seq++;
+    trace->pc = pc;
+    memcpy(trace->R, vm->R, sizeof(trace->R));
+    trace->FLAGS = vm->FLAGS;
+
+    uint32_t ext = in->has_imm ? in->imm : (in->has_addr ? (in->addr & 0xFFFF) : 0);
+    emit(trace, TRACE_INSN, 0, in->raw, pc, ext, (uint32_t)trace->seq);
+
+    if (!llmp16_instr_valid(in))
+        trigger(trace, TRACE_REASON_INVALID, pc);
+}
+
+void llmp16_trace_after(llmp16_trace_t *trace, llmp16_t *vm, const instr_t *in)
+{
+    if (trace->done) return;
+
+    // registres modifiés ; PC est implicite dans l'instruction suivante
+    for (uint8_t r = 0; r < 16; r++) {
+        if (r != PC && vm->R[r] != trace->R[r])
+            emit(trace, TRACE_REG, r, 0, 0, vm->R[r], (uint32_t)trace->seq);
+    }
+    if (vm->FLAGS != trace->FLAGS)
+        emit(trace, TRACE_REG, LLMP_TRACE_FLAGS_REG, 0, 0, vm->FLAGS, (uint32_t)trace->seq);
+
+    // écritures mémoire, VRAM et IO déduites de l'instruction
+    switch (in->op_class) {
+    case 0x5:
+        if (in->t == 0x2) mem_written(trace, vm, pre_reg(trace, in->X));
+        else if (in->t == 0x3) mem_written(trace, vm, llmp16_reg_get(vm, SP));
+        else if (in->t == 0x6 || in->t == 0x8) {
+            // VSTRW écrit aussi l'octet suivant
+            uint16_t addr = (uint16_t)pre_reg(trace, in->X);
+            emit(trace, TRACE_VRAM, 1, 0, addr, vram_read(vm, addr), (uint32_t)trace->seq);
+            if (in->t == 0x8)
+                emit(trace, TRACE_VRAM, 1, 0, (uint16_t)(addr + 1), vram_read(vm, (uint16_t)(addr + 1)),
+                     (uint32_t)trace->seq);
+        }
+        break;
+    case 0x6:
+        if (in->t == 0x2) mem_written(trace, vm, in->addr);
+        else if (in->t == 0x3) mem_written(trace, vm, llmp16_reg_get(vm, SP));
+        else if (in->t == 0x6)
+            emit(trace, TRACE_VRAM, 1, 0, in->imm, vram_read(vm, in->imm), (uint32_t)trace->seq);
+        break;
+    case 0x8:
+        if (in->t == 0xD) mem_written(trace, vm, llmp16_reg_get(vm, SP));
+        break;
+    case 0xB:
+        if (in->t <= 0x2) block_written(trace, vm, in);
+        break;
+    case 0x9:
+        emit(trace, TRACE_IO_IN, (in->Y << 4) | in->t, 0, 0, llmp16_reg_get(vm, in->X), (uint32_t)trace->seq);
+        break;
+    case 0xA:
+        emit(trace, TRACE_IO_OUT, (in->Y << 4) | in->t, 0, 0, llmp16_reg_get(vm, in->X), (uint32_t)trace->seq);
+        break;
+    default:
+        break;
+    }
+
+    if (in->raw == 0x0001 && !trace->done)
+        trigger(trace, TRACE_REASON_HALT, trace->pc);
+}
+
+void llmp16_trace_close(llmp16_trace_t *trace)
+{
+    if (trace->out != NULL) {
+        if (trace->mode == LLMP_TRACE_STREAM) flush(trace);
+        fclose(trace->out);
+    }
+    free(trace->ring);
+    trace->out = NULL;
+    trace->ring = NULL;
+}
@@ -0,0 +1,93 @@
+#ifndef LLMP16_TRACE_H
+#define LLMP16_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "llmp16.h"
+
+/*
+ * Traceur d'exécution binaire pour LLMP16
+ * ---------------------------------------
+ * Attaché à une VM par vm->trace, il enregistre dans un tampon circulaire des enregistrements
+ * de 16 octets : instruction exécutée (PC, opcode brut, mot d'extension), écritures de
+ * registres et de FLAGS, écritures mémoire et VRAM (une plage par instruction de bloc),
+ * accès IN/OUT.
+ *
+ * Deux modes :
+ *   - LLMP_TRACE_STREAM  : le tampon est vidé dans le fichier à chaque fois qu'il est plein ;
+ *   - LLMP_TRACE_TRIGGER : le tampon tourne en boucle et ne garde que les derniers
+ *                          enregistrements ; il est écrit une seule fois, au premier HALT,
+ *                          opcode invalide ou écriture dans la plage surveillée.
+ *
+ * Fichier : en-tête llmp16_trace_header_t puis les enregistrements, little-endian.
+ * Le décodeur hors-ligne est tools/llmp16_tracedump.c.
+ */
+
+#define LLMP_TRACE_MAGIC     "LLMPTRC1"
+#define LLMP_TRACE_FLAGS_REG 16          /* numéro de "registre" utilisé pour FLAGS */
+
+typedef enum {
+    LLMP_TRACE_STREAM,
+    LLMP_TRACE_TRIGGER
+} llmp16_trace_mode_t;
+
+typedef enum {
+    TRACE_INSN = 1,     /* addr = PC, b = opcode brut, value = mot d'extension, ext = numéro */
+    TRACE_REG,          /* a = registre, value = nouvelle valeur */
+    TRACE_MEM,          /* addr = adresse, value = mot écrit */
+    TRACE_VRAM,         /* addr = adresse VRAM, value = octet écrit */
+    TRACE_IO_IN,        /* a = port << 4 | registre, value = valeur lue */
+    TRACE_IO_OUT,       /* a = port << 4 | registre, value = valeur écrite */
+    TRACE_TRIGGER,      /* a = raison (llmp16_trace_reason_t), addr = PC */
+    TRACE_BLOCK         /* a = 0 MCPY, 1 MFIL, 2 VFIL (VRAM), addr = début, value = octets écrits,
+                           b = octet de remplissage */
+} llmp16_trace_type_t;
+
+typedef enum {
+    TRACE_REASON_HALT = 1,
+    TRACE_REASON_INVALID,
+    TRACE_REASON_WATCH
+} llmp16_trace_reason_t;
+
+typedef struct {
+    uint8_t  type;
+    uint8_t  a;
+    uint16_t b;
+    uint32_t addr;
+    uint32_t value;
+    uint32_t ext;
+} llmp16_trace_rec_t;
+
+typedef struct {
+    char     magic[8];
+    uint32_t rec_size;
+    uint32_t mode;
+} llmp16_trace_header_t;
+
+typedef struct llmp16_trace_s {
+    llmp16_trace_mode_t mode;
+    FILE *out;
+
+    llmp16_trace_rec_t *ring;
+    uint32_t capacity;                   /* puissance de 2 */
+    uint32_t head;                       /* prochain emplacement libre */
+    bool wrapped;
+    bool done;                           /* mode trigger : la trace a été écrite */
+
+    uint64_t seq;                        /* numéro de l'instruction courante */
+    uint32_t watch_lo, watch_hi;         /* plage surveillée [lo, hi[, vide si lo == hi */
+
+    /* état avant l'instruction, pour déduire les écritures */
+    uint32_t pc;
+    uint32_t R[16];
+    uint8_t  FLAGS;
+} llmp16_trace_t;
+
+int  llmp16_trace_open(llmp16_trace_t *trace, const char *path, llmp16_trace_mode_t mode, uint32_t records);
+void llmp16_trace_watch(llmp16_trace_t *trace, uint32_t addr, uint32_t len);
+void llmp16_trace_before(llmp16_trace_t *trace, llmp16_t *vm, uint32_t pc, const instr_t *in);
+void llmp16_trace_after(llmp16_trace_t *trace, llmp16_t *vm, const instr_t *in);
+void llmp16_trace_close(llmp16_trace_t *trace);
+
+#endif // LLMP16_TRACE_H
@@ -0,0 +1,247 @@
+#include "llmp16.h"
+#include "llmp16_shm.h"
+#include "llmp16_capture.h"
+#include "BIOS_FONT.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Présentation : mode texte du port 0 et compositeur du port 5 (voir llmp16.h)
+ * Chaque ligne de l'image part du banc affiché, reçoit les sprites BEHIND, le tilemap puis les
+ * autres sprites. Les pixels transparents sont écartés 8 par 8 dans des mots de 64 bits : pas
+ * d'intrinsèques propres à une architecture, et le compilateur vectorise la boucle.
+ */
+
+#define ONES  0x0101010101010101ull
+#define LOWS  0x7F7F7F7F7F7F7F7Full
+#define HIGHS 0x8080808080808080ull
+
+typedef struct {
+    int x, y, w, h;
+    uint16_t addr;                  /* pixels, ligne par ligne */
+    uint8_t flags;
+} sprite_t;
+
+/* <len> octets du banc à partir de <addr>, recopiés dans <tmp> s'ils passent la fin du banc */
+static const uint8_t *span(const uint8_t *bank, uint16_t addr, uint32_t len, uint8_t *tmp)
+{
+    if ((uint32_t)addr + len <= LLMP_VRAM_BANK_SIZE) return bank + addr;
+    for (uint32_t i = 0; i < len; i++) tmp[i] = bank[(uint16_t)(addr + i)];
+    return tmp;
+}
+
+/* dst[i] <- src[i] sauf là où src[i] vaut <key> */
+static void blend_key(uint8_t *dst, const uint8_t *src, int n, uint8_t key)
+{
+    const uint64_t k = key * ONES;
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t s, d;
+        memcpy(&s, src + i, 8);
+        memcpy(&d, dst + i, 8);
+        // bit 7 de chaque octet à 1 si l'octet diffère de la clé, sans retenue d'un octet à l'autre
+        uint64_t x = s ^ k;
+        uint64_t opaque = (((x & LOWS) + LOWS) | x) & HIGHS;
+        uint64_t m = (opaque >> 7) * 0xFF;
+        d = (d & ~m) | (s & m);
+        memcpy(dst + i, &d, 8);
+    }
+    for (; i < n; i++)
+        if (src[i] != key) dst[i] = src[i];
+}
+
+/* Sprites visibles de la table, dans l'ordre de priorité (le premier devant) */
+static int load_sprites(const llmp16_t *vm, const uint8_t *bank, sprite_t *spr)
+{
+    const uint16_t *io = vm->IO[LLMP_VID_PORT];
+    int count = io[LLMP_VID_REG_COUNT] < LLMP_VID_SPRITES ? io[LLMP_VID_REG_COUNT] : LLMP_VID_SPRITES;
+    int n = 0;
+
+    for (int i = 0; i < count; i++) {
+        uint8_t tmp[LLMP_VID_SPRITE_SIZE];
+        const uint8_t *e = span(bank, (uint16_t)(io[LLMP_VID_REG_SPRITES] + i * LLMP_VID_SPRITE_SIZE),
+                                LLMP_VID_SPRITE_SIZE, tmp);
+        if (!(e[7] & LLMP_SPR_VISIBLE)) continue;
+        sprite_t *s = &spr[n];
+        s->x = (int16_t)(e[0] | e[1] << 8);
+        s->y = (int16_t)(e[2] | e[3] << 8);
+        s->addr = (uint16_t)(e[4] | e[5] << 8);
+        s->w = ((e[6] & 0x0F) + 1) * LLMP_VID_TILE;
+        s->h = ((e[6] >> 4) + 1) * LLMP_VID_TILE;
+        s->flags = e[7];
+        if (s->x < LLMP_SCREEN_WIDTH && s->x + s->w > 0 && s->y < LLMP_SCREEN_HEIGHT && s->y + s->h > 0) n++;
+    }
+    return n;
+}
+
+/* Ligne <line> d'un sprite, découpée au bord de l'écran */
+static void sprite_line(uint8_t *out, const uint8_t *bank, const sprite_t *s, int line, uint8_t key)
+{
+    int row = line - s->y;
+    if (row < 0 || row >= s->h) return;
+    if (s->flags & LLMP_SPR_VFLIP) row = s->h - 1 - row;
+
+    uint8_t tmp[16 * LLMP_VID_TILE], rev[16 * LLMP_VID_TILE];
+    const uint8_t *src = span(bank, (uint16_t)(s->addr + row * s->w), s->w, tmp);
+    if (s->flags & LLMP_SPR_HFLIP) {
+        for (int i = 0; i < s->w; i++) rev[i] = src[s->w - 1 - i];
+        src = rev;
+    }
+
+    int x = s->x, from = 0, n = s->w;
+    if (x < 0) { from = -x; n -= from; x = 0; }
+    if (x + n > LLMP_SCREEN_WIDTH) n = LLMP_SCREEN_WIDTH - x;
+    blend_key(out + x, src + from, n, key);
+}
+
+/* Ligne <line> du tilemap défilé : 41 lignes de tuiles de 8 pixels, décalées du défilement fin */
+static void tile_line(const llmp16_t *vm, const uint8_t *bank, int line, uint8_t *out)
+{
+    const uint16_t *io = vm->IO[LLMP_VID_PORT];
+    uint32_t mw = io[LLMP_VID_REG_MAP_SIZE] & 0xFF, mh = io[LLMP_VID_REG_MAP_SIZE] >> 8;
+    if (mw == 0) mw = 256;
+    if (mh == 0) mh = 256;
+
+    uint32_t py = (line + io[LLMP_VID_REG_SCROLL_Y]) % (mh * LLMP_VID_TILE);
+    uint32_t px = io[LLMP_VID_REG_SCROLL_X] % (mw * LLMP_VID_TILE);
+    uint16_t row = (uint16_t)(io[LLMP_VID_REG_MAP] + (py / LLMP_VID_TILE) * mw);
+    uint16_t gfx = (uint16_t)(io[LLMP_VID_REG_TILES] + (py % LLMP_VID_TILE) * LLMP_VID_TILE);
+    uint32_t tx = px / LLMP_VID_TILE;
+    uint8_t buf[LLMP_SCREEN_WIDTH + LLMP_VID_TILE], tmp[LLMP_VID_TILE];
+
+    for (int c = 0; c <= LLMP_SCREEN_WIDTH / LLMP_VID_TILE; c++) {
+        uint8_t tile = bank[(uint16_t)(row + tx)];
+        uint16_t at = (uint16_t)(gfx + tile * LLMP_VID_TILE * LLMP_VID_TILE);
+        memcpy(buf + c * LLMP_VID_TILE, span(bank, at, LLMP_VID_TILE, tmp), LLMP_VID_TILE);
+        if (++tx == mw) tx = 0;
+    }
+    memcpy(out, buf + px % LLMP_VID_TILE, LLMP_SCREEN_WIDTH);
+}
+
+
+/*============================== Mode texte ==============================*/
+
+/* Palette CGA en RGB332 (RRRGGGBB) */
+static const uint8_t text_palette[16] = {
+    0x00, 0x02, 0x14, 0x16, 0xA0, 0xA2, 0xA8, 0xB6,
+    0x49, 0x4B, 0x5D, 0x5F, 0xE9, 0xEB, 0xFD, 0xFF
+};
+
+struct llmp16_text_s {
+    uint8_t cells[2 * LLMP_TEXT_CELLS];         /* tampon texte de la dernière image */
+    uint8_t image[LLMP_SCREEN_WIDTH * LLMP_SCREEN_HEIGHT];
+    bool valid;                                 /* image à jour pour <cells> */
+};
+
+static llmp16_text_t *text_alloc(void)
+{
+    llmp16_text_t *text = (llmp16_text_t *)calloc(1, sizeof(llmp16_text_t));
+    if (text == NULL) {
+        perror("Text alloc error");
+        return NULL;
+    }
+    return text;
+}
+
+/* Dessine la cellule <i> : chaque rangée du glyphe donne 8 pixels en une écriture */
+static void text_cell(llmp16_text_t *text, int i, uint8_t c, uint8_t attr)
+{
+    const uint64_t fg = text_palette[attr & 0x0F] * ONES, bg = text_palette[attr >> 4] * ONES;
+    uint8_t *out = text->image + (i / LLMP_TEXT_COLS) * 8 * LLMP_SCREEN_WIDTH + (i % LLMP_TEXT_COLS) * 8;
+    for (int row = 0; row < 8; row++, out += LLMP_SCREEN_WIDTH) {
+        uint64_t m;
+        memcpy(&m, llmp16_bit_expand[bios_font_8x8[c][row]], 8);   // bit 7 du glyphe = pixel de gauche
+        uint64_t px = (fg & m) | (bg & ~m);
+        memcpy(out, &px, 8);
+    }
+}
+
+/* Image du mode texte, en ne redessinant que les cellules changées (NULL sans mémoire) */
+static const uint8_t *text_frame(llmp16_t *vm)
+{
+    if (vm->text == NULL && (vm->text = text_alloc()) == NULL) return NULL;
+    llmp16_text_t *text = vm->text;
+
+    uint8_t tmp[2 * LLMP_TEXT_CELLS];
+    const uint8_t *cells = span(vm->VRAM, vm->IO[LLMP_SCREEN_PORT][LLMP_SCREEN_REG_TEXT], sizeof(tmp), tmp);
+    for (int row = 0; row < LLMP_TEXT_ROWS; row++) {
+        // une ligne de 80 octets inchangée se saute d'un memcmp
+        int at = row * 2 * LLMP_TEXT_COLS;
+        if (text->valid && memcmp(text->cells + at, cells + at, 2 * LLMP_TEXT_COLS) == 0) continue;
+        for (int i = at; i < at + 2 * LLMP_TEXT_COLS; i += 2) {
+            if (text->valid && text->cells[i] == cells[i] && text->cells[i + 1] == cells[i + 1]) continue;
+            text_cell(text, i / 2, cells[i], cells[i + 1]);
+        }
+    }
+    memcpy(text->cells, cells, sizeof(text->cells));
+    text->valid = true;
+    return text->image;
+}
+
+
+/*============================== Image présentée ==============================*/
+
+void llmp16_video_free(llmp16_t *vm)
+{
+    free(vm->frame);
+    free(vm->text);
+    vm->frame = NULL;
+    vm->text = NULL;
+}
+
+const uint8_t *llmp16_video_frame(llmp16_t *vm)
+{
+    const uint16_t *io = vm->IO[LLMP_VID_PORT];
+    const uint8_t *screen = vm->VRAM + (vm->IO[LLMP_SCREEN_PORT][LLMP_SCREEN_REG_BANK] % LLMP_VRAM_BANKS) * LLMP_VRAM_BANK_SIZE;
+    if (vm->IO[LLMP_SCREEN_PORT][LLMP_SCREEN_REG_MODE] & SCREEN_MODE_TEXT) {
+        const uint8_t *image = text_frame(vm);
+        if (image != NULL) screen = image;
+    }
+    uint16_t ctrl = io[LLMP_VID_REG_CTRL];
+    if (!(ctrl & (VID_CTRL_TILES | VID_CTRL_SPRITES))) return screen;
+
+    if (vm->frame == NULL) {
+        vm->frame = (uint8_t *)malloc(LLMP_SCREEN_WIDTH * LLMP_SCREEN_HEIGHT);
+        if (vm->frame == NULL) {
+            perror("Video alloc error");
+            return screen;
+        }
+    }
+
+    const uint8_t *bank = vm->VRAM + ((ctrl & VID_CTRL_BANK1) ? LLMP_VRAM_BANK_SIZE : 0);
+    uint8_t key = (uint8_t)io[LLMP_VID_REG_KEY];
+    sprite_t spr[LLMP_VID_SPRITES];
+    int n = (ctrl & VID_CTRL_SPRITES) ? load_sprites(vm, bank, spr) : 0;
+    uint8_t tiles[LLMP_SCREEN_WIDTH];
+
+    for (int line = 0; line < LLMP_SCREEN_HEIGHT; line++) {
+        uint8_t *out = vm->frame + line * LLMP_SCREEN_WIDTH;
+        memcpy(out, screen + line * LLMP_SCREEN_WIDTH, LLMP_SCREEN_WIDTH);
+        // du dernier sprite au premier : le sprite 0 finit devant
+        for (int i = n - 1; i >= 0; i--)
+            if (spr[i].flags & LLMP_SPR_BEHIND) sprite_line(out, bank, &spr[i], line, key);
+        if (ctrl & VID_CTRL_TILES) {
+            tile_line(vm, bank, line, tiles);
+            blend_key(out, tiles, LLMP_SCREEN_WIDTH, key);
+        }
+        for (int i = n - 1; i >= 0; i--)
+            if (!(spr[i].flags & LLMP_SPR_BEHIND)) sprite_line(out, bank, &spr[i], line, key);
+    }
+    return vm->frame;
+}
+
+void llmp16_video_present(llmp16_t *vm, const uint8_t *image)
+{
+    if (vm->shm != NULL) llmp16_shm_publish(vm->shm, vm, image);
+    if (vm->capture != NULL) llmp16_capture_push(vm->capture, image, vm->stats.cycles);
+}
+
+void llmp16_video_tick(llmp16_t *vm)
+{
+    if (vm->shm == NULL && vm->capture == NULL) return;
+    uint64_t boundary = vm->stats.cycles / CYCLES_PER_FRAME;
+    if (boundary <= vm->video_frames) return;
+    vm->video_frames = boundary;
+    llmp16_video_present(vm, llmp16_video_frame(vm));
+}
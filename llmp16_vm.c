@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <SDL2/SDL.h>
+#include <string.h>
+#include "llmp16.h"         // Structure de la VM
+#include "llmp16_rewind.h"  // Instantanés de rembobinage
+#include "llmp16_aot.h"     // Blocs de ROM traduits en C
+#include "llmp16_debug.h"   // Breakpoints pris au fetch
+
+
+/*
+ * Cycle de vie d'une machine virtuelle.
+ * Toute la structure llmp16_t est propre à une instance : aucune variable globale ni
+ * statique n'est utilisée par le chemin CPU, ce qui permet d'héberger plusieurs VMs
+ * dans un même processus (voir llmp16_sched.h). L'affichage SDL est optionnel et
+ * s'attache séparément avec llmp16_display_init().
+ */
+
+void llmp16_init(llmp16_t *vm)
+{
+    memset(vm, 0, sizeof(*vm));
+
+    llmp16_reg_set(vm, PC, 0);
+    llmp16_reg_set(vm, SP, LLMP_STACK_TOP);
+
+    vm->FLAGS = 0;
+    vm->halted = false;
+    vm->cpu_halted = false;
+
+    vm->memory = (uint8_t *)calloc(LLMP_MEM_SIZE, sizeof(uint8_t));
+
+    vm->VRAM = (uint8_t*)calloc(LLMP_VRAM_SIZE, sizeof(uint8_t ));
+
+    for (uint32_t p = 0; p < LLMP_VRAM_PAGES; p++)
+        llmp16_vram_protect(vm, p, 0);
+    llmp16_mem_map(vm, 0, LLMP_ROM_SIZE, LLMP_MEM_ROM);
+    llmp16_mem_map(vm, LLMP_ROM_SIZE, LLMP_MEM_SIZE - LLMP_ROM_SIZE, LLMP_MEM_RAM);
+
+    llmp16_timer_init(&vm->timer1, 0, 0, 0);
+    llmp16_timer_init(&vm->timer2, 0, 0, 0);
+    llmp16_timer_init(&vm->timer3, 0, 0, 0);
+    llmp16_dma_init(&vm->dma);
+
+
+    for (int i = 0; i < LLMP_IO_PORTS; i++) {
+        for (int j = 0; j < LLMP_IO_REGS; j++) {
+            vm->IO[i][j] = 0;
+        }
+    }
+
+
+}
+
+int llmp16_display_init(llmp16_t *vm)
+{
+    if (llmp16_screen_init(&vm->screen) != EXIT_SUCCESS)
+        return EXIT_FAILURE;
+
+    llmp16_keyb_init();
+    return EXIT_SUCCESS;
+}
+
+void llmp16_debug_dump(llmp16_t *vm)
+{
+    const char* reg_names[16] = {
+        "R0", "R1", "R2", "R3",
+        "R4", "R5", "R6", "R7",
+        "R8", "R9", "R10","RR11",
+        "PC","SP","IDX","ACC"
+    };
+
+    // 1) Registres généraux et spéciaux
+    printf("=== Registres ===\n");
+    for (int i = 0; i < 16; i++) {
+        uint32_t val = llmp16_reg_get(vm, (llmp16_register_t)i);
+        // On affiche sur 16 bits pour R0-RR11, sur 32 bits pour PC/SP/IDX/ACC
+        if (i < 12)
+            printf("%4s = 0x%04X\n", reg_names[i], val);
+        else
+            printf("%4s = 0x%08X\n", reg_names[i], val);
+    }
+
+    // 2) Flags NZCV
+    printf("\n=== Flags ===\n");
+    printf("N=%u  Z=%u  C=%u  V=%u\n",
+        flag_get(vm, FLAG_N),
+        flag_get(vm, FLAG_Z),
+        flag_get(vm, FLAG_C),
+        flag_get(vm, FLAG_V));
+
+    // 3) Autres états de la VM
+    printf("\n=== VM State ===\n");
+    printf("HALTED = %u\n", vm->halted);
+    printf("FAULTS = %llu (dernier : %s en 0x%05X, PC 0x%05X)\n",
+        (unsigned long long)vm->stats.mem_faults, llmp16_fault_name(vm->fault.kind),
+        vm->fault.addr, vm->fault.pc);
+
+
+    // 4) Tous les ports IO
+    printf("\n=== IO Ports ===\n");
+    for (int p = 0; p < LLMP_IO_PORTS; p++) {
+        printf("Port %2d: ", p);
+        for (int r = 0; r < LLMP_IO_REGS; r++) {
+            printf("%04X ", vm->IO[p][r]);
+        }
+        printf("\n");
+    }
+}
+
+
+/* Fait avancer les périphériques des <cycles> que vient de consommer le CPU */
+static uint32_t peripherals_step(llmp16_t *vm, uint32_t cycles)
+{
+    uint32_t stall = llmp16_blitter_step(vm);
+    stall += llmp16_dma_step(vm, &vm->dma);
+    cycles += stall;
+    vm->stats.cycles += stall;
+
+    // un timer sans valeur de comparaison est arrêté
+    if (vm->timer1.value) llmp16_timer_count(&vm->timer1, cycles);
+    if (vm->timer2.value) llmp16_timer_count(&vm->timer2, cycles);
+    if (vm->timer3.value) llmp16_timer_count(&vm->timer3, cycles);
+    return cycles;
+}
+
+/* Exécute une instruction puis fait avancer les périphériques du même nombre de cycles.
+   Retourne les cycles écoulés, y compris ceux où le CPU attend le blitter ou le DMA. */
+uint32_t llmp16_step(llmp16_t *vm)
+{
+    uint32_t cycles = llmp16_cpu_cycle(vm);
+    // breakpoint au fetch : l'instruction n'a pas eu lieu, les périphériques n'avancent pas
+    if (vm->debug != NULL && vm->debug->fetch == LLMP_FETCH_BREAK) return 0;
+    return peripherals_step(vm, cycles);
+}
+
+/* Les superinstructions remplacent la boucle instruction par instruction quand aucun crochet
+   par instruction n'est attaché et qu'aucun timer ne compte (un timer qui se recharge ne
+   donne pas le même compte en une fois qu'en plusieurs) */
+static bool fusion_allowed(const llmp16_t *vm)
+{
+    return vm->profiler == NULL && vm->trace == NULL && vm->debug == NULL
+        && !vm->timer1.value && !vm->timer2.value && !vm->timer3.value;
+}
+
+/* Groupe d'instructions des boucles d'exécution : bloc traduit si une image AOT est attachée */
+static inline uint32_t cpu_group(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)
+{
+    if (vm->aot != NULL) return llmp16_aot_group(vm, max_instr, slack, count);
+    return llmp16_cpu_group(vm, max_instr, slack, count);
+}
+
+/* relevé périodique des compteurs et instantané de rembobinage, vérifiés une fois par tranche */
+static void stats_poll(llmp16_t *vm)
+{
+    if (vm->stats_out != NULL && vm->stats.cycles >= vm->stats_next) {
+        llmp16_stats_write_json(vm, vm->stats_out);
+        vm->stats_next = vm->stats.cycles + vm->stats_period;
+    }
+    if (vm->rewind != NULL && vm->stats.cycles >= vm->rewind->next)
+        llmp16_rewind_snapshot(vm);
+}
+
+/* Exécute au plus <quota> instructions, s'arrête plus tôt si le CPU exécute HALT ou si la VM
+   est éteinte. Retourne le nombre d'instructions exécutées. */
+uint32_t llmp16_run_slice(llmp16_t *vm, uint32_t quota)
+{
+    uint32_t i = 0, n;
+    if (fusion_allowed(vm)) {
+        while (i < quota && !vm->cpu_halted && !vm->halted) {
+            peripherals_step(vm, cpu_group(vm, quota - i, UINT64_MAX, &n));
+            i += n;
+        }
+    } else {
+        for (; i < quota && !vm->cpu_halted && !vm->halted; i++)
+            llmp16_step(vm);
+    }
+    stats_poll(vm);
+    return i;
+}
+
+/* Exécute des instructions jusqu'à consommer au moins <budget> cycles (ou HALT / arrêt).
+   Retourne les cycles réellement consommés, qui peuvent dépasser légèrement le budget. */
+uint64_t llmp16_run_cycles(llmp16_t *vm, uint64_t budget)
+{
+    uint64_t done = 0;
+    uint32_t n;
+    if (fusion_allowed(vm)) {
+        // toutes les instructions d'un groupe sauf la dernière doivent finir sous le budget
+        while (done < budget && !vm->cpu_halted && !vm->halted)
+            done += peripherals_step(vm, cpu_group(vm, UINT32_MAX, budget - done - 1, &n));
+    } else {
+        while (done < budget && !vm->cpu_halted && !vm->halted)
+            done += llmp16_step(vm);
+    }
+    stats_poll(vm);
+    return done;
+}
+
+/* Exécute les CYCLES_PER_FRAME cycles d'une frame. Le dépassement d'une frame est repris sur la
+   suivante : les frontières de frame ne dépendent que des cycles, pas du temps hôte. */
+void llmp16_run_frame(llmp16_t *vm)
+{
+    vm->frame_credit += CYCLES_PER_FRAME;
+    vm->frame_credit -= (int64_t)llmp16_run_cycles(vm, (uint64_t)vm->frame_credit);
+    if (vm->cpu_halted) vm->frame_credit = 0;
+    vm->stats.frames++;
+}
+
+void llmp16_run(llmp16_t* vm) {
+    const uint32_t frameDelay = 1000 / FRAME_RATE;  // en ms (~16 ms)
+    uint32_t frameStart, frameTime;
+
+    while (!vm->halted) {
+        frameStart = SDL_GetTicks();
+
+        llmp16_keyboard_scan(vm);
+
+        // exécute CYCLES_PER_FRAME cycles avant chaque rendu
+        llmp16_run_frame(vm);
+
+        //llmp16_debug_dump(vm);
+
+        //printf("%d\n", llmp16_reg_get(vm, 0));
+
+        // un seul rendu par frame : banc affiché (port 0 registre 1), composé avec le port 5
+        const uint8_t *image = llmp16_video_frame(vm);
+        llmp16_screen_render(&vm->screen, image);
+        llmp16_video_present(vm, image);
+
+        // throttle pour rester à ~60 Hz
+        frameTime = SDL_GetTicks() - frameStart;
+        if (frameDelay > frameTime)
+            SDL_Delay(frameDelay - frameTime);
+    }
+}
+
+
+
+void llmp16_off(llmp16_t *vm)
+{
+    free(vm->memory);
+    free(vm->VRAM);
+    llmp16_predecode_free(vm);
+    llmp16_aot_detach(vm);
+    llmp16_video_free(vm);
+    llmp16_screen_off(&vm->screen);
+    free(vm);
+}
@@ -15,6 +15,9 @@ class INSTR(ABC):
 	defs: dict[str, tuple[str, int, int]] = {}
 	op = ""
 
+	# Size of the compiled instruction in bytes
+	size = 2
+
 	def __init__(self, op: str, 
 				 x: IMM | ADDRESS | REGISTER | None, 
 				 y: IMM | ADDRESS | REGISTER | None):
@@ -31,7 +34,7 @@ class INSTR(ABC):
 		return self.name \
 			+ (f" ({self.x})" if self.x is not None else "") \
 			+ (f", ({self.y})" if self.y is not None else "") \
-			+ f" -> [{binascii.hexlify(self.compile(), "-", 2)}]"
+			+ " -> [" + binascii.hexlify(self.compile(), "-", 2).decode() + "]"
 
 
 class ARITH(INSTR):
@@ -46,7 +49,8 @@ class ARITH(INSTR):
 		"cmp": ("Cmp", 2, 7),
 		"lsr": ("Lsr", 2, 8),
 		"asr": ("Asr", 2, 9),
-		"lsl": ("Lsl", 2, 10)
+		"lsl": ("Lsl", 2, 10),
+		"mulh": ("MulHigh", 2, 11)
 	}
 
 	def __init__(self, op: str, x: REGISTER, y: IMM | REGISTER | None):
@@ -67,8 +71,12 @@ class ARITH_R(ARITH):
 
 
 class ARITH_I(ARITH):
+	size = 4
+
 	def __init__(self, op: str, x: REGISTER, y: IMM):
 		super().__init__(op, x, y)
+		if op == "mulh":
+			raise ParsingError(y.line, "mulh has no immediate form")
 
 	def compile(self) -> bytes:
 		return bytes([
@@ -79,6 +87,57 @@ class ARITH_I(ARITH):
 		])
 
 
+class ARITHL(INSTR):
+	# 32-bit operands: r0-r7 are zero-extended, result in r15 (r<x> for shifts)
+	defs = {
+		"addl": ("AddLong", 2, 0),
+		"subl": ("SubLong", 2, 1),
+		"mull": ("MulLong", 2, 2),
+		"divl": ("DivLong", 2, 3),
+		"sdivl": ("SDivLong", 2, 4),
+		"cmpl": ("CmpLong", 2, 7),
+		"lsrl": ("LsrLong", 2, 8),
+		"asrl": ("AsrLong", 2, 9),
+		"lsll": ("LslLong", 2, 10),
+		"mulhl": ("MulHighLong", 2, 11),
+		"andl": ("AndLong", 2, 12),
+		"orl": ("OrLong", 2, 13),
+		"xorl": ("XorLong", 2, 14)
+	}
+
+	def __init__(self, op: str, x: REGISTER, y: IMM | ADDRESS | REGISTER):
+		super().__init__(op, x, y)
+
+
+class ARITHL_R(ARITHL):
+	def __init__(self, op: str, x: REGISTER, y: REGISTER):
+		super().__init__(op, x, y)
+
+	def compile(self) -> bytes:
+		return bytes([
+			(self.y.i << 4) + self.defs[self.op][2],
+			(0xC << 4) + self.x.i
+		])
+
+
+class ARITHL_I(ARITHL):
+	# 20-bit immediate: a plain immediate, or [0x12345] as for the 20-bit mov
+	size = 4
+
+	def __init__(self, op: str, x: REGISTER, y: IMM | ADDRESS):
+		super().__init__(op, x, y)
+		if op == "mulhl":
+			raise ParsingError(y.line, "mulhl has no immediate form")
+
+	def compile(self) -> bytes:
+		return bytes([
+			((self.y.i & 0xF0000) >> 12) + self.defs[self.op][2],
+			(0xD << 4) + self.x.i,
+			self.y.i & 0xFF,
+			(self.y.i >> 8) & 0xFF
+		])
+
+
 class LOGIC(INSTR):
 	defs = {
 		"and": ("And", 2, 0),
@@ -106,6 +165,8 @@ class LOGIC_R(LOGIC):
 
 
 class LOGIC_I(LOGIC):
+	size = 4
+
 	def __init__(self, op: str, x: REGISTER, y: IMM):
 		super().__init__(op, x, y)
 
@@ -126,9 +187,14 @@ class MEMCONTROL(INSTR):
 		"push": ("Push", 1, 3),
 		"pop": ("Pop", 1, 4),
 		"vld": ("VLoad", 2, 5),
-		"vstr": ("VStore", 2, 6)
+		"vstr": ("VStore", 2, 6),
+		"vldw": ("VLoadWord", 2, 7),
+		"vstrw": ("VStoreWord", 2, 8)
 	}
 
+	# Two pixels at a time, register form only
+	reg_only = ("vldw", "vstrw")
+
 	def __init__(self, op: str, x: REGISTER | IMM, y: IMM | ADDRESS | REGISTER | None):
 		super().__init__(op, x, y)
 
@@ -146,8 +212,12 @@ class MEMCONTROL_R(MEMCONTROL):
 
 
 class MEMCONTROL_I(MEMCONTROL):
+	size = 4
+
 	def __init__(self, op: str, x: REGISTER | IMM, y: IMM | None):
 		super().__init__(op, x, y)
+		if op in self.reg_only:
+			raise ParsingError(x.line, f"{op} has no immediate form")
 
 	def compile(self) -> bytes:
 		op1 = self.x.i if self.y is not None else 0
@@ -162,8 +232,12 @@ class MEMCONTROL_I(MEMCONTROL):
 
 
 class MEMCONTROL_A(MEMCONTROL):
+	size = 4
+
 	def __init__(self, op: str, x: REGISTER, y: ADDRESS):
 		super().__init__(op, x, y)
+		if op in self.reg_only:
+			raise ParsingError(x.line, f"{op} has no address form")
 
 	def compile(self) -> bytes:
 		return bytes([
@@ -210,6 +284,8 @@ class JUMP_R(JUMP):
 
 
 class JUMP_A(JUMP):
+	size = 4
+
 	def __init__(self, op: str, x: ADDRESS):
 		super().__init__(op, x)
 
@@ -255,6 +331,51 @@ class INOUT(INSTR):
 		])
 
 
+class BLOCK(INSTR):
+	# Count in r14 (IDX)
+	defs = {
+		"mcpy": ("MemCopy", 2, 0),
+		"mfil": ("MemFill", 2, 1),
+		"vfil": ("VramFill", 2, 2),
+		"mcmp": ("MemCompare", 2, 3)
+	}
+
+	def __init__(self, op: str, x: REGISTER, y: REGISTER):
+		super().__init__(op, x, y)
+
+	def compile(self) -> bytes:
+		return bytes([
+			(self.y.i << 4) + self.defs[self.op][2],
+			(0xB << 4) + self.x.i
+		])
+
+
+class PACKED(INSTR):
+	# Two 8-bit lanes per register, result in r15
+	defs = {
+		"padds": ("PackedAddSat", 2, 0),
+		"psubs": ("PackedSubSat", 2, 1),
+		"pavg": ("PackedAverage", 2, 2),
+		"pmin": ("PackedMin", 2, 3),
+		"pmax": ("PackedMax", 2, 4),
+		"pshuf": ("PackedShuffle", 2, 5)
+	}
+
+	def __init__(self, op: str, x: REGISTER, y: REGISTER | IMM):
+		super().__init__(op, x, y)
+		# pshuf takes a 4-bit lane selector instead of a register
+		if (op == "pshuf") != isinstance(y, IMM):
+			raise ParsingError(y.line, f"Wrong operand '{y}' for {op}")
+		if op == "pshuf" and y.i > 0xF:
+			raise ParsingError(y.line, f"Shuffle selector {y.i} is larger than 4 bits")
+
+	def compile(self) -> bytes:
+		return bytes([
+			(self.y.i << 4) + self.defs[self.op][2],
+			(0xE << 4) + self.x.i
+		])
+
+
 class BYTEARRAY(INSTR):
 	defs = { "bytearray": ("Bytearray", 0, 0) }
 
@@ -265,5 +386,9 @@ class BYTEARRAY(INSTR):
 			if b.i > 0x100:
 				raise ParsingError(b.line, f"Byte {b.i} (0x{b.i:x}) in bytearray is bigger than 8 bits")
 
+	@property
+	def size(self) -> int:
+		return len(self.bytes)
+
 	def compile(self) -> bytes:
 		return bytes([b.i for b in self.bytes])
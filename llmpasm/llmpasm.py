@@ -92,6 +92,7 @@ class Parser:
 		page = []
 		pc = 0
 		context = {}
+		emitted = 0
 
 		while True:
 			try:
@@ -116,11 +117,17 @@ class Parser:
 								match op2:
 									case IMM():
 										operation = ARITH_I
-										pc += 2
 									case REGISTER():
 										operation = ARITH_R
-										pc += 1
 							page.append(operation(s, reg, op2))
+						case s if s in ARITHL.defs:
+							reg = self.lexer.pop(REGISTER)
+							op2 = self.lexer.pop(IMM | ADDRESS | REGISTER)
+							match op2:
+								case REGISTER():
+									page.append(ARITHL_R(s, reg, op2))
+								case _:
+									page.append(ARITHL_I(s, reg, op2))
 						case s if s in LOGIC.defs:
 							operation = LOGIC_R
 							reg = self.lexer.pop(REGISTER)
@@ -130,10 +137,8 @@ class Parser:
 								match op2:
 									case IMM():
 										operation = LOGIC_I
-										pc += 2
 									case REGISTER():
 										operation = LOGIC_R
-										pc += 1
 							page.append(operation(s, reg, op2))
 						case s if s in MEMCONTROL.defs:
 							operation = MEMCONTROL_R
@@ -142,7 +147,6 @@ class Parser:
 							match op1:
 								case IMM():
 									operation = MEMCONTROL_I
-									pc += 2
 								case REGISTER():
 									op2 = None
 									if MEMCONTROL.defs[s][1] > 1:
@@ -150,17 +154,13 @@ class Parser:
 										match op2:
 											case IMM():
 												operation = MEMCONTROL_I
-												pc += 2
 											case ADDRESS():
 												operation = MEMCONTROL_A
-												pc += 2
 											case LABEL(i=label):
 												operation = MEMCONTROL_A
 												op2 = LABELED_ADDRESS(op2.line, label, context)
-												pc += 2
 											case REGISTER():
 												operation = MEMCONTROL_R
-												pc += 1
 							page.append(operation(s, op1, op2))
 						case s if s in JUMP.defs:
 							operation = JUMP_R
@@ -170,14 +170,11 @@ class Parser:
 								match op1:
 									case REGISTER():
 										operation = JUMP_R
-										pc += 1
 									case ADDRESS():
 										operation = JUMP_A
-										pc += 2
 									case LABEL(i=label):
 										operation = JUMP_A
 										op1 = LABELED_ADDRESS(op1.line, label, context)
-										pc += 2
 							page.append(operation(s, op1))
 						case s if s in SPECIAL.defs:
 							page.append(SPECIAL(s))
@@ -187,6 +184,10 @@ class Parser:
 									self.lexer.pop(REGISTER),
 									self.lexer.pop(REGISTER),
 									self.lexer.pop(IMM)))
+						case s if s in BLOCK.defs:
+							page.append(BLOCK(s, self.lexer.pop(REGISTER), self.lexer.pop(REGISTER)))
+						case s if s in PACKED.defs:
+							page.append(PACKED(s, self.lexer.pop(REGISTER), self.lexer.pop(REGISTER | IMM)))
 						case _:
 							raise ParsingError(token.line, f"Unknown operator '{s}'")
 				case LABELDEF(i=label):
@@ -199,6 +200,12 @@ class Parser:
 				case _:
 					raise ParsingError(token.line, f"Wrong token '{token}'")
 
+			# Labels are byte addresses: advance by the size of what was just emitted
+			for instr in page[emitted:]:
+				pc += instr.size
+			emitted = len(page)
+
+		self.labels = context
 		return page
 
 
@@ -211,6 +218,7 @@ if __name__ == "__main__":
 	parser.add_argument("-o", "--output", type=str, default=f"{os.getcwd()}/a.out", help="Output filename")
 	parser.add_argument("-d", "--debug", action="store_true", help="Print the error stacktrace")
 	parser.add_argument("-v", "--verbose", action="store_true", help="Print the parsed instructions")
+	parser.add_argument("-m", "--map", type=str, help="Write the label map (\"0xADDR label\" per line) to this file")
 
 	args = parser.parse_args()
 
@@ -219,7 +227,8 @@ if __name__ == "__main__":
 
 	with open(args.filename) as inputfile:
 		lexer = Lexer(inputfile.read())
-		parsed = Parser(lexer).parse()
+		parser = Parser(lexer)
+		parsed = parser.parse()
 
 		if args.verbose:
 			print(f"Compiled content from {args.filename}:")
@@ -229,3 +238,8 @@ if __name__ == "__main__":
 		with open(args.output, "bw") as outputfile:
 			for s in parsed:
 				outputfile.write(s.compile())
+
+		if args.map:
+			with open(args.map, "w") as mapfile:
+				for label, addr in sorted(parser.labels.items(), key=lambda item: item[1]):
+					mapfile.write(f"0x{addr:05x} {label}\n")
@@ -2,145 +2,494 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
-#include <SDL2/SDL.h>
 #include <string.h>
 #include "llmp16.h"         // Structure de la VM
+#include "llmp16_sched.h"   // Ordonnanceur multi-VM
+#include "llmp16_profiler.h" // Profileur invité
+#include "llmp16_trace.h"    // Traceur d'exécution
+#include "llmp16_debug.h"    // Debugger
+#include "llmp16_gdb.h"      // Stub GDB
+#include "llmp16_journal.h"  // Enregistrement / rejeu des entrées
+#include "llmp16_rewind.h"   // Rembobinage
+#include "llmp16_shm.h"      // Export des images en mémoire partagée
+#include "llmp16_capture.h"  // Capture des images sur disque
+#include "llmp16_asset.h"    // Paquets d'assets
+
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+        "Usage : %s [options] [rom.bin]\n"
+        "  -n <vms>      lance <vms> machines headless avec la même ROM\n"
+        "  -j <threads>  nombre de threads de l'ordonnanceur (défaut : 4)\n"
+        "  -s <instr>    instructions par tranche (défaut : %d)\n"
+        "  -c <instr>    quota total d'instructions par VM (défaut : jusqu'au HALT)\n"
+        "  -p <cycles>   active le profileur (première VM), un échantillon tous les <cycles>\n"
+        "  -m <map>      table de labels produite par llmpasm.py -m\n"
+        "  -f <fichier>  piles au format folded (défaut : profile.folded)\n"
+        "  -t <fichier>  enregistre une trace binaire (voir build/llmp16_tracedump)\n"
+        "  -T <enreg>    mode déclenché : ne garde que les <enreg> derniers enregistrements\n"
+        "                avant un HALT, un opcode invalide ou le watchpoint\n"
+        "  -w <adr>      watchpoint de la trace sur le mot à l'adresse <adr>\n"
+        "  -J <fichier>  relevés JSON des compteurs chaque seconde invitée (\"-\" = stdout)\n"
+        "  -F <mode>     défauts mémoire : ignore (défaut) ou halt\n"
+        "  -M <on|off>   fenêtre VRAM (0xA0000) et registres IO (0xC0000) dans l'espace mémoire\n"
+        "  -D            console de debug (sans affichage)\n"
+        "  -g <port|sock> attend GDB sur un port TCP local ou une socket Unix (sans affichage)\n"
+        "  -r <journal>  enregistre les entrées (clavier, arrêt) avec leur cycle\n"
+        "  -R <journal>  rejoue un journal sans affichage et à pleine vitesse\n"
+        "  -b <Mo>       rembobinage pour -D et -g : instantanés dans un budget de <Mo> Mo\n"
+        "  -S <nom>      publie chaque image dans l'anneau partagé /<nom> (/<nom>-<i> avec -n)\n"
+        "  -C <cible>    capture les images (première VM avec -n) : flux brut compressé,\n"
+        "                motif PPM (images/f_%%05u.ppm) ou |commande d'encodage\n"
+        "  -A <paquet>[@adr] charge un paquet d'assets en mémoire (défaut : 0x%05X),\n"
+        "                \"-A @<adr>\" désigne un paquet déjà présent dans la ROM\n"
+        "  -V <nom>      copie l'image <nom> du paquet en VRAM par le DMA au démarrage\n"
+        "  -x <1-4>      échelle de la fenêtre (défaut : %d)\n"
+        "  -e <effet>    none (défaut), scanlines ou crt\n",
+        prog, LLMP_SCHED_SLICE, LLMP_ASSET_BASE, LLMP_SCREEN_SCALE);
+}
 
+/* Options de diagnostic partagées par les deux modes */
+typedef struct {
+    uint32_t period;           /* 0 = profileur désactivé */
+    const char *map;
+    const char *folded;
+    const char *trace;         /* NULL = traceur désactivé */
+    uint32_t trigger;          /* 0 = trace continue */
+    long watch;                /* -1 = pas de watchpoint */
+    FILE *stats;               /* NULL = pas de relevés de compteurs */
+    bool fault_halt;           /* arrêter le CPU au premier défaut mémoire */
+    bool mmio;                 /* installer la fenêtre VRAM/IO */
+    bool debug;                /* console de debug */
+    const char *gdb;           /* NULL = pas de stub GDB */
+    const char *record;        /* journal à enregistrer (NULL = aucun) */
+    const char *replay;        /* journal à rejouer (NULL = aucun) */
+    size_t rewind;             /* budget du rembobinage en octets (0 = désactivé) */
+    const char *shm;           /* anneau d'images en mémoire partagée (NULL = aucun) */
+    const char *capture;       /* cible de la capture d'images (NULL = aucune) */
+    const char *asset;         /* paquet d'assets à charger (NULL = aucun) */
+    uint32_t asset_addr;       /* adresse du paquet en mémoire */
+    const char *show;          /* image du paquet à copier en VRAM (NULL = aucune) */
+} prof_opts_t;
+
+static void report_faults(const llmp16_t *vm, size_t index)
+{
+    if (vm->stats.mem_faults == 0) return;
+    fprintf(stderr, "VM %zu : %llu défaut(s) mémoire, dernier : %s en 0x%05X (PC 0x%05X)\n",
+            index, (unsigned long long)vm->stats.mem_faults, llmp16_fault_name(vm->fault.kind),
+            vm->fault.addr, vm->fault.pc);
+}
 
+static void trace_attach(llmp16_t *vm, const prof_opts_t *opts)
+{
+    if (opts->stats != NULL) llmp16_stats_set_dump(vm, opts->stats, CPU_FREQ);
+    if (opts->trace == NULL) return;
+
+    llmp16_trace_t *trace = (llmp16_trace_t *)malloc(sizeof(llmp16_trace_t));
+    llmp16_trace_mode_t mode = opts->trigger ? LLMP_TRACE_TRIGGER : LLMP_TRACE_STREAM;
+    if (trace == NULL || llmp16_trace_open(trace, opts->trace, mode, opts->trigger ? opts->trigger : 65536) != 0) {
+        free(trace);
+        fprintf(stderr, "Erreur : impossible d'ouvrir la trace\n");
+        return;
+    }
+    if (opts->watch >= 0) llmp16_trace_watch(trace, (uint32_t)opts->watch, 2);
+    vm->trace = trace;
+}
 
-void llmp16_init(llmp16_t *vm)
+static void rewind_attach(llmp16_t *vm, const prof_opts_t *opts)
 {
-    llmp16_reg_set(vm, PC, 0);
-    llmp16_reg_set(vm, SP, 0xFFFFF);
+    if (opts->rewind == 0) return;
 
-    vm->FLAGS = 0;
-    vm->halted = false;
+    llmp16_rewind_t *rw = (llmp16_rewind_t *)malloc(sizeof(llmp16_rewind_t));
+    if (rw == NULL || llmp16_rewind_init(rw, opts->rewind, 0) != 0) {
+        free(rw);
+        fprintf(stderr, "Erreur : impossible d'initialiser le rembobinage\n");
+        return;
+    }
+    llmp16_rewind_attach(vm, rw);
+}
 
-    vm->memory = (uint8_t *)malloc(LLMP_MEM_SIZE * sizeof(uint8_t));
+static void rewind_finish(llmp16_t *vm)
+{
+    llmp16_rewind_t *rw = vm->rewind;
+    if (rw == NULL) return;
+
+    fprintf(stderr, "Rewind : %llu instantané(s), %u en mémoire (%zu Ko), pause max %.1f us\n",
+            (unsigned long long)rw->taken, rw->count, rw->used / 1024, rw->max_pause_ns / 1000.0);
+    llmp16_rewind_detach(vm);
+    llmp16_rewind_free(rw);
+    free(rw);
+}
 
-    vm->VRAM = (uint8_t*)malloc(LLMP_VRAM_BANK_SIZE * sizeof(uint8_t ));
-    
-    llmp16_keyb_init();
-    
-    llmp16_timer_init(&vm->timer1, 0, 0, 0);
-    llmp16_timer_init(&vm->timer2, 0, 0, 0);
-    llmp16_timer_init(&vm->timer3, 0, 0, 0);
-    llmp16_screen_init(&vm->screen);
-    llmp16_dma_init(&vm->dma);
+/* Paquet d'assets chargé après la ROM, image éventuelle envoyée en VRAM */
+static void asset_attach(llmp16_t *vm, const prof_opts_t *opts)
+{
+    if (opts->asset != NULL && llmp16_asset_load(vm, opts->asset, opts->asset_addr) != 0)
+        fprintf(stderr, "Erreur : impossible de charger le paquet %s\n", opts->asset);
+    else if (opts->show != NULL && llmp16_asset_to_vram(vm, opts->asset_addr, opts->show, 0) != 0)
+        fprintf(stderr, "Erreur : impossible de copier %s en VRAM\n", opts->show);
+}
 
-    
-    for (int i = 0; i < LLMP_IO_PORTS; i++) {
-        for (int j = 0; j < LLMP_IO_REGS; j++) {
-            vm->IO[i][j] = 0;
-        }
+/* Export des images : /<nom> pour une VM, /<nom>-<index> pour les VMs d'une ferme */
+static void shm_attach(llmp16_t *vm, const prof_opts_t *opts, long index)
+{
+    if (opts->shm == NULL) return;
+
+    char name[64];
+    if (index < 0) snprintf(name, sizeof(name), "/%s", opts->shm);
+    else snprintf(name, sizeof(name), "/%s-%ld", opts->shm, index);
+    llmp16_shm_t *shm = (llmp16_shm_t *)malloc(sizeof(llmp16_shm_t));
+    if (shm == NULL || llmp16_shm_create(shm, name, LLMP_SHM_SLOTS) != 0) {
+        free(shm);
+        fprintf(stderr, "Erreur : impossible de créer l'anneau d'images %s\n", name);
+        return;
     }
-    
+    vm->shm = shm;
+}
 
+static void shm_finish(llmp16_t *vm)
+{
+    if (vm->shm == NULL) return;
+    llmp16_shm_close(vm->shm);
+    free(vm->shm);
+    vm->shm = NULL;
 }
 
-void llmp16_debug_dump(llmp16_t *vm)
+static void capture_attach(llmp16_t *vm, const prof_opts_t *opts)
 {
-    const char* reg_names[16] = {
-        "R0", "R1", "R2", "R3",
-        "R4", "R5", "R6", "R7",
-        "R8", "R9", "R10","RR11",
-        "PC","SP","IDX","ACC"
-    };
+    if (opts->capture == NULL) return;
 
-    // 1) Registres généraux et spéciaux
-    printf("=== Registres ===\n");
-    for (int i = 0; i < 16; i++) {
-        uint32_t val = llmp16_reg_get(vm, (llmp16_register_t)i);
-        // On affiche sur 16 bits pour R0-RR11, sur 32 bits pour PC/SP/IDX/ACC
-        if (i < 12)
-            printf("%4s = 0x%04X\n", reg_names[i], val);
-        else
-            printf("%4s = 0x%08X\n", reg_names[i], val);
+    llmp16_capture_t *cap = (llmp16_capture_t *)malloc(sizeof(llmp16_capture_t));
+    if (cap == NULL || llmp16_capture_open(cap, opts->capture) != 0) {
+        free(cap);
+        fprintf(stderr, "Erreur : impossible d'ouvrir la capture %s\n", opts->capture);
+        return;
     }
+    vm->capture = cap;
+}
 
-    // 2) Flags NZCV
-    printf("\n=== Flags ===\n");
-    printf("N=%u  Z=%u  C=%u  V=%u\n",
-        flag_get(vm, FLAG_N),
-        flag_get(vm, FLAG_Z),
-        flag_get(vm, FLAG_C),
-        flag_get(vm, FLAG_V));
-
-    // 3) Autres états de la VM
-    printf("\n=== VM State ===\n");
-    printf("HALTED = %u\n", vm->halted);
-
-
-    // 4) Tous les ports IO
-    printf("\n=== IO Ports ===\n");
-    for (int p = 0; p < LLMP_IO_PORTS; p++) {
-        printf("Port %2d: ", p);
-        for (int r = 0; r < LLMP_IO_REGS; r++) {
-            printf("%04X ", vm->IO[p][r]);
-        }
-        printf("\n");
-    }
+static void capture_finish(llmp16_t *vm)
+{
+    llmp16_capture_t *cap = vm->capture;
+    if (cap == NULL) return;
+
+    llmp16_capture_close(cap);
+    fprintf(stderr, "Capture : %llu image(s), %llu Ko écrits, %llu attente(s) de l'encodeur%s\n",
+            (unsigned long long)cap->frames, (unsigned long long)(cap->bytes / 1024),
+            (unsigned long long)cap->stalls, cap->errors ? ", interrompue sur erreur" : "");
+    vm->capture = NULL;
+    free(cap);
 }
 
+static void trace_finish(llmp16_t *vm)
+{
+    if (vm->stats_out != NULL) llmp16_stats_write_json(vm, vm->stats_out);
+    if (vm->trace == NULL) return;
+    llmp16_trace_close(vm->trace);
+    free(vm->trace);
+    vm->trace = NULL;
+}
 
-#define CPU_FREQ     5000000   // 5 MHz
-#define FRAME_RATE   60
-#define CYCLES_PER_FRAME (CPU_FREQ / FRAME_RATE)
+static llmp16_profiler_t *profiler_attach(llmp16_t *vm, const prof_opts_t *opts)
+{
+    trace_attach(vm, opts);
+    if (opts->period == 0) return NULL;
+
+    llmp16_profiler_t *prof = (llmp16_profiler_t *)malloc(sizeof(llmp16_profiler_t));
+    if (prof == NULL || llmp16_profiler_init(prof, opts->period) != 0) {
+        free(prof);
+        fprintf(stderr, "Erreur : impossible d'initialiser le profileur\n");
+        return NULL;
+    }
+    if (opts->map != NULL) llmp16_profiler_load_symbols(prof, opts->map);
+    vm->profiler = prof;
+    return prof;
+}
 
-void llmp16_run(llmp16_t* vm) {
-    const uint32_t frameDelay = 1000 / FRAME_RATE;  // en ms (~16 ms)
-    uint32_t frameStart, frameTime;
+static void profiler_finish(llmp16_t *vm, const prof_opts_t *opts)
+{
+    trace_finish(vm);
+    llmp16_profiler_t *prof = vm->profiler;
+    if (prof == NULL) return;
+
+    FILE *out = fopen(opts->folded, "w");
+    if (out != NULL) {
+        llmp16_profiler_write_folded(prof, out);
+        fclose(out);
+    } else {
+        perror("Profile write error");
+    }
+    llmp16_profiler_report(prof, stdout, 20);
 
-    while (!vm->halted) {
-        frameStart = SDL_GetTicks();
+    vm->profiler = NULL;
+    llmp16_profiler_free(prof);
+    free(prof);
+}
 
-        llmp16_keyboard_scan(vm);
+/* Mode ferme de test : plusieurs VMs sans affichage réparties sur un pool de threads */
+static int run_farm(const char *rom, size_t nb_vms, int nb_threads, uint32_t slice, uint64_t budget,
+                    const prof_opts_t *prof)
+{
+    llmp16_t **vms = (llmp16_t **)calloc(nb_vms, sizeof(llmp16_t *));
+    if (vms == NULL) return EXIT_FAILURE;
+
+    size_t created = 0;
+    int ret = EXIT_SUCCESS;
+    for (; created < nb_vms; created++) {
+        llmp16_t *vm = (llmp16_t *)malloc(sizeof(llmp16_t));
+        if (vm == NULL) {
+            perror("VM alloc error");
+            ret = EXIT_FAILURE;
+            break;
+        }
+        vms[created] = vm;
+        llmp16_init(vm);
+        if (rom != NULL) llmp16_rom_load(vm, (char *)rom);
+        asset_attach(vm, prof);
+        if (prof->stats != NULL) llmp16_stats_set_dump(vm, prof->stats, CPU_FREQ);
+        vm->fault_halt = prof->fault_halt;
+        if (prof->mmio) llmp16_mem_map_devices(vm);
+        shm_attach(vm, prof, (long)created);
+    }
 
-        // exécute CYCLES_PER_FRAME cycles avant chaque rendu
-        for (uint32_t i = 0; i < CYCLES_PER_FRAME; i++) {
-            llmp16_cpu_cycle(vm);
-            llmp16_blitter_step(vm);
-            llmp16_dma_step(vm, &vm->dma);
+    if (ret == EXIT_SUCCESS) {
+        profiler_attach(vms[0], prof);
+        capture_attach(vms[0], prof);
+
+        llmp16_sched_t sched;
+        if (llmp16_sched_init(&sched, vms, nb_vms, nb_threads, slice, budget) != 0) {
+            fprintf(stderr, "Erreur : impossible d'initialiser l'ordonnanceur\n");
+            ret = EXIT_FAILURE;
+        } else {
+            llmp16_sched_run(&sched);
+            llmp16_sched_report(&sched, stdout);
+            llmp16_sched_free(&sched);
         }
+        capture_finish(vms[0]);
+        profiler_finish(vms[0], prof);
+    }
 
-        //llmp16_debug_dump(vm);
+    // même nettoyage en cas d'échec, pour les VMs déjà créées
+    for (size_t i = 0; i < created; i++) {
+        if (i > 0 && vms[i]->stats_out != NULL) llmp16_stats_write_json(vms[i], vms[i]->stats_out);
+        report_faults(vms[i], i);
+        shm_finish(vms[i]);
+        llmp16_off(vms[i]);
+    }
+    free(vms);
+    return ret;
+}
 
-        //printf("%d\n", llmp16_reg_get(vm, 0));
+/* Mode debug : une VM sans affichage pilotée depuis la console */
+static int run_debug(const char *rom, const prof_opts_t *prof)
+{
+    llmp16_t *vm = (llmp16_t *)malloc(sizeof(llmp16_t));
+    llmp16_debug_t dbg;
 
-        // un seul rendu par frame
-        llmp16_screen_render(vm->screen, vm->VRAM);
+    llmp16_init(vm);
+    vm->fault_halt = prof->fault_halt;
+    if (prof->mmio) llmp16_mem_map_devices(vm);
+    if (rom != NULL) llmp16_rom_load(vm, (char *)rom);
+    asset_attach(vm, prof);
+    profiler_attach(vm, prof);
 
-        // throttle pour rester à ~60 Hz
-        frameTime = SDL_GetTicks() - frameStart;
-        if (frameDelay > frameTime)
-            SDL_Delay(frameDelay - frameTime);
-    }
+    rewind_attach(vm, prof);
+
+    llmp16_debug_attach(vm, &dbg);
+    llmp16_debug_console(vm, stdin, stdout);
+    llmp16_debug_detach(vm);
+    rewind_finish(vm);
+
+    profiler_finish(vm, prof);
+    report_faults(vm, 0);
+    llmp16_off(vm);
+    return EXIT_SUCCESS;
 }
 
+/* Mode GDB : une VM sans affichage servie au stub RSP */
+static int run_gdb(const char *rom, const prof_opts_t *prof)
+{
+    llmp16_gdb_t *gdb = (llmp16_gdb_t *)malloc(sizeof(llmp16_gdb_t));
+    if (gdb == NULL || llmp16_gdb_listen(gdb, prof->gdb) != 0) {
+        free(gdb);
+        return EXIT_FAILURE;
+    }
 
+    llmp16_t *vm = (llmp16_t *)malloc(sizeof(llmp16_t));
+    llmp16_init(vm);
+    vm->fault_halt = prof->fault_halt;
+    if (prof->mmio) llmp16_mem_map_devices(vm);
+    if (rom != NULL) llmp16_rom_load(vm, (char *)rom);
+    asset_attach(vm, prof);
+    profiler_attach(vm, prof);
+
+    rewind_attach(vm, prof);
+
+    fprintf(stderr, "GDB : en attente sur %s\n", prof->gdb);
+    int ret = llmp16_gdb_serve(gdb, vm);
+    rewind_finish(vm);
+    llmp16_gdb_close(gdb);
+    free(gdb);
+
+    profiler_finish(vm, prof);
+    report_faults(vm, 0);
+    llmp16_off(vm);
+    return ret;
+}
 
-void llmp16_off(llmp16_t *vm)
+/* Mode rejeu : une VM sans affichage alimentée par un journal d'entrées */
+static int run_replay(const char *rom, const prof_opts_t *prof)
 {
-    free(vm->memory);
-    free(vm->VRAM);
-    llmp16_screen_off(&vm->screen);
-    free(vm);
+    llmp16_t *vm = (llmp16_t *)malloc(sizeof(llmp16_t));
+    llmp16_journal_t journal;
+
+    llmp16_init(vm);
+    vm->fault_halt = prof->fault_halt;
+    if (prof->mmio) llmp16_mem_map_devices(vm);
+    if (rom != NULL) llmp16_rom_load(vm, (char *)rom);
+    asset_attach(vm, prof);
+    if (llmp16_journal_open(&journal, vm, prof->replay, LLMP_JOURNAL_REPLAY) != 0) {
+        llmp16_off(vm);
+        return EXIT_FAILURE;
+    }
+    profiler_attach(vm, prof);
+    shm_attach(vm, prof, -1);
+    capture_attach(vm, prof);
+
+    vm->journal = &journal;
+    llmp16_journal_replay(vm);
+    vm->journal = NULL;
+    capture_finish(vm);
+    shm_finish(vm);
+    fprintf(stderr, "Rejeu : %llu entrée(s), %llu cycles, %llu instructions\n",
+            (unsigned long long)journal.events, (unsigned long long)vm->stats.cycles,
+            (unsigned long long)vm->stats.instructions);
+    llmp16_journal_close(&journal);
+
+    profiler_finish(vm, prof);
+    report_faults(vm, 0);
+    llmp16_off(vm);
+    return EXIT_SUCCESS;
 }
 
 int main(int argc, char *argv[])
 {
+    const char *rom = NULL;
+    size_t nb_vms = 0;
+    int nb_threads = 4;
+    uint32_t slice = LLMP_SCHED_SLICE;
+    uint64_t budget = 0;
+    prof_opts_t prof = { 0, NULL, "profile.folded", NULL, 0, -1, NULL, false, false, false, NULL, NULL, NULL, 0, NULL, NULL,
+                         NULL, LLMP_ASSET_BASE, NULL };
+    int scale = LLMP_SCREEN_SCALE;
+    llmp16_filter_t filter = LLMP_FILTER_NONE;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-D") == 0) {
+            prof.debug = true;
+        } else if (argv[i][0] == '-' && i + 1 < argc) {
+            switch (argv[i][1]) {
+            case 'n': nb_vms = strtoul(argv[++i], NULL, 0); break;
+            case 'j': nb_threads = atoi(argv[++i]); break;
+            case 's': slice = strtoul(argv[++i], NULL, 0); break;
+            case 'c': budget = strtoull(argv[++i], NULL, 0); break;
+            case 'p': prof.period = strtoul(argv[++i], NULL, 0); break;
+            case 'm': prof.map = argv[++i]; break;
+            case 'f': prof.folded = argv[++i]; break;
+            case 't': prof.trace = argv[++i]; break;
+            case 'T': prof.trigger = strtoul(argv[++i], NULL, 0); break;
+            case 'w': prof.watch = strtol(argv[++i], NULL, 0); break;
+            case 'J':
+                i++;
+                prof.stats = strcmp(argv[i], "-") == 0 ? stdout : fopen(argv[i], "w");
+                if (prof.stats == NULL) perror("Stats open error");
+                break;
+            case 'F': prof.fault_halt = strcmp(argv[++i], "halt") == 0; break;
+            case 'M': prof.mmio = strcmp(argv[++i], "on") == 0; break;
+            case 'g': prof.gdb = argv[++i]; break;
+            case 'r': prof.record = argv[++i]; break;
+            case 'R': prof.replay = argv[++i]; break;
+            case 'b': prof.rewind = (size_t)strtoul(argv[++i], NULL, 0) << 20; break;
+            case 'S': prof.shm = argv[++i]; break;
+            case 'C': prof.capture = argv[++i]; break;
+            case 'A': {
+                char *at = strrchr(argv[++i], '@');
+                if (at != NULL) {
+                    *at = '\0';
+                    prof.asset_addr = strtoul(at + 1, NULL, 0) & LLMP_ADDR_MASK;
+                }
+                prof.asset = argv[i][0] != '\0' ? argv[i] : NULL;
+                break;
+            }
+            case 'V': prof.show = argv[++i]; break;
+            case 'x':
+                scale = atoi(argv[++i]);
+                if (scale < 1 || scale > LLMP_SCREEN_SCALE_MAX) { usage(argv[0]); return EXIT_FAILURE; }
+                break;
+            case 'e':
+                i++;
+                if (strcmp(argv[i], "none") == 0) filter = LLMP_FILTER_NONE;
+                else if (strcmp(argv[i], "scanlines") == 0) filter = LLMP_FILTER_SCANLINES;
+                else if (strcmp(argv[i], "crt") == 0) filter = LLMP_FILTER_CRT;
+                else { usage(argv[0]); return EXIT_FAILURE; }
+                break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+            }
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            rom = argv[i];
+        }
+    }
+
+    if (prof.debug)
+        return run_debug(rom, &prof);
+    if (prof.gdb != NULL)
+        return run_gdb(rom, &prof);
+    if (prof.replay != NULL)
+        return run_replay(rom, &prof);
+    if (nb_vms > 0)
+        return run_farm(rom, nb_vms, nb_threads, slice, budget, &prof);
+
     /*==================== Initialisation de la machine virtuelle =====================*/
     llmp16_t* vm = (llmp16_t*)malloc(sizeof(llmp16_t));
     llmp16_init(vm);
-    if(argc > 1)
+    vm->fault_halt = prof.fault_halt;
+    if (prof.mmio) llmp16_mem_map_devices(vm);
+    vm->screen.scale = scale;
+    vm->screen.filter = filter;
+    if (llmp16_display_init(vm) != EXIT_SUCCESS)
     {
-        llmp16_rom_load(vm, argv[1]);
+        llmp16_off(vm);
+        return EXIT_FAILURE;
     }
+    if(rom != NULL)
+    {
+        llmp16_rom_load(vm, (char *)rom);
+    }
+    asset_attach(vm, &prof);
 
     dump_memory(vm->memory, 512);
+    profiler_attach(vm, &prof);
+    shm_attach(vm, &prof, -1);
+    capture_attach(vm, &prof);
+
+    llmp16_journal_t journal;
+    if (prof.record != NULL && llmp16_journal_open(&journal, vm, prof.record, LLMP_JOURNAL_RECORD) == 0)
+        vm->journal = &journal;
 
     /*==================== Boucle de simulation =====================*/
     llmp16_run(vm);
+    if (vm->journal != NULL) {
+        llmp16_journal_close(&journal);
+        vm->journal = NULL;
+    }
+    capture_finish(vm);
+    shm_finish(vm);
+    profiler_finish(vm, &prof);
+    report_faults(vm, 0);
     llmp16_off(vm);
 
 
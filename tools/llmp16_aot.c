@@ -0,0 +1,604 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "llmp16.h"
+#include "llmp16_aot.h"
+
+/*
+ * Traducteur AOT : image de ROM LLMP16 -> fichier C (voir llmp16_aot.h)
+ * Usage : llmp16_aot rom.bin [-o sortie.c] [-e adresse]...
+ *
+ * Les blocs partent de l'adresse 0, des adresses -e et de toutes les cibles découvertes :
+ * sauts immédiats, CALL et leur adresse de retour, suite d'un saut conditionnel. Un bloc
+ * n'exécute que des accès par les pointeurs rapides : un accès qui passerait par le chemin
+ * lent (MMIO, ROM en écriture, page non mappée ou copiée au rembobinage) fait sortir le bloc
+ * avant l'instruction, que l'interpréteur exécute. Un IN ne se traduit qu'en tête de bloc,
+ * quand les compteurs de la VM sont à jour (le port de statistiques les lit). Une instruction
+ * de bloc (MCPY, MFIL, VFIL, MCMP), dont les accès ne sont connus qu'à l'exécution, forme un
+ * bloc à elle seule et passe par execute().
+ */
+
+#define PC_REG  12
+#define SP_REG  13
+#define ACC_REG 15
+
+typedef struct {
+    uint8_t  rom[LLMP_ROM_SIZE];
+    uint32_t size;
+    uint8_t  leader[LLMP_ROM_SIZE / 2];     /* 1 = début de bloc à traduire */
+    uint32_t queue[LLMP_ROM_SIZE / 2];
+    uint32_t queued;
+} aot_t;
+
+typedef struct {
+    instr_t  in[LLMP_AOT_BLOCK_MAX];
+    uint32_t at[LLMP_AOT_BLOCK_MAX + 1];    /* adresse de chaque instruction, puis la suite */
+    uint32_t cycles[LLMP_AOT_BLOCK_MAX + 1];/* cycles avant chaque instruction */
+    int n;
+    bool loops;                             /* le saut final revient au début du bloc */
+} block_t;
+
+static bool word_at(const aot_t *aot, uint32_t addr, uint16_t *w)
+{
+    if (addr + 1 >= aot->size) return false;
+    *w = (uint16_t)(aot->rom[addr] | aot->rom[addr + 1] << 8);
+    return true;
+}
+
+static void add_leader(aot_t *aot, uint32_t addr)
+{
+    if (addr >= aot->size || (addr & 1) || aot->leader[addr >> 1]) return;
+    aot->leader[addr >> 1] = 1;
+    aot->queue[aot->queued++] = addr;
+}
+
+static bool is_jump(const instr_t *in)
+{
+    return (in->op_class == 0x7 || in->op_class == 0x8) && in->t <= 0xD;
+}
+
+/* Instructions dont RX est la destination : avec X = PC, la suite n'est connue qu'à l'exécution */
+static bool writes_x(const instr_t *in)
+{
+    if (!llmp16_instr_valid(in)) return false;
+    switch (in->op_class) {
+    case 0x1: return in->t == 0x5 || in->t == 0x6 || (in->t >= 0x8 && in->t <= 0xA);
+    case 0x2: return in->t >= 0x8 && in->t <= 0xA;
+    case 0x5: return in->t == 0x0 || in->t == 0x1 || in->t == 0x4 || in->t == 0x5 || in->t == 0x7;
+    case 0x6: return in->t == 0x0 || in->t == 0x1 || in->t == 0x5;
+    case 0x9: return true;
+    case 0xC: case 0xD: return in->t >= 0x8 && in->t <= 0xA;
+    default:  return false;
+    }
+}
+
+/* Décode le bloc qui commence à <start> ; retourne false s'il est vide */
+static bool scan_block(const aot_t *aot, uint32_t start, block_t *b)
+{
+    uint32_t at = start, cycles = 0;
+    b->n = 0;
+    b->loops = false;
+
+    while (b->n < LLMP_AOT_BLOCK_MAX) {
+        uint16_t w, ext = 0;
+        if (!word_at(aot, at, &w)) break;
+        int words = llmp16_instr_words(w);
+        if (words == 2 && !word_at(aot, at + 2, &ext)) break;
+        instr_t in = llmp16_decode_raw(w, ext);
+        if ((in.op_class == 0x9 || in.op_class == 0xB) && b->n > 0) break;   // IN, blocs : en tête
+
+        b->in[b->n] = in;
+        b->at[b->n] = at;
+        b->cycles[b->n] = cycles;
+        b->n++;
+        at += 2 * words;
+        cycles += in.cycles;
+
+        if (is_jump(&in) || in.raw == 0x0001 || in.op_class == 0xA || in.op_class == 0xB
+            || (writes_x(&in) && in.X == PC_REG))
+            break;
+    }
+    b->at[b->n] = at;
+    b->cycles[b->n] = cycles;
+
+    // un IN en tête lit les compteurs, que la boucle locale ne remet à jour qu'à la sortie :
+    // le saut vers le début repasse alors par llmp16_aot_group
+    if (b->n > 0 && b->in[0].op_class != 0x9) {
+        const instr_t *last = &b->in[b->n - 1];
+        b->loops = last->op_class == 0x8 && last->t <= 0xC && last->addr == start;
+    }
+    return b->n > 0;
+}
+
+/* Successeurs statiques du bloc */
+static void follow(aot_t *aot, const block_t *b)
+{
+    const instr_t *last = &b->in[b->n - 1];
+    uint32_t next = b->at[b->n];
+
+    if (last->op_class == 0x8 && last->t <= 0xD) {
+        add_leader(aot, last->addr);
+        if (last->t != 0x0) add_leader(aot, next);    // Jcc non pris, retour de CALL
+    } else if (last->op_class == 0x7 && last->t <= 0xD) {
+        if (last->t != 0x0 && last->t != 0xD) add_leader(aot, next);
+    } else if (last->raw != 0x0001 && !(writes_x(last) && last->X == PC_REG)) {
+        add_leader(aot, next);                        // OUT, instruction de bloc, IN suivant, bloc plein
+    }
+}
+
+
+/*============================== Émission ==============================*/
+
+static void exit_before(FILE *o, const block_t *b, int k)
+{
+    if (b->loops)
+        fprintf(o, "{ vm->R[PC] = 0x%05X; *count = n + %d; return cycles + %u; }\n", b->at[k], k, b->cycles[k]);
+    else
+        fprintf(o, "{ vm->R[PC] = 0x%05X; *count = %d; return %u; }\n", b->at[k], k, b->cycles[k]);
+}
+
+/* Sort du bloc avant l'instruction <k> si l'accès 16 bits à <addr> n'est pas rapide */
+static void guard(FILE *o, const block_t *b, int k, const char *pages, const char *addr)
+{
+    fprintf(o, "        if (llmp16_aot_slow(vm->%s, %s)) ", pages, addr);
+    exit_before(o, b, k);
+}
+
+static void set_reg(FILE *o, unsigned X, const char *expr)
+{
+    if (X < 8) fprintf(o, "        vm->R[%u] = (uint16_t)(%s);\n", X, expr);
+    else       fprintf(o, "        vm->R[%u] = %s;\n", X, expr);
+}
+
+static void emit_alu(FILE *o, const instr_t *in)
+{
+    unsigned X = in->X, Y = in->Y;
+    char b[32];
+    bool imm = in->op_class == 0x2 || in->op_class == 0x4;
+    if (imm) snprintf(b, sizeof(b), "0x%04X", in->imm);
+    else     snprintf(b, sizeof(b), "(uint16_t)vm->R[%u]", Y);
+
+    if (in->op_class == 0x1 || in->op_class == 0x2) {
+        switch (in->t) {
+        case 0x0:   /* ADD, ADDI */
+            fprintf(o, "        uint16_t a = (uint16_t)vm->R[%u], b = %s;\n", X, b);
+            fprintf(o, "        uint32_t r = (uint32_t)a + b;\n");
+            fprintf(o, "        vm->R[%u] = (uint16_t)r;\n", ACC_REG);
+            fprintf(o, "        flag_nz(vm, (uint16_t)r);\n        flag_add_cv(vm, a, b, r);\n");
+            return;
+        case 0x1:   /* SUB, SUBI */
+            fprintf(o, "        uint16_t a = (uint16_t)vm->R[%u], b = %s;\n", X, b);
+            fprintf(o, "        uint32_t r = (uint32_t)a - b + 0x10000;\n");
+            fprintf(o, "        vm->R[%u] = (uint16_t)r;\n", ACC_REG);
+            fprintf(o, "        flag_nz(vm, (uint16_t)r);\n        flag_sub_cv(vm, a, b, r);\n");
+            return;
+        case 0x2:   /* MUL, MULI : seul MUL efface C et V */
+            fprintf(o, "        uint16_t r = (uint16_t)((uint32_t)vm->R[%u] * %s);\n", X, b);
+            fprintf(o, "        vm->R[%u] = r;\n        flag_nz(vm, r);\n", ACC_REG);
+            if (!imm) fprintf(o, "        flag_set(vm, FLAG_C | FLAG_V, false);\n");
+            return;
+        case 0x3:   /* DIV, DIVI : diviseur nul, sans effet */
+            if (imm && in->imm == 0) return;
+            fprintf(o, "        uint16_t d = %s;\n", b);
+            fprintf(o, "        if (d != 0) {\n");
+            fprintf(o, "            uint16_t r = (uint16_t)vm->R[%u] / d;\n", X);
+            fprintf(o, "            vm->R[%u] = r;\n            flag_nz(vm, r);\n        }\n", ACC_REG);
+            return;
+        case 0x4:   /* SDIV, SDIVI */
+            if (imm && in->imm == 0) return;
+            fprintf(o, "        int16_t d = (int16_t)%s;\n", b);
+            fprintf(o, "        if (d != 0) {\n");
+            fprintf(o, "            uint16_t r = (uint16_t)((int16_t)vm->R[%u] / d);\n", X);
+            fprintf(o, "            vm->R[%u] = r;\n            flag_nz(vm, r);\n        }\n", ACC_REG);
+            return;
+        case 0xB:   /* MULH */
+            fprintf(o, "        uint16_t r = (uint16_t)(((uint32_t)(uint16_t)vm->R[%u] * %s) >> 16);\n", X, b);
+            fprintf(o, "        vm->R[%u] = r;\n        flag_nz(vm, r);\n", ACC_REG);
+            fprintf(o, "        flag_set(vm, FLAG_C | FLAG_V, false);\n");
+            return;
+        case 0x5:   /* INC, DEC : toute la largeur du registre */
+        case 0x6:
+            if (imm) return;
+            fprintf(o, "        uint32_t r = vm->R[%u] %s 1;\n", X, in->t == 0x5 ? "+" : "-");
+            set_reg(o, X, "r");
+            fprintf(o, X >= 8 ? "        flag_nz32(vm, r);\n" : "        flag_nz(vm, (uint16_t)r);\n");
+            return;
+        case 0x7:   /* CMP, CMPI */
+            fprintf(o, "        uint16_t a = (uint16_t)vm->R[%u], b = %s;\n", X, b);
+            fprintf(o, "        uint32_t r = (uint32_t)a - b + 0x10000;\n");
+            fprintf(o, "        flag_nz(vm, (uint16_t)r);\n        flag_sub_cv(vm, a, b, r);\n");
+            return;
+        case 0x8:   /* LSR */
+        case 0x9:   /* ASR */
+        case 0xA:   /* LSL */
+            if (imm) {  // LSRI ASRI LSLI : flags N Z seulement
+                const char *expr = in->t == 0x8 ? "(uint16_t)vm->R[%u] >> %u"
+                                 : in->t == 0x9 ? "(uint16_t)((int16_t)vm->R[%u] >> %u)"
+                                 :                "(uint16_t)(vm->R[%u] << %u)";
+                fprintf(o, "        uint16_t r = ");
+                fprintf(o, expr, X, in->imm & 0xF);
+                fprintf(o, ";\n");
+            } else {
+                fprintf(o, "        uint8_t s = vm->R[%u] & 0xF;\n", Y);
+                if (in->t == 0x9) {
+                    fprintf(o, "        int16_t v = (int16_t)vm->R[%u];\n", X);
+                    fprintf(o, "        uint16_t r = (uint16_t)(int16_t)(v >> s);\n");
+                    fprintf(o, "        flag_set(vm, FLAG_C, s && (((uint16_t)v >> (s - 1)) & 0x1));\n");
+                } else if (in->t == 0x8) {
+                    fprintf(o, "        uint16_t v = (uint16_t)vm->R[%u];\n", X);
+                    fprintf(o, "        uint16_t r = v >> s;\n");
+                    fprintf(o, "        flag_set(vm, FLAG_C, s && ((v >> (s - 1)) & 0x1));\n");
+                } else {
+                    fprintf(o, "        uint16_t v = (uint16_t)vm->R[%u];\n", X);
+                    fprintf(o, "        uint16_t r = v << s;\n");
+                    fprintf(o, "        flag_set(vm, FLAG_C, (v >> (16 - s)) & 0x1);\n");
+                }
+            }
+            set_reg(o, X, "r");
+            fprintf(o, "        flag_nz(vm, r);\n");
+            return;
+        default:
+            return;
+        }
+    }
+
+    // 0x3, 0x4 : AND OR XOR NOT TST, ANDI ORI XORI TSTI
+    static const char *ops[] = { "&", "|", "^" };
+    if (in->t <= 0x2 || (in->op_class == 0x3 && in->t == 0x4) || (in->op_class == 0x4 && in->t == 0x3)) {
+        const char *op = in->t <= 0x2 ? ops[in->t] : "&";
+        fprintf(o, "        uint16_t r = (uint16_t)(vm->R[%u] %s %s);\n", X, op, b);
+    } else {    /* NOT */
+        fprintf(o, "        uint16_t r = (uint16_t)~vm->R[%u];\n", X);
+    }
+    if (!((in->op_class == 0x3 && in->t == 0x4) || (in->op_class == 0x4 && in->t == 0x3)))
+        fprintf(o, "        vm->R[%u] = r;\n", ACC_REG);
+    fprintf(o, "        flag_nz(vm, r);\n");
+}
+
+/* ALU 32 bits (0xC registre, 0xD imm20) : même sémantique que alu32() dans llmp16_decoder.c */
+static void emit_alu32(FILE *o, const instr_t *in)
+{
+    unsigned X = in->X;
+    bool imm = in->op_class == 0xD;
+    char b[32];
+    if (imm) snprintf(b, sizeof(b), "0x%05Xu", ((uint32_t)in->Y << 16) | in->imm);
+    else     snprintf(b, sizeof(b), "vm->R[%u]", in->Y);
+
+    fprintf(o, "        uint32_t a = vm->R[%u], b = %s;\n", X, b);
+    switch (in->t) {
+    case 0x0:   /* ADDL */
+        fprintf(o, "        uint64_t r = (uint64_t)a + b;\n");
+        fprintf(o, "        vm->R[%u] = (uint32_t)r;\n", ACC_REG);
+        fprintf(o, "        flag_nz32(vm, (uint32_t)r);\n        flag_add_cv32(vm, a, b, r);\n");
+        return;
+    case 0x1:   /* SUBL */
+    case 0x7:   /* CMPL */
+        fprintf(o, "        uint64_t r = (uint64_t)a - b + 0x100000000ull;\n");
+        if (in->t == 0x1) fprintf(o, "        vm->R[%u] = (uint32_t)r;\n", ACC_REG);
+        fprintf(o, "        flag_nz32(vm, (uint32_t)r);\n        flag_sub_cv32(vm, a, b, r);\n");
+        return;
+    case 0x2:   /* MULL, MULHL : C et V effacés */
+    case 0xB:
+        if (in->t == 0x2) fprintf(o, "        uint32_t r = a * b;\n");
+        else              fprintf(o, "        uint32_t r = (uint32_t)(((uint64_t)a * b) >> 32);\n");
+        fprintf(o, "        vm->R[%u] = r;\n        flag_nz32(vm, r);\n", ACC_REG);
+        fprintf(o, "        flag_set(vm, FLAG_C | FLAG_V, false);\n");
+        return;
+    case 0x3:   /* DIVL, SDIVL : diviseur nul, sans effet */
+    case 0x4:
+        fprintf(o, "        if (b != 0) {\n");
+        if (in->t == 0x3) fprintf(o, "            uint32_t r = a / b;\n");
+        else fprintf(o, "            uint32_t r = b == 0xFFFFFFFFu ? 0u - a : (uint32_t)((int32_t)a / (int32_t)b);\n");
+        fprintf(o, "            vm->R[%u] = r;\n            flag_nz32(vm, r);\n        }\n", ACC_REG);
+        return;
+    case 0x8:   /* LSRL, ASRL, LSLL : C seulement pour la forme registre */
+    case 0x9:
+    case 0xA:
+        fprintf(o, "        uint8_t s = b & 0x1F;\n");
+        fprintf(o, "        uint32_t r = %s;\n", in->t == 0x8 ? "a >> s" : in->t == 0x9 ? "(uint32_t)((int32_t)a >> s)" : "a << s");
+        if (!imm)
+            fprintf(o, "        flag_set(vm, FLAG_C, s && (%s & 1));\n", in->t == 0xA ? "(a >> (32 - s))" : "(a >> (s - 1))");
+        set_reg(o, X, "r");
+        fprintf(o, "        flag_nz32(vm, r);\n");
+        return;
+    default:    /* ANDL ORL XORL */
+        fprintf(o, "        uint32_t r = a %s b;\n", in->t == 0xC ? "&" : in->t == 0xD ? "|" : "^");
+        fprintf(o, "        vm->R[%u] = r;\n        flag_nz32(vm, r);\n", ACC_REG);
+        return;
+    }
+}
+
+static void emit_mem(FILE *o, const block_t *b, int k)
+{
+    const instr_t *in = &b->in[k];
+    unsigned X = in->X, Y = in->Y;
+    char addr[64];
+
+    if (in->op_class == 0x5) {
+        switch (in->t) {
+        case 0x0:   /* MOV */
+            snprintf(addr, sizeof(addr), "vm->R[%u]", Y);
+            set_reg(o, X, addr);
+            return;
+        case 0x1:   /* LD RX <- MEM[RY] */
+            fprintf(o, "        uint32_t a = vm->R[%u];\n", Y);
+            guard(o, b, k, "rd_page", "a");
+            set_reg(o, X, "mem_read16(vm, a)");
+            return;
+        case 0x2:   /* STR MEM[RX] <- RY */
+            fprintf(o, "        uint32_t a = vm->R[%u];\n", X);
+            guard(o, b, k, "wr_page", "a");
+            fprintf(o, "        mem_write16(vm, a, (uint16_t)vm->R[%u]);\n", Y);
+            return;
+        case 0x3:   /* PUSH RX : SP décrémenté d'abord */
+            fprintf(o, "        uint32_t sp = vm->R[SP] - 2;\n");
+            guard(o, b, k, "wr_page", "sp");
+            fprintf(o, "        vm->R[SP] = sp;\n");
+            fprintf(o, "        mem_write16(vm, sp, (uint16_t)vm->R[%u]);\n", X);
+            return;
+        case 0x4:   /* POP RX : SP relu après l'écriture de RX */
+            guard(o, b, k, "rd_page", "vm->R[SP]");
+            set_reg(o, X, "mem_read16(vm, vm->R[SP])");
+            fprintf(o, "        vm->R[SP] += 2;\n");
+            return;
+        case 0x5:   /* VLD */
+            snprintf(addr, sizeof(addr), "vram_read(vm, (uint16_t)vm->R[%u])", Y);
+            set_reg(o, X, addr);
+            return;
+        case 0x6:   /* VSTR */
+            fprintf(o, "        vram_write(vm, (uint16_t)vm->R[%u], (uint8_t)vm->R[%u]);\n", X, Y);
+            return;
+        case 0x7:   /* VLDW : octet bas lu d'abord */
+            fprintf(o, "        uint16_t a = (uint16_t)vm->R[%u];\n", Y);
+            fprintf(o, "        uint8_t lo = vram_read(vm, a);\n");
+            set_reg(o, X, "lo | vram_read(vm, (uint16_t)(a + 1)) << 8");
+            return;
+        case 0x8:   /* VSTRW */
+            fprintf(o, "        uint16_t a = (uint16_t)vm->R[%u], v = (uint16_t)vm->R[%u];\n", X, Y);
+            fprintf(o, "        vram_write(vm, a, (uint8_t)v);\n");
+            fprintf(o, "        vram_write(vm, (uint16_t)(a + 1), (uint8_t)(v >> 8));\n");
+            return;
+        default:
+            return;
+        }
+    }
+
+    switch (in->t) {
+    case 0x0:   /* MOVI : le nibble Y donne les bits 19..16 */
+        snprintf(addr, sizeof(addr), "0x%05Xu", ((uint32_t)in->Y << 16) | in->imm);
+        set_reg(o, X, addr);
+        return;
+    case 0x1:   /* LDI */
+        snprintf(addr, sizeof(addr), "0x%05Xu", in->addr);
+        guard(o, b, k, "rd_page", addr);
+        snprintf(addr, sizeof(addr), "mem_read16(vm, 0x%05Xu)", in->addr);
+        set_reg(o, X, addr);
+        return;
+    case 0x2:   /* STRI */
+        snprintf(addr, sizeof(addr), "0x%05Xu", in->addr);
+        guard(o, b, k, "wr_page", addr);
+        fprintf(o, "        mem_write16(vm, 0x%05Xu, (uint16_t)vm->R[%u]);\n", in->addr, X);
+        return;
+    case 0x3:   /* PUSHI */
+        fprintf(o, "        uint32_t sp = vm->R[SP] - 2;\n");
+        guard(o, b, k, "wr_page", "sp");
+        fprintf(o, "        vm->R[SP] = sp;\n");
+        fprintf(o, "        mem_write16(vm, sp, 0x%04X);\n", in->imm);
+        return;
+    case 0x5:   /* VLDI */
+        snprintf(addr, sizeof(addr), "vram_read(vm, 0x%04X)", in->imm);
+        set_reg(o, X, addr);
+        return;
+    case 0x6:   /* VSTRI */
+        fprintf(o, "        vram_write(vm, 0x%04X, (uint8_t)vm->R[%u]);\n", in->imm, X);
+        return;
+    default:
+        return;
+    }
+}
+
+/* Dernière instruction : saut, HALT ou fin de bloc ; écrit la sortie du bloc */
+static void emit_exit(FILE *o, const block_t *b)
+{
+    int k = b->n - 1;
+    const instr_t *in = &b->in[k];
+    uint32_t next = b->at[b->n], cycles = b->cycles[b->n];
+    const char *n = b->loops ? "n + " : "";
+    const char *c = b->loops ? "cycles + " : "";
+
+    if (in->op_class == 0x8 && in->t <= 0xD) {
+        uint32_t taken = cycles + (in->addr != next ? LLMP_CYC_BRANCH_TAKEN : 0);
+        if (in->t == 0xD) {  /* CALL : empile les 16 bits bas du PC de retour */
+            fprintf(o, "        uint32_t sp = vm->R[SP] - 2;\n");
+            guard(o, b, k, "wr_page", "sp");
+            fprintf(o, "        vm->R[SP] = sp;\n");
+            fprintf(o, "        mem_write16(vm, sp, 0x%04X);\n", next & 0xFFFF);
+        }
+        if (in->t == 0x0 || in->t == 0xD) {
+            fprintf(o, "        vm->R[PC] = 0x%05X;\n        *count = %s%d;\n        return %s%u;\n",
+                    in->addr, n, b->n, c, taken);
+            return;
+        }
+        fprintf(o, "        if (llmp16_cond(vm, 0x%X)) {\n", in->t);
+        if (b->loops) {
+            fprintf(o, "            n += %d;\n            cycles += %u;\n", b->n, taken);
+            fprintf(o, "            if (n + %d <= max_instr && (uint64_t)cycles + %u <= slack) goto top;\n",
+                    b->n, b->cycles[k]);
+            fprintf(o, "            vm->R[PC] = 0x%05X;\n            *count = n;\n            return cycles;\n", in->addr);
+        } else {
+            fprintf(o, "            vm->R[PC] = 0x%05X;\n            *count = %d;\n            return %u;\n",
+                    in->addr, b->n, taken);
+        }
+        fprintf(o, "        }\n");
+        fprintf(o, "        vm->R[PC] = 0x%05X;\n        *count = %s%d;\n        return %s%u;\n",
+                next, n, b->n, c, cycles);
+        return;
+    }
+
+    if (in->op_class == 0x7 && in->t <= 0xD) {
+        fprintf(o, "        vm->R[PC] = 0x%05X;\n", next);
+        if (in->t == 0xD) {  /* RET : POP PC */
+            guard(o, b, k, "rd_page", "vm->R[SP]");
+            fprintf(o, "        uint32_t sp = vm->R[SP];\n");
+            fprintf(o, "        vm->R[PC] = mem_read16(vm, sp);\n        vm->R[SP] = sp + 2;\n");
+        } else if (in->t == 0x0) {
+            fprintf(o, "        vm->R[PC] = vm->R[%u];\n", in->X);
+        } else {
+            fprintf(o, "        if (llmp16_cond(vm, 0x%X)) vm->R[PC] = vm->R[%u];\n", in->t, in->X);
+        }
+        fprintf(o, "        *count = %s%d;\n        return %s%u + (vm->R[PC] != 0x%05X ? LLMP_CYC_BRANCH_TAKEN : 0);\n",
+                n, b->n, c, cycles, next);
+        return;
+    }
+
+    if (in->raw == 0x0001) {    /* HALT : PC reste sur l'instruction */
+        fprintf(o, "        vm->R[PC] = 0x%05X;\n        vm->cpu_halted = true;\n", b->at[k]);
+    }
+    const char *extra = in->op_class == 0xB && llmp16_instr_valid(in) ? " + extra" : "";
+    fprintf(o, "        *count = %s%d;\n        return %s%u%s;\n", n, b->n, c, cycles, extra);
+}
+
+static void emit_block(FILE *o, const block_t *b)
+{
+    char text[64];
+
+    fprintf(o, "static uint32_t b_%05X(llmp16_t *vm, uint32_t max_instr, uint64_t slack, uint32_t *count)\n{\n",
+            b->at[0]);
+    if (b->loops) fprintf(o, "    uint32_t n = 0, cycles = 0;\ntop:\n");
+    else          fprintf(o, "    (void)max_instr;\n    (void)slack;\n");
+
+    for (int k = 0; k < b->n; k++) {
+        const instr_t *in = &b->in[k];
+        bool last = k == b->n - 1;
+        llmp16_disasm(in, text, sizeof(text));
+        fprintf(o, "    {   /* 0x%05X  %s */\n", b->at[k], text);
+
+        // PC n'est observable que par un opérande PC et à la sortie du bloc
+        bool jump = is_jump(in) || in->raw == 0x0001;
+        if (!jump && (in->X == PC_REG || in->Y == PC_REG || last))
+            fprintf(o, "        vm->R[PC] = 0x%05X;\n", b->at[k + 1]);
+
+        if (!llmp16_instr_valid(in)) {
+            fprintf(o, "        /* opcode non défini : sans effet */\n");
+        } else {
+            switch (in->op_class) {
+            case 0x1: case 0x2: case 0x3: case 0x4:
+                emit_alu(o, in);
+                break;
+            case 0x5: case 0x6:
+                emit_mem(o, b, k);
+                break;
+            case 0xC: case 0xD:
+                emit_alu32(o, in);
+                break;
+            case 0xE:   /* deux octets : t est constant, le compilateur déplie llmp16_lane8 */
+                if (in->t == 0x5)
+                    fprintf(o, "        uint16_t r = llmp16_shuffle((uint16_t)vm->R[%u], (uint16_t)vm->R[%u], %u);\n",
+                            in->X, ACC_REG, in->Y);
+                else
+                    fprintf(o, "        uint16_t r = llmp16_packed(%u, (uint16_t)vm->R[%u], (uint16_t)vm->R[%u]);\n",
+                            in->t, in->X, in->Y);
+                fprintf(o, "        vm->R[%u] = r;\n        flag_nz(vm, r);\n", ACC_REG);
+                break;
+            case 0x9:   /* IN, en tête de bloc : compteurs à jour */
+                snprintf(text, sizeof(text), "llmp16_io_read(vm, %u, %u)", in->Y, in->t);
+                set_reg(o, in->X, text);
+                break;
+            case 0xA:   /* OUT : termine le bloc, le périphérique démarre avant la suite */
+                fprintf(o, "        llmp16_io_write(vm, %u, %u, (uint16_t)vm->R[%u]);\n", in->Y, in->t, in->X);
+                break;
+            case 0xB:   /* MCPY MFIL VFIL MCMP : seules dans leur bloc, coût par octet en plus */
+                fprintf(o, "        uint32_t extra = execute(vm, llmp16_decode_raw(0x%04X, 0));\n", in->raw);
+                break;
+            default:    /* NOP, INT sans debugger ; sauts et HALT à la sortie */
+                break;
+            }
+        }
+        if (last) emit_exit(o, b);
+        fprintf(o, "    }\n");
+    }
+    fprintf(o, "}\n\n");
+}
+
+static const char *base_name(const char *path)
+{
+    const char *base = strrchr(path, '/');
+    return base ? base + 1 : path;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *rom_path = NULL, *out_path = NULL;
+    static aot_t aot;
+    static block_t block;
+    uint32_t entry[64];
+    int nb_entries = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) out_path = argv[++i];
+        else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc && nb_entries < 64)
+            entry[nb_entries++] = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else rom_path = argv[i];
+    }
+    if (rom_path == NULL) {
+        fprintf(stderr, "Usage : %s rom.bin [-o sortie.c] [-e adresse]...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *f = fopen(rom_path, "rb");
+    if (f == NULL) {
+        perror("ROM open error");
+        return EXIT_FAILURE;
+    }
+    aot.size = (uint32_t)fread(aot.rom, 1, LLMP_ROM_SIZE, f);
+    fclose(f);
+    if (aot.size < 2) {
+        fprintf(stderr, "%s : image vide\n", rom_path);
+        return EXIT_FAILURE;
+    }
+
+    add_leader(&aot, 0);
+    for (int i = 0; i < nb_entries; i++) add_leader(&aot, entry[i]);
+
+    for (uint32_t i = 0; i < aot.queued; i++) {
+        if (scan_block(&aot, aot.queue[i], &block)) follow(&aot, &block);
+    }
+
+    FILE *o = out_path ? fopen(out_path, "w") : stdout;
+    if (o == NULL) {
+        perror("AOT output error");
+        return EXIT_FAILURE;
+    }
+
+    fprintf(o, "/* Généré par llmp16_aot à partir de %s : ne pas modifier */\n", base_name(rom_path));
+    fprintf(o, "#include \"llmp16.h\"\n#include \"llmp16_aot.h\"\n\n");
+
+    uint32_t nb_blocks = 0, nb_instr = 0;
+    for (uint32_t addr = 0; addr < aot.size; addr += 2) {
+        if (!aot.leader[addr >> 1] || !scan_block(&aot, addr, &block)) continue;
+        emit_block(o, &block);
+        nb_blocks++;
+        nb_instr += (uint32_t)block.n;
+    }
+
+    fprintf(o, "static const llmp16_aot_block_t blocks[] = {\n");
+    for (uint32_t addr = 0; addr < aot.size; addr += 2) {
+        if (!aot.leader[addr >> 1] || !scan_block(&aot, addr, &block)) continue;
+        fprintf(o, "    { 0x%05X, %d, %u, b_%05X },\n", addr, block.n, block.cycles[block.n - 1], addr);
+    }
+    fprintf(o, "};\n\n");
+
+    fprintf(o, "static const uint8_t rom[%u] = {", aot.size);
+    for (uint32_t i = 0; i < aot.size; i++)
+        fprintf(o, "%s0x%02X,", i % 16 ? " " : "\n    ", aot.rom[i]);
+    fprintf(o, "\n};\n\n");
+
+    fprintf(o, "const llmp16_aot_image_t llmp16_aot_image = { \"%s\", rom, %u, %u, blocks };\n",
+            base_name(rom_path), aot.size, nb_blocks);
+
+    if (o != stdout) fclose(o);
+    fprintf(stderr, "llmp16_aot : %s, %u blocs, %u instructions traduites\n", base_name(rom_path), nb_blocks, nb_instr);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,492 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "llmp16.h"
+#include "llmp16_asset.h"
+
+/*
+ * Convertisseur d'images PPM (P3 ou P6) en paquet d'assets LLMP16 (voir llmp16_asset.h)
+ * Usage : llmp16_asset [-o paquet.bin] [-r rom.bin [-b <adresse>]] [-d] <nom>=<image.ppm>[:<mode>] ...
+ *   :rgb      pixels RGB332 (défaut) ; -d active un tramage ordonné 4x4
+ *   :pal<N>   image réduite à N couleurs RGB332 (coupe médiane), la palette suit les pixels
+ *   :glyphs   cellules 8x8 en 1 bpp (seuil de luminance) pour le blitter en mode bit
+ *   -r        écrit aussi le paquet dans la ROM <rom.bin>, à l'adresse -b (défaut 0x4000)
+ * Une ligne JSON par asset : type, dimensions, offset, taille et temps de conversion.
+ *
+ * Les images sont converties en plans R, G, B séparés et traitées par blocs de BLOCK pixels : les
+ * boucles internes de longueur fixe et sans dépendance sont vectorisées par le compilateur.
+ */
+
+#define BLOCK        32
+#define HIST_SIZE    32768              /* couleurs 5-5-5 */
+#define ROM_BASE     0x4000
+#define MAX_ASSETS   256
+
+typedef struct {
+    uint32_t w, h, n;                   /* n = w * h arrondi à BLOCK */
+    uint8_t *r, *g, *b;
+} image_t;
+
+typedef struct {
+    llmp16_asset_entry_t entry;
+    uint8_t *data;
+} asset_t;
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+/*============================== Lecture PPM ==============================*/
+
+/* Entier suivant de l'en-tête (ou des pixels en P3), commentaires sautés ; -1 en fin de fichier */
+static long ppm_int(FILE *f)
+{
+    int c;
+    for (;;) {
+        c = fgetc(f);
+        if (c == '#') while (c != '\n' && c != EOF) c = fgetc(f);
+        if (c == EOF || isdigit(c)) break;
+        if (!isspace(c)) return -1;
+    }
+    if (c == EOF) return -1;
+    long v = 0;
+    while (isdigit(c)) {
+        v = v * 10 + (c - '0');
+        if (v > 65535) return -1;
+        c = fgetc(f);
+    }
+    return v;
+}
+
+static int ppm_read(const char *path, image_t *img)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        perror("PPM open error");
+        return -1;
+    }
+    char magic[2];
+    long w = -1, h = -1, max = -1;
+    if (fread(magic, 1, 2, f) == 2 && magic[0] == 'P' && (magic[1] == '3' || magic[1] == '6')) {
+        w = ppm_int(f);
+        h = ppm_int(f);
+        max = ppm_int(f);
+    }
+    if (w <= 0 || h <= 0 || max <= 0 || max > 255) {
+        fprintf(stderr, "PPM : %s n'est pas une image P3/P6 8 bits\n", path);
+        fclose(f);
+        return -1;
+    }
+
+    img->w = (uint32_t)w;
+    img->h = (uint32_t)h;
+    img->n = (img->w * img->h + BLOCK - 1) / BLOCK * BLOCK;
+    img->r = (uint8_t *)calloc(3, img->n);
+    if (img->r == NULL) {
+        perror("PPM alloc error");
+        fclose(f);
+        return -1;
+    }
+    img->g = img->r + img->n;
+    img->b = img->g + img->n;
+
+    // P6 : un octet blanc après maxval, puis les triplets binaires
+    bool ok = true;
+    uint8_t rgb[3];
+    for (uint32_t i = 0; ok && i < img->w * img->h; i++) {
+        if (magic[1] == '6') {
+            ok = fread(rgb, 1, 3, f) == 3;
+        } else {
+            for (int c = 0; ok && c < 3; c++) {
+                long v = ppm_int(f);
+                ok = v >= 0 && v <= max;
+                rgb[c] = (uint8_t)v;
+            }
+        }
+        img->r[i] = (uint8_t)(rgb[0] * 255 / max);
+        img->g[i] = (uint8_t)(rgb[1] * 255 / max);
+        img->b[i] = (uint8_t)(rgb[2] * 255 / max);
+    }
+    fclose(f);
+    if (!ok) {
+        fprintf(stderr, "PPM : %s est tronquée\n", path);
+        free(img->r);
+        return -1;
+    }
+    return 0;
+}
+
+
+/*============================== Conversions ==============================*/
+
+/* RGB332 : chaque composante ramenée à 8, 8 ou 4 niveaux avec le seuil <d> (128 = arrondi) */
+static int quantize_rgb332(const image_t *img, bool dither, uint8_t *out)
+{
+    static const uint8_t bayer[4][4] = { { 0, 8, 2, 10 }, { 12, 4, 14, 6 }, { 3, 11, 1, 9 }, { 15, 7, 13, 5 } };
+    uint8_t *thr = (uint8_t *)malloc(img->n);
+    if (thr == NULL) {
+        perror("Quantize alloc error");
+        return -1;
+    }
+    for (uint32_t i = 0; i < img->n; i++) {
+        uint32_t x = i % img->w, y = i / img->w;
+        thr[i] = dither ? (uint8_t)(bayer[y & 3][x & 3] * 16 + 8) : 128;
+    }
+
+    for (uint32_t i = 0; i < img->n; i += BLOCK) {
+        const uint8_t *r = img->r + i, *g = img->g + i, *b = img->b + i, *d = thr + i;
+        uint8_t *o = out + i;
+        for (int k = 0; k < BLOCK; k++) {
+            uint32_t q_r = (r[k] * 7u + d[k]) / 255, q_g = (g[k] * 7u + d[k]) / 255, q_b = (b[k] * 3u + d[k]) / 255;
+            o[k] = (uint8_t)(q_r << 5 | q_g << 2 | q_b);
+        }
+    }
+    free(thr);
+    return 0;
+}
+
+typedef struct {
+    uint32_t first, count;              /* couleurs de la boîte dans le tableau trié */
+    uint64_t weight;                    /* pixels de la boîte */
+} box_t;
+
+static uint16_t *sort_colors;           /* couleurs 5-5-5 présentes */
+static const uint32_t *sort_hist;
+static int sort_shift;
+
+static int cmp_channel(const void *a, const void *b)
+{
+    int ca = (*(const uint16_t *)a >> sort_shift) & 31, cb = (*(const uint16_t *)b >> sort_shift) & 31;
+    return ca - cb;
+}
+
+/* Composante la plus étendue de la boîte : décalage 10 (R), 5 (G) ou 0 (B), étendue dans <range> */
+static int widest_channel(const box_t *box, int *range)
+{
+    int best = 0, shift = 0;
+    for (int s = 0; s <= 10; s += 5) {
+        int lo = 31, hi = 0;
+        for (uint32_t i = box->first; i < box->first + box->count; i++) {
+            int c = (sort_colors[i] >> s) & 31;
+            if (c < lo) lo = c;
+            if (c > hi) hi = c;
+        }
+        if (hi - lo >= best) best = hi - lo, shift = s;
+    }
+    *range = best;
+    return shift;
+}
+
+/* Palette de <colors> couleurs RGB332 par coupe médiane, pixels remplacés par la plus proche.
+   Rend le nombre de couleurs distinctes, écrites en <palette>, ou -1 sans mémoire. */
+static int quantize_palette(const image_t *img, int colors, uint8_t *out, uint8_t *palette)
+{
+    uint32_t *hist = (uint32_t *)calloc(HIST_SIZE, sizeof(uint32_t));
+    uint16_t *key = (uint16_t *)malloc(img->n * sizeof(uint16_t));
+    sort_colors = (uint16_t *)malloc(HIST_SIZE * sizeof(uint16_t));
+    uint8_t *cr = (uint8_t *)malloc(3 * HIST_SIZE);
+    int32_t *best = (int32_t *)malloc(HIST_SIZE * sizeof(int32_t));
+    uint8_t *map = (uint8_t *)calloc(HIST_SIZE, 1);
+    int count = -1;
+    if (hist == NULL || key == NULL || sort_colors == NULL || cr == NULL || best == NULL || map == NULL) {
+        perror("Quantize alloc error");
+        goto done;
+    }
+
+    for (uint32_t i = 0; i < img->n; i += BLOCK) {
+        const uint8_t *r = img->r + i, *g = img->g + i, *b = img->b + i;
+        uint16_t *o = key + i;
+        for (int k = 0; k < BLOCK; k++) o[k] = (uint16_t)((r[k] >> 3) << 10 | (g[k] >> 3) << 5 | b[k] >> 3);
+    }
+    for (uint32_t i = 0; i < img->w * img->h; i++) hist[key[i]]++;
+
+    uint32_t present = 0;
+    for (uint32_t c = 0; c < HIST_SIZE; c++)
+        if (hist[c]) sort_colors[present++] = (uint16_t)c;
+    sort_hist = hist;
+
+    // coupe la boîte la plus lourde le long de sa composante la plus étendue, à la médiane
+    box_t boxes[256] = { { 0, present, (uint64_t)img->w * img->h } };
+    int nb = 1;
+    while (nb < colors) {
+        int pick = -1, range = 0, shift = 0;
+        for (int i = 0; i < nb; i++) {
+            int rg, s = widest_channel(&boxes[i], &rg);
+            if (rg > 0 && (pick < 0 || boxes[i].weight > boxes[pick].weight)) pick = i, range = rg, shift = s;
+        }
+        if (pick < 0 || range == 0) break;
+        box_t *box = &boxes[pick];
+        sort_shift = shift;
+        qsort(sort_colors + box->first, box->count, sizeof(uint16_t), cmp_channel);
+        uint64_t half = 0;
+        uint32_t cut = box->first;
+        while (cut < box->first + box->count - 1 && (half + sort_hist[sort_colors[cut]]) * 2 <= box->weight)
+            half += sort_hist[sort_colors[cut++]];
+        if (cut == box->first) half += sort_hist[sort_colors[cut++]];
+        boxes[nb] = (box_t){ cut, box->first + box->count - cut, box->weight - half };
+        box->count = cut - box->first;
+        box->weight = half;
+        nb++;
+    }
+
+    // moyenne pondérée de chaque boîte, arrondie en RGB332 ; les doublons sont retirés
+    count = 0;
+    uint8_t pr[256], pg[256], pb[256];
+    for (int i = 0; i < nb; i++) {
+        uint64_t sr = 0, sg = 0, sb = 0, w = 0;
+        for (uint32_t j = boxes[i].first; j < boxes[i].first + boxes[i].count; j++) {
+            uint16_t c = sort_colors[j];
+            sr += (uint64_t)hist[c] * ((c >> 10) * 255 / 31);
+            sg += (uint64_t)hist[c] * (((c >> 5) & 31) * 255 / 31);
+            sb += (uint64_t)hist[c] * ((c & 31) * 255 / 31);
+            w += hist[c];
+        }
+        if (w == 0) continue;
+        uint8_t p = (uint8_t)(((sr / w * 7 + 127) / 255) << 5 | ((sg / w * 7 + 127) / 255) << 2 | ((sb / w * 3 + 127) / 255));
+        bool dup = false;
+        for (int k = 0; k < count; k++) dup |= palette[k] == p;
+        if (dup) continue;
+        palette[count] = p;
+        pr[count] = (uint8_t)((p >> 5) * 255 / 7);
+        pg[count] = (uint8_t)(((p >> 2) & 7) * 255 / 7);
+        pb[count] = (uint8_t)((p & 3) * 255 / 3);
+        count++;
+    }
+
+    // couleur la plus proche pour les 32768 entrées 5-5-5 : une palette à la fois, toutes les
+    // entrées dans la boucle interne (vectorisée)
+    uint8_t *cg = cr + HIST_SIZE, *cb = cg + HIST_SIZE;
+    for (uint32_t c = 0; c < HIST_SIZE; c++) {
+        cr[c] = (uint8_t)((c >> 10) * 255 / 31);
+        cg[c] = (uint8_t)(((c >> 5) & 31) * 255 / 31);
+        cb[c] = (uint8_t)((c & 31) * 255 / 31);
+        best[c] = INT32_MAX;
+    }
+    for (int k = 0; k < count; k++) {
+        const int32_t r = pr[k], g = pg[k], b = pb[k];
+        const uint8_t p = palette[k];
+        for (uint32_t c = 0; c < HIST_SIZE; c++) {
+            int32_t dr = cr[c] - r, dg = cg[c] - g, db = cb[c] - b;
+            int32_t d = 2 * dr * dr + 4 * dg * dg + 3 * db * db;
+            bool closer = d < best[c];
+            best[c] = closer ? d : best[c];
+            map[c] = closer ? p : map[c];
+        }
+    }
+    for (uint32_t i = 0; i < img->w * img->h; i++) out[i] = map[key[i]];
+
+done:
+    free(cr);
+    free(best);
+    free(map);
+    free(sort_colors);
+    free(key);
+    free(hist);
+    return count;
+}
+
+/* Cellules 8x8 en 1 bpp : pixel allumé si sa luminance atteint la moitié ; taille dans <size> */
+static int quantize_glyphs(const image_t *img, uint8_t *out, uint32_t *size)
+{
+    uint8_t *on = (uint8_t *)malloc(img->n);
+    if (on == NULL) {
+        perror("Quantize alloc error");
+        return -1;
+    }
+    for (uint32_t i = 0; i < img->n; i += BLOCK) {
+        const uint8_t *r = img->r + i, *g = img->g + i, *b = img->b + i;
+        uint8_t *o = on + i;
+        for (int k = 0; k < BLOCK; k++) o[k] = (uint8_t)((r[k] * 77u + g[k] * 150u + b[k] * 29u) >> 15);
+    }
+
+    uint32_t cells = 0;
+    for (uint32_t cy = 0; cy + 8 <= img->h; cy += 8)
+        for (uint32_t cx = 0; cx + 8 <= img->w; cx += 8, cells++)
+            for (int row = 0; row < 8; row++) {
+                const uint8_t *p = on + (cy + row) * img->w + cx;
+                uint8_t bits = 0;
+                for (int i = 0; i < 8; i++) bits |= (uint8_t)(p[i] << (7 - i));
+                out[cells * 8 + row] = bits;
+            }
+    free(on);
+    *size = cells * 8;
+    return 0;
+}
+
+
+/*============================== Paquet ==============================*/
+
+static int convert(const char *spec, bool dither, asset_t *asset)
+{
+    char buf[512];
+    snprintf(buf, sizeof(buf), "%s", spec);
+    char *path = strchr(buf, '=');
+    if (path == NULL || path == buf || path - buf >= LLMP_ASSET_NAME) {
+        fprintf(stderr, "Asset : \"%s\" n'est pas de la forme <nom>=<image.ppm>[:mode] (nom de 15 caractères au plus)\n", spec);
+        return -1;
+    }
+    *path++ = '\0';
+    char *mode = strrchr(path, ':');
+    if (mode != NULL) *mode++ = '\0';
+
+    image_t img;
+    if (ppm_read(path, &img) != 0) return -1;
+
+    memset(asset, 0, sizeof(*asset));
+    llmp16_asset_entry_t *e = &asset->entry;
+    memcpy(e->name, buf, strlen(buf));        /* < LLMP_ASSET_NAME, vérifié plus haut */
+    e->width = (uint16_t)img.w;
+    e->height = (uint16_t)img.h;
+    asset->data = (uint8_t *)malloc(img.n + 256);
+    if (asset->data == NULL) {
+        perror("Asset alloc error");
+        free(img.r);
+        return -1;
+    }
+
+    double start = now_seconds();
+    int ret = 0;
+    if (mode == NULL || strcmp(mode, "rgb") == 0) {
+        e->kind = LLMP_ASSET_IMAGE;
+        ret = quantize_rgb332(&img, dither, asset->data);
+        e->size = img.w * img.h;
+    } else if (strncmp(mode, "pal", 3) == 0 && atoi(mode + 3) >= 2 && atoi(mode + 3) <= 256) {
+        e->kind = LLMP_ASSET_IMAGE;
+        int colors = quantize_palette(&img, atoi(mode + 3), asset->data, asset->data + img.w * img.h);
+        ret = colors < 0 ? -1 : 0;
+        e->colors = (uint16_t)(colors < 0 ? 0 : colors);
+        e->size = img.w * img.h + e->colors;
+    } else if (strcmp(mode, "glyphs") == 0) {
+        e->kind = LLMP_ASSET_GLYPHS;
+        ret = quantize_glyphs(&img, asset->data, &e->size);
+    } else {
+        fprintf(stderr, "Asset : mode \"%s\" inconnu (rgb, pal<N>, glyphs)\n", mode);
+        ret = -1;
+    }
+    double elapsed = now_seconds() - start;
+    free(img.r);
+    if (ret == 0 && (img.w > 0xFFFF || img.h > 0xFFFF)) {
+        fprintf(stderr, "Asset : %s est trop grande\n", path);
+        ret = -1;
+    }
+    if (ret != 0) {
+        free(asset->data);
+        return -1;
+    }
+
+    printf("{\"asset\":\"%s\",\"kind\":\"%s\",\"width\":%u,\"height\":%u,\"colors\":%u,\"size\":%u,"
+           "\"seconds\":%.6f,\"mpixels_per_s\":%.1f}\n",
+           e->name, e->kind == LLMP_ASSET_GLYPHS ? "glyphs" : "image", e->width, e->height, e->colors, e->size,
+           elapsed, elapsed > 0.0 ? img.w * img.h / elapsed / 1e6 : 0.0);
+    return 0;
+}
+
+/* Paquet en mémoire : en-tête, répertoire puis données */
+static uint8_t *build_pack(asset_t *assets, int count, uint32_t *size)
+{
+    uint32_t offset = sizeof(llmp16_asset_header_t) + count * sizeof(llmp16_asset_entry_t);
+    for (int i = 0; i < count; i++) {
+        assets[i].entry.offset = offset;
+        offset += assets[i].entry.size;
+    }
+    uint8_t *pack = (uint8_t *)calloc(1, offset);
+    if (pack == NULL) {
+        perror("Pack alloc error");
+        return NULL;
+    }
+
+    llmp16_asset_header_t header = { { 0 }, (uint16_t)count, 0, offset };
+    memcpy(header.magic, LLMP_ASSET_MAGIC, sizeof(header.magic));
+    memcpy(pack, &header, sizeof(header));
+    for (int i = 0; i < count; i++) {
+        memcpy(pack + sizeof(header) + i * sizeof(llmp16_asset_entry_t), &assets[i].entry, sizeof(llmp16_asset_entry_t));
+        memcpy(pack + assets[i].entry.offset, assets[i].data, assets[i].entry.size);
+    }
+    *size = offset;
+    return pack;
+}
+
+/* Place le paquet dans l'image ROM <path> à <base>, en l'agrandissant si besoin */
+static int write_rom(const char *path, uint32_t base, const uint8_t *pack, uint32_t size)
+{
+    if (base + size > LLMP_ROM_SIZE) {
+        fprintf(stderr, "Asset : le paquet (%u octets) ne tient pas dans la ROM en 0x%04X\n", size, base);
+        return -1;
+    }
+    uint8_t rom[LLMP_ROM_SIZE] = { 0 };
+    size_t used = 0;
+    FILE *f = fopen(path, "rb");
+    if (f != NULL) {
+        used = fread(rom, 1, sizeof(rom), f);
+        fclose(f);
+    }
+    if (used > base) fprintf(stderr, "Asset : le paquet recouvre la fin de %s (0x%04zX octets)\n", path, used);
+    memcpy(rom + base, pack, size);
+    if (used < base + size) used = base + size;
+
+    f = fopen(path, "wb");
+    if (f == NULL || fwrite(rom, 1, used, f) != used) {
+        perror("ROM write error");
+        if (f != NULL) fclose(f);
+        return -1;
+    }
+    fclose(f);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *out = NULL, *rom = NULL;
+    uint32_t base = ROM_BASE;
+    bool dither = false;
+    static asset_t assets[MAX_ASSETS];
+    int count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) out = argv[++i];
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) rom = argv[++i];
+        else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) base = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-d") == 0) dither = true;
+        else if (argv[i][0] != '-' && count < MAX_ASSETS) {
+            if (convert(argv[i], dither, &assets[count]) != 0) return EXIT_FAILURE;
+            count++;
+        } else {
+            out = rom = NULL;
+            break;
+        }
+    }
+    if (count == 0 || (out == NULL && rom == NULL)) {
+        fprintf(stderr, "Usage : %s [-o paquet.bin] [-r rom.bin [-b <adresse>]] [-d] <nom>=<image.ppm>[:rgb|:pal<N>|:glyphs] ...\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    uint32_t size;
+    uint8_t *pack = build_pack(assets, count, &size);
+    int ret = pack == NULL ? EXIT_FAILURE : EXIT_SUCCESS;
+    if (pack != NULL && out != NULL) {
+        FILE *f = fopen(out, "wb");
+        if (f == NULL || fwrite(pack, 1, size, f) != size) {
+            perror("Pack write error");
+            ret = EXIT_FAILURE;
+        }
+        if (f != NULL) fclose(f);
+    }
+    if (pack != NULL && rom != NULL && write_rom(rom, base, pack, size) != 0) ret = EXIT_FAILURE;
+
+    for (int i = 0; i < count; i++) {
+        const llmp16_asset_entry_t *e = &assets[i].entry;
+        fprintf(stderr, "  %-15s offset 0x%05X, %u octets\n", e->name, e->offset, e->size);
+        free(assets[i].data);
+    }
+    free(pack);
+    return ret;
+}
@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "llmp16.h"
+#include "llmp16_capture.h"
+
+/*
+ * Décodeur des captures brutes produites par main -C sortie.cap
+ * Usage : llmp16_capdump sortie.cap [-o images/f_%05u.ppm]
+ * Une ligne JSON par image : numéro, cycle, taille compressée et empreinte FNV-1a des pixels,
+ * à comparer d'une exécution à l'autre pour les tests de non-régression graphique. Avec -o,
+ * chaque image est aussi écrite en PPM.
+ */
+
+static uint32_t fnv1a(const uint8_t *p, size_t n)
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; i++) h = (h ^ p[i]) * 16777619u;
+    return h;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path = NULL, *pattern = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) pattern = argv[++i];
+        else if (path == NULL) path = argv[i];
+        else path = NULL, i = argc;
+    }
+    if (path == NULL) {
+        fprintf(stderr, "Usage : %s sortie.cap [-o images/f_%%05u.ppm]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        perror("Capture open error");
+        return EXIT_FAILURE;
+    }
+    llmp16_capture_header_t header;
+    if (fread(&header, sizeof(header), 1, f) != 1 || memcmp(header.magic, LLMP_CAPTURE_MAGIC, sizeof(header.magic)) != 0
+        || header.width != LLMP_SCREEN_WIDTH || header.height != LLMP_SCREEN_HEIGHT) {
+        fprintf(stderr, "Capture : %s n'est pas une capture LLMP16\n", path);
+        fclose(f);
+        return EXIT_FAILURE;
+    }
+
+    const size_t size = (size_t)LLMP_SCREEN_WIDTH * LLMP_SCREEN_HEIGHT;
+    uint8_t *image = (uint8_t *)calloc(1, size), *tokens = (uint8_t *)malloc(2 * size + 16);
+    llmp16_capture_rec_t rec;
+    uint64_t frames = 0, packed = 0;
+    int ret = EXIT_SUCCESS;
+
+    while (fread(&rec, sizeof(rec), 1, f) == 1) {
+        if (rec.size > 2 * size + 16 || fread(tokens, 1, rec.size, f) != rec.size
+            || llmp16_capture_decode(tokens, rec.size, image) != 0) {
+            fprintf(stderr, "Capture : image %llu corrompue\n", (unsigned long long)frames);
+            ret = EXIT_FAILURE;
+            break;
+        }
+        printf("{\"frame\":%llu,\"cycles\":%llu,\"size\":%u,\"hash\":\"%08x\"}\n",
+               (unsigned long long)frames, (unsigned long long)rec.cycles, rec.size, fnv1a(image, size));
+        if (pattern != NULL) {
+            char name[512];
+            snprintf(name, sizeof(name), pattern, (unsigned)frames);
+            FILE *out = fopen(name, "wb");
+            if (out == NULL || llmp16_capture_write_ppm(out, image) != 0) perror("PPM write error");
+            if (out != NULL) fclose(out);
+        }
+        frames++;
+        packed += sizeof(rec) + rec.size;
+    }
+
+    fprintf(stderr, "Capture : %llu image(s), %llu octets (%.1f%% des images brutes)\n",
+            (unsigned long long)frames, (unsigned long long)packed,
+            frames ? 100.0 * packed / (frames * size) : 0.0);
+    free(image);
+    free(tokens);
+    fclose(f);
+    return ret;
+}
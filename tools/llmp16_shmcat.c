@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "llmp16.h"
+#include "llmp16_shm.h"
+#include "llmp16_capture.h"
+
+/*
+ * Lecteur de l'anneau d'images publié par main -S <nom>
+ * Usage : llmp16_shmcat <nom> [-n <images>] [-d <ms>] [-o image.ppm]
+ *   -n  s'arrête après <images> images (défaut : à la fermeture de l'anneau)
+ *   -d  attend <ms> ms après chaque image, pour simuler un lecteur lent
+ *   -o  écrit la dernière image valide en PPM
+ * Une ligne JSON par image lue sur place : numéro, cycles, empreinte, images sautées et
+ * "torn" si l'émulateur a réécrit le slot pendant la lecture.
+ */
+
+#define SHM_WAIT_MS 1000
+
+static uint32_t fnv1a(const uint8_t *p, size_t n)
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; i++) h = (h ^ p[i]) * 16777619u;
+    return h;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *name = NULL, *out = NULL;
+    uint64_t max_images = 0;
+    long delay_ms = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) max_images = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) delay_ms = strtol(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) out = argv[++i];
+        else if (argv[i][0] != '-' && name == NULL) name = argv[i];
+        else name = NULL, i = argc;
+    }
+    if (name == NULL) {
+        fprintf(stderr, "Usage : %s <nom> [-n <images>] [-d <ms>] [-o image.ppm]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    char path[64];
+    snprintf(path, sizeof(path), "%s%s", name[0] == '/' ? "" : "/", name);
+    llmp16_shm_t shm;
+    if (llmp16_shm_open(&shm, path) != 0) return EXIT_FAILURE;
+
+    const llmp16_shm_header_t *h = shm.header;
+    uint8_t *last = (uint8_t *)malloc((size_t)h->width * h->height);
+    bool have_last = false;
+    uint64_t seq = 0, images = 0, skipped = 0, torn = 0;
+
+    while (max_images == 0 || images < max_images) {
+        uint64_t next = llmp16_shm_wait(&shm, seq, SHM_WAIT_MS);
+        if (next == seq) {
+            if (atomic_load(&h->closed)) break;
+            continue;
+        }
+        if (seq != 0 && next > seq + 1) skipped += next - seq - 1;
+        seq = next;
+
+        const llmp16_shm_slot_t *slot;
+        const uint8_t *image = llmp16_shm_image(&shm, seq, &slot);
+        if (image == NULL) {
+            torn++;
+            continue;
+        }
+        uint64_t cycles = slot->cycles;
+        uint32_t hash = fnv1a(image, (size_t)h->width * h->height);
+        if (delay_ms > 0) {
+            struct timespec ts = { delay_ms / 1000, (delay_ms % 1000) * 1000000 };
+            nanosleep(&ts, NULL);
+        }
+        if (last != NULL) memcpy(last, image, (size_t)h->width * h->height);
+        bool ok = llmp16_shm_valid(&shm, seq);
+        if (ok) have_last = last != NULL;
+        else torn++;
+        images++;
+        printf("{\"seq\":%llu,\"cycles\":%llu,\"hash\":\"%08x\",\"skipped\":%llu,\"torn\":%s}\n",
+               (unsigned long long)seq, (unsigned long long)cycles, hash, (unsigned long long)skipped,
+               ok ? "false" : "true");
+        fflush(stdout);
+    }
+
+    fprintf(stderr, "Shm : %llu image(s) lue(s), %llu sautée(s), %llu réécrite(s) pendant la lecture\n",
+            (unsigned long long)images, (unsigned long long)skipped, (unsigned long long)torn);
+    if (out != NULL && have_last) {
+        FILE *f = fopen(out, "wb");
+        if (f == NULL || llmp16_capture_write_ppm(f, last) != 0) perror("PPM write error");
+        if (f != NULL) fclose(f);
+    }
+    free(last);
+    llmp16_shm_close(&shm);
+    return EXIT_SUCCESS;
+}
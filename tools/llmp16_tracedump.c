@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "llmp16.h"
+#include "llmp16_trace.h"
+
+/*
+ * Décodeur hors-ligne des traces binaires produites par llmp16_trace.c
+ * Usage : llmp16_tracedump trace.bin
+ */
+
+static const char *reasons[] = { "?", "HALT", "opcode invalide", "watchpoint" };
+
+static void print_reg(const llmp16_trace_rec_t *rec)
+{
+    if (rec->a == LLMP_TRACE_FLAGS_REG)
+        printf("            FLAGS <- %c%c%c%c\n",
+               rec->value & FLAG_N ? 'N' : '-', rec->value & FLAG_Z ? 'Z' : '-',
+               rec->value & FLAG_C ? 'C' : '-', rec->value & FLAG_V ? 'V' : '-');
+    else if (rec->a < 8)
+        printf("            %s <- 0x%04X\n", llmp16_reg_name(rec->a), rec->value);
+    else
+        printf("            %s <- 0x%08X\n", llmp16_reg_name(rec->a), rec->value);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        fprintf(stderr, "Usage : %s trace.bin\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *f = fopen(argv[1], "rb");
+    if (f == NULL) {
+        perror("Trace open error");
+        return EXIT_FAILURE;
+    }
+
+    llmp16_trace_header_t header;
+    if (fread(&header, sizeof(header), 1, f) != 1
+        || memcmp(header.magic, LLMP_TRACE_MAGIC, sizeof(header.magic)) != 0
+        || header.rec_size != sizeof(llmp16_trace_rec_t)) {
+        fprintf(stderr, "%s : ce n'est pas une trace LLMP16\n", argv[1]);
+        fclose(f);
+        return EXIT_FAILURE;
+    }
+
+    llmp16_trace_rec_t rec;
+    char text[64];
+    while (fread(&rec, sizeof(rec), 1, f) == 1) {
+        switch (rec.type) {
+        case TRACE_INSN: {
+            instr_t in = llmp16_decode_raw(rec.b, (uint16_t)rec.value);
+            llmp16_disasm(&in, text, sizeof(text));
+            if (llmp16_instr_words(rec.b) == 2)
+                printf("%10u  0x%05X  %04X %04X  %s\n", rec.ext, rec.addr, rec.b, rec.value & 0xFFFF, text);
+            else
+                printf("%10u  0x%05X  %04X       %s\n", rec.ext, rec.addr, rec.b, text);
+            break;
+        }
+        case TRACE_REG:
+            print_reg(&rec);
+            break;
+        case TRACE_MEM:
+            printf("            [0x%05X] <- 0x%04X\n", rec.addr, rec.value);
+            break;
+        case TRACE_VRAM:
+            printf("            VRAM[0x%04X] <- 0x%02X\n", rec.addr, rec.value);
+            break;
+        case TRACE_IO_IN:
+            printf("            IN  $%X.%u -> 0x%04X\n", rec.a >> 4, rec.a & 0x0F, rec.value);
+            break;
+        case TRACE_IO_OUT:
+            printf("            OUT $%X.%u <- 0x%04X\n", rec.a >> 4, rec.a & 0x0F, rec.value);
+            break;
+        case TRACE_TRIGGER:
+            printf("=== déclenchement : %s à 0x%05X (instruction %u) ===\n",
+                   reasons[rec.a < 4 ? rec.a : 0], rec.addr, rec.ext);
+            break;
+        case TRACE_BLOCK:
+            if (rec.a == 0x0)
+                printf("            [0x%05X..0x%05X] <- copie de %u octet(s)\n", rec.addr, rec.addr + rec.value - 1, rec.value);
+            else
+                printf("            %s[0x%05X..0x%05X] <- 0x%02X x %u\n", rec.a == 0x2 ? "VRAM" : "",
+                       rec.addr, rec.addr + rec.value - 1, rec.b, rec.value);
+            break;
+        default:
+            printf("            enregistrement inconnu (type %u)\n", rec.type);
+            break;
+        }
+    }
+
+    fclose(f);
+    return EXIT_SUCCESS;
+}